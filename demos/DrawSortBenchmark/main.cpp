@@ -0,0 +1,199 @@
+#include <konide/drawsort.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double SecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static uint32_t Seed = 12345;
+
+static uint32_t NextRandom()
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	return Seed >> 8;
+}
+
+static uint64_t NextRandom64()
+{
+	return (uint64_t)NextRandom() << 40 ^ (uint64_t)NextRandom() << 16 ^ NextRandom();
+}
+
+static void StableSortByKey(std::vector<KonideDrawSortItem>& items)
+{
+	std::stable_sort(items.begin(), items.end(), [](const KonideDrawSortItem& a, const KonideDrawSortItem& b) { return a.key < b.key; });
+}
+
+// Sorts items with the radix sorter and std::stable_sort, both must agree on keys and on the order of equal keys
+static bool MatchesStableSort(KonideRadixSorter& Sorter, const std::vector<KonideDrawSortItem>& items)
+{
+	std::vector<KonideDrawSortItem> radixItems = items;
+	Sorter.Sort(radixItems);
+
+	std::vector<KonideDrawSortItem> stdItems = items;
+	StableSortByKey(stdItems);
+
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		if (radixItems[i].key != stdItems[i].key || radixItems[i].index != stdItems[i].index)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Random keys with few distinct values, full 64-bit keys and keys only differing in some bytes, at sizes around the edge cases
+static bool CheckCorrectness()
+{
+	KonideRadixSorter sorter;
+	std::vector<KonideDrawSortItem> items;
+
+	const uint32_t counts[] = { 0, 1, 2, 3, 17, 255, 256, 257, 4096, 100003 };
+	const char* patternNames[4] = { "8 distinct keys", "full 64-bit keys", "high bytes only", "real draw keys" };
+
+	bool bPassed = true;
+	for (uint32_t pattern = 0; pattern < 4; pattern++)
+	{
+		for (uint32_t count : counts)
+		{
+			items.resize(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				switch (pattern)
+				{
+				case 0: items[i].key = (uint64_t)(NextRandom() % 8) << 56 | (NextRandom() % 2); break;
+				case 1: items[i].key = NextRandom64(); break;
+				case 2: items[i].key = NextRandom64() & 0xffff000000000000ull; break;
+				default: items[i].key = KonideMakeDrawKey(NextRandom() % 4, NextRandom() % 4, NextRandom() % 8, NextRandom() % 16, 0, (NextRandom() % 4) / 3.0f); break;
+				}
+				items[i].index = i;
+			}
+
+			if (!MatchesStableSort(sorter, items))
+			{
+				printf("radix sort differs from std::stable_sort: %s, %u keys\n", patternNames[pattern], count);
+				bPassed = false;
+			}
+		}
+	}
+
+	return bPassed;
+}
+
+// Counts how often the pipeline and the material change between neighbouring draws
+static void CountSwitches(const std::vector<KonideDrawSortItem>& items, uint32_t& pipelineSwitches, uint32_t& materialSwitches)
+{
+	pipelineSwitches = 0;
+	materialSwitches = 0;
+	for (size_t i = 1; i < items.size(); i++)
+	{
+		uint64_t key = items[i].key;
+		uint64_t prevKey = items[i - 1].key;
+		uint32_t pass = (uint32_t)(key >> (64 - KONIDE_DRAW_KEY_LAYER_BITS - KONIDE_DRAW_KEY_PASS_BITS)) & 0xf;
+		uint32_t prevPass = (uint32_t)(prevKey >> (64 - KONIDE_DRAW_KEY_LAYER_BITS - KONIDE_DRAW_KEY_PASS_BITS)) & 0xf;
+		uint32_t shift = pass == KONIDE_DRAW_PASS_TRANSPARENT ? 0 : KONIDE_DRAW_KEY_MESH_BITS + KONIDE_DRAW_KEY_DEPTH_BITS;
+		uint32_t prevShift = prevPass == KONIDE_DRAW_PASS_TRANSPARENT ? 0 : KONIDE_DRAW_KEY_MESH_BITS + KONIDE_DRAW_KEY_DEPTH_BITS;
+
+		// Pipeline and material sit next to each other in both layouts
+		uint64_t state = key >> shift & 0xfffffff;
+		uint64_t prevState = prevKey >> prevShift & 0xfffffff;
+		pipelineSwitches += (state >> KONIDE_DRAW_KEY_MATERIAL_BITS) != (prevState >> KONIDE_DRAW_KEY_MATERIAL_BITS) ? 1 : 0;
+		materialSwitches += state != prevState ? 1 : 0;
+	}
+}
+
+// Sorts random draw keys with the radix sorter and std::stable_sort, prints times and how many pipeline and material switches sorting saves
+static void RunDrawSortBenchmark(uint32_t maxKeys)
+{
+	KonideRadixSorter sorter;
+	std::vector<KonideDrawSortItem> keys;
+	std::vector<KonideDrawSortItem> radixKeys;
+	std::vector<KonideDrawSortItem> stdKeys;
+
+	const uint32_t keyCounts[] = { 100000, 250000, 500000, 1000000 };
+	for (uint32_t count : keyCounts)
+	{
+		if (count > maxKeys)
+		{
+			break;
+		}
+
+		// A quarter transparent, 64 pipelines, 1024 materials, 256 meshes
+		keys.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			float depth = (NextRandom() % 65536) / 65535.0f;
+			if (NextRandom() % 4 == 0)
+			{
+				keys[i].key = KonideMakeTransparentDrawKey(0, KONIDE_DRAW_PASS_TRANSPARENT, depth, NextRandom() % 64, NextRandom() % 1024);
+			}
+			else
+			{
+				keys[i].key = KonideMakeDrawKey(0, KONIDE_DRAW_PASS_OPAQUE, NextRandom() % 64, NextRandom() % 1024, NextRandom() % 256, depth);
+			}
+			keys[i].index = i;
+		}
+
+		uint32_t unsortedPipelines, unsortedMaterials;
+		CountSwitches(keys, unsortedPipelines, unsortedMaterials);
+
+		double radixTime = 0.0;
+		double stdTime = 0.0;
+		const int runs = 10;
+		for (int run = 0; run < runs; run++)
+		{
+			radixKeys = keys;
+			Clock::time_point radixStart = Clock::now();
+			sorter.Sort(radixKeys);
+			radixTime += SecondsSince(radixStart);
+
+			stdKeys = keys;
+			Clock::time_point stdStart = Clock::now();
+			StableSortByKey(stdKeys);
+			stdTime += SecondsSince(stdStart);
+		}
+
+		uint32_t sortedPipelines, sortedMaterials;
+		CountSwitches(radixKeys, sortedPipelines, sortedMaterials);
+
+		printf("%u draw keys: radix %.3f ms, std::stable_sort %.3f ms (%.2fx), pipeline switches %u -> %u, material switches %u -> %u\n",
+			count,
+			radixTime * 1000.0 / runs,
+			stdTime * 1000.0 / runs,
+			radixTime > 0.0 ? stdTime / radixTime : 0.0,
+			unsortedPipelines,
+			sortedPipelines,
+			unsortedMaterials,
+			sortedMaterials);
+	}
+
+	const KonideRadixSortStats& sortStats = sorter.GetStats();
+	printf("radix sort: %llu byte passes run, %llu skipped\n",
+		(unsigned long long)sortStats.passes,
+		(unsigned long long)sortStats.skippedPasses);
+}
+
+// DrawSortBenchmark [max keys]
+int main(int argc, char** argv)
+{
+	// Timings of a sort that gets the order wrong mean nothing
+	if (!CheckCorrectness())
+	{
+		return 1;
+	}
+	printf("radix sort matches std::stable_sort\n");
+
+	int maxKeys = argc > 1 ? atoi(argv[1]) : 0;
+	RunDrawSortBenchmark(maxKeys > 0 ? (uint32_t)maxKeys : 1000000);
+
+	return 0;
+}
@@ -3,9 +3,14 @@
 #include <SDL.h>
 #include <SDL_Vulkan.h>
 
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+
 #pragma comment(lib, "konide.lib")
 
-extern int demo_main();
+extern int demo_main(int argc, char** argv);
 extern VkBool32 DebugMessageCallback(
     VkDebugUtilsMessageSeverityFlagBitsEXT           messageSeverity,
     VkDebugUtilsMessageTypeFlagsEXT                  messageTypes,
@@ -24,7 +29,7 @@ int WinMain(
 	int       nShowCmd
 )
 {
-	return demo_main();
+	return demo_main(__argc, __argv);
 }
 
 VkBool32 DebugMessageCallback(
@@ -38,13 +43,144 @@ VkBool32 DebugMessageCallback(
 		return VK_FALSE;
 	}
 #else
-int main()
+int main(int argc, char** argv)
 {
-	return demo_main();
+	return demo_main(argc, argv);
 }
 #endif
 
-int demo_main()
+static int FindArgument(int argc, char** argv, const char* name)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], name) == 0)
+		{
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+static VkPresentModeKHR ParsePresentMode(const char* name)
+{
+	if (strcmp(name, "mailbox") == 0) return VK_PRESENT_MODE_MAILBOX_KHR;
+	if (strcmp(name, "immediate") == 0) return VK_PRESENT_MODE_IMMEDIATE_KHR;
+	if (strcmp(name, "fifo_relaxed") == 0) return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+	return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+// Logs latency percentiles of the frames measured since the last call
+static void LogLatencyPercentiles(KonideRenderer& Renderer)
+{
+	std::vector<double> latencies;
+	bool bPresentWait = true;
+	for (const KonideLatencySample& sample : Renderer.GetLatencySamples())
+	{
+		latencies.push_back(sample.latency * 1000.0);
+		bPresentWait = bPresentWait && sample.bPresentWait;
+	}
+	Renderer.ClearLatencySamples();
+
+	if (latencies.empty())
+	{
+		return;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+
+	SDL_Log("latency over %zu frames (%s): p50 %.2f ms, p95 %.2f ms, p99 %.2f ms",
+		latencies.size(),
+		bPresentWait ? "present wait" : "gpu completion estimate",
+		percentile(0.50),
+		percentile(0.95),
+		percentile(0.99));
+}
+
+static void LogRenderThreadStats(KonideRenderer& Renderer)
+{
+	KonideRenderThreadStats stats = Renderer.GetRenderThreadStats();
+	Renderer.ResetRenderThreadStats();
+
+	if (stats.packetsRendered == 0)
+	{
+		return;
+	}
+
+	if (stats.packetsSubmitted > 0)
+	{
+		SDL_Log("app thread: %llu packets (%llu blocked, %.3f ms waiting), handoff %.3f ms/packet",
+			(unsigned long long)stats.packetsSubmitted,
+			(unsigned long long)stats.packetsBlocked,
+			stats.appWaitTime * 1000.0,
+			stats.appHandoffTime * 1000.0 / stats.packetsSubmitted);
+	}
+	SDL_Log("render thread: %llu frames, idle %.3f ms, apply %.3f ms, flush %.3f ms, queued %.3f ms per frame",
+		(unsigned long long)stats.packetsRendered,
+		stats.renderIdleTime * 1000.0 / stats.packetsRendered,
+		stats.renderApplyTime * 1000.0 / stats.packetsRendered,
+		stats.renderFlushTime * 1000.0 / stats.packetsRendered,
+		stats.packetQueueTime * 1000.0 / stats.packetsRendered);
+}
+
+// Logs the count most expensive Vulkan entrypoints of the last frame
+static void LogVulkanCalls(KonideRenderer& Renderer, int count)
+{
+	std::vector<KonideVulkanCallStats> calls = Renderer.GetVulkanCallStats();
+	if (calls.empty())
+	{
+		SDL_Log("no vulkan call stats, konide is built without KONIDE_VULKAN_INSTRUMENTATION");
+		return;
+	}
+
+	std::sort(calls.begin(), calls.end(), [](const KonideVulkanCallStats& a, const KonideVulkanCallStats& b) { return a.seconds > b.seconds; });
+
+	uint64_t totalCalls = 0;
+	double totalTime = 0.0;
+	for (const KonideVulkanCallStats& call : calls)
+	{
+		totalCalls += call.calls;
+		totalTime += call.seconds;
+	}
+
+	SDL_Log("vulkan calls: %llu calls, %.3f ms in driver last frame", (unsigned long long)totalCalls, totalTime * 1000.0);
+	for (int i = 0; i < count && i < (int)calls.size(); i++)
+	{
+		SDL_Log("  %-40s %6llu calls %8.3f ms", calls[i].name, (unsigned long long)calls[i].calls, calls[i].seconds * 1000.0);
+	}
+}
+
+// Logs p50/p95/p99 of every FlushRender phase, optionally the total frame time histogram
+static void LogFrameStats(KonideRenderer& Renderer, bool bHistogram)
+{
+	KonideFrameStats& frameStats = Renderer.GetFrameStats();
+	if (frameStats.GetSampleCount() == 0)
+	{
+		return;
+	}
+
+	const double percentiles[3] = { 50.0, 95.0, 99.0 };
+	for (uint32_t phase = 0; phase < KONIDE_FRAME_PHASE_COUNT; phase++)
+	{
+		double results[3];
+		frameStats.GetPercentiles((EKonideFramePhase)phase, percentiles, results, 3);
+		SDL_Log("%s: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms",
+			KonideFramePhaseName((EKonideFramePhase)phase),
+			results[0] * 1000.0, results[1] * 1000.0, results[2] * 1000.0);
+	}
+
+	if (bHistogram)
+	{
+		// 0.5 ms buckets up to 50 ms
+		KonideFrameHistogram histogram = frameStats.GetHistogram(KONIDE_FRAME_PHASE_TOTAL, 0.0005, 100);
+		SDL_Log("total frame time histogram:\n%s", histogram.ToCSV().c_str());
+	}
+
+	frameStats.Reset();
+}
+
+int demo_main(int argc, char** argv)
 {
 	SDL_Window* window;
 	SDL_Surface* surface;
@@ -59,7 +195,7 @@ int demo_main()
 
 	int width = 1280, height = 720;
 
-	window = SDL_CreateWindow("Hello Triangle!", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_SHOWN | SDL_WINDOW_VULKAN);
+	window = SDL_CreateWindow("Hello Triangle!", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_SHOWN | SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE);
 
 	surface = SDL_GetWindowSurface(window);
 
@@ -81,6 +217,13 @@ int demo_main()
 		return 2;
 	}
 
+	// --capture <path>, started before Initialize so the trace holds device and resource creation
+	int captureArg = FindArgument(argc, argv, "--capture");
+	if (captureArg && captureArg + 1 < argc && !Renderer.StartVulkanCapture(argv[captureArg + 1]))
+	{
+		SDL_Log("can't capture to %s, konide needs KONIDE_VULKAN_CAPTURE and a writable path", argv[captureArg + 1]);
+	}
+
 	Renderer.Initialize(SDLExtensions);
 
 	Renderer.CreateDebugMessenger(DebugMessageCallback, nullptr);
@@ -97,24 +240,181 @@ int demo_main()
 	
 	Renderer.CreateDevice();
 
+	int presentModeArg = FindArgument(argc, argv, "--present-mode");
+	if (presentModeArg && presentModeArg + 1 < argc)
+	{
+		Renderer.SetPresentMode(ParsePresentMode(argv[presentModeArg + 1]));
+	}
+
+	int imageCountArg = FindArgument(argc, argv, "--image-count");
+	if (imageCountArg && imageCountArg + 1 < argc)
+	{
+		Renderer.SetSwapchainImageCount(atoi(argv[imageCountArg + 1]));
+	}
+
 	Renderer.CreateSwapchain(width, height);
 
+	// --acquire skip | --acquire <timeout ms>
+	int acquireArg = FindArgument(argc, argv, "--acquire");
+	if (acquireArg && acquireArg + 1 < argc)
+	{
+		if (strcmp(argv[acquireArg + 1], "skip") == 0)
+		{
+			Renderer.SetAcquirePolicy(KONIDE_ACQUIRE_SKIP_FRAME);
+		}
+		else
+		{
+			Renderer.SetAcquirePolicy(KONIDE_ACQUIRE_BOUNDED_WAIT, (uint64_t)atoi(argv[acquireArg + 1]) * 1000000ull);
+		}
+	}
+
 	Renderer.CreateLayer<KonideSceneLayer>();
 
+	// --extra-windows <n>: every extra window is a composition presented together with the main one
+	std::vector<SDL_Window*> extraWindows;
+	int extraWindowsArg = FindArgument(argc, argv, "--extra-windows");
+	if (extraWindowsArg && extraWindowsArg + 1 < argc)
+	{
+		int extraCount = atoi(argv[extraWindowsArg + 1]);
+		for (int i = 0; i < extraCount; i++)
+		{
+			SDL_Window* extraWindow = SDL_CreateWindow("Hello Triangle! (composition)", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width / 2, height / 2, SDL_WINDOW_SHOWN | SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE);
+
+			VkSurfaceKHR extraSurface;
+			if (SDL_Vulkan_CreateSurface(extraWindow, instance, &extraSurface) == SDL_FALSE)
+			{
+				return 3;
+			}
+
+			uint32_t compositionIdx = Renderer.CreateComposition(extraSurface, width / 2, height / 2);
+
+			KonideLayer* compositionLayer = new KonideSceneLayer();
+			Renderer.GetComposition(compositionIdx)->AddLayer(compositionLayer);
+
+			extraWindows.push_back(extraWindow);
+		}
+	}
+
 	// Konide example ends
 
+	// --record-threads <n>
+	int recordThreadsArg = FindArgument(argc, argv, "--record-threads");
+	if (recordThreadsArg && recordThreadsArg + 1 < argc)
+	{
+		Renderer.SetRecordingThreads(atoi(argv[recordThreadsArg + 1]));
+	}
+
+	int latencyArg = FindArgument(argc, argv, "--latency");
+	if (latencyArg)
+	{
+		int maxQueued = latencyArg + 1 < argc ? atoi(argv[latencyArg + 1]) : 0;
+		Renderer.SetLowLatencyMode(true, maxQueued > 0 ? maxQueued : 1);
+	}
+
+	int renderThreadArg = FindArgument(argc, argv, "--render-thread");
+	if (renderThreadArg)
+	{
+		Renderer.StartRenderThread();
+	}
+
+	// --frame-stats [histogram]
+	int frameStatsArg = FindArgument(argc, argv, "--frame-stats");
+	bool bFrameHistogram = frameStatsArg && frameStatsArg + 1 < argc && strcmp(argv[frameStatsArg + 1], "histogram") == 0;
+
+	// --vk-calls [count]
+	int vulkanCallsArg = FindArgument(argc, argv, "--vk-calls");
+	int vulkanCallCount = vulkanCallsArg && vulkanCallsArg + 1 < argc ? atoi(argv[vulkanCallsArg + 1]) : 0;
+	if (vulkanCallCount <= 0)
+	{
+		vulkanCallCount = 10;
+	}
+
+	// The graph belongs to the thread recording frames, it can't be read while a render thread runs
+	int dumpFrameGraphArg = FindArgument(argc, argv, "--dump-frame-graph");
+
+	uint64_t frameCounter = 0;
+
 	while (!bShouldQuit)
 	{
-		SDL_PollEvent(&event);
+		// Start the frame just in time, right before input is sampled
+		Renderer.WaitForFrameLatency();
 
-		if (event.type == SDL_QUIT)
+		while (SDL_PollEvent(&event))
 		{
-			bShouldQuit = true;
+			if (event.type == SDL_QUIT)
+			{
+				bShouldQuit = true;
+			}
+
+			if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE)
+			{
+				bShouldQuit = true;
+			}
+
+			if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+			{
+				bool bComposition = false;
+				for (size_t i = 0; i < extraWindows.size(); i++)
+				{
+					if (SDL_GetWindowID(extraWindows[i]) == event.window.windowID)
+					{
+						Renderer.ResizeComposition((uint32_t)i, event.window.data1, event.window.data2);
+						bComposition = true;
+					}
+				}
+
+				if (!bComposition)
+				{
+					Renderer.RecreateSwapchain(event.window.data1, event.window.data2);
+				}
+			}
 		}
 
-		Renderer.FlushRender();
+		// Without a render thread this records and presents right away
+		Renderer.SubmitFramePacket();
+
+		if (++frameCounter % 300 == 0)
+		{
+			if (latencyArg)
+			{
+				LogLatencyPercentiles(Renderer);
+			}
+
+			if (renderThreadArg)
+			{
+				LogRenderThreadStats(Renderer);
+			}
+
+			if (frameStatsArg)
+			{
+				LogFrameStats(Renderer, bFrameHistogram);
+			}
+
+			if (vulkanCallsArg)
+			{
+				LogVulkanCalls(Renderer, vulkanCallCount);
+			}
+
+			if (dumpFrameGraphArg && !renderThreadArg)
+			{
+				SDL_Log("%s", Renderer.GetFrameGraph().Dump().c_str());
+			}
+		}
 	}
 
+	Renderer.StopRenderThread();
+
+	if (captureArg)
+	{
+		KonideTraceStats captureStats = Renderer.GetVulkanCaptureStats();
+		SDL_Log("capture: %llu calls, %llu frames, %llu bytes", (unsigned long long)captureStats.calls,
+			(unsigned long long)captureStats.frames, (unsigned long long)captureStats.bytes);
+	}
+
+	for (SDL_Window* extraWindow : extraWindows)
+	{
+		SDL_DestroyWindow(extraWindow);
+	}
 	SDL_DestroyWindow(window);
 	SDL_Quit();
 
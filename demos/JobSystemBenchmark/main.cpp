@@ -0,0 +1,146 @@
+#include <konide/jobsystem.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double SecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Empty jobs scheduled from a thread outside the job system, all land in the shared queue
+static void BenchmarkExternalOverhead(KonideJobSystem& JobSystem, uint32_t jobCount)
+{
+	KonideJobCounter counter;
+
+	Clock::time_point start = Clock::now();
+	for (uint32_t i = 0; i < jobCount; i++)
+	{
+		JobSystem.Schedule([]() {}, &counter);
+	}
+	JobSystem.Wait(counter);
+	double elapsed = SecondsSince(start);
+
+	printf("  external schedule: %u jobs, %.1f ns/job\n", jobCount, elapsed * 1e9 / jobCount);
+}
+
+// Empty jobs scheduled from inside a job, they go to the worker's own deque and get stolen from there
+static void BenchmarkWorkerOverhead(KonideJobSystem& JobSystem, uint32_t jobCount)
+{
+	KonideJobCounter rootCounter;
+	KonideJobCounter childCounter;
+
+	Clock::time_point start = Clock::now();
+	JobSystem.Schedule([&JobSystem, &childCounter, jobCount]()
+	{
+		for (uint32_t i = 0; i < jobCount; i++)
+		{
+			JobSystem.Schedule([]() {}, &childCounter);
+		}
+	}, &rootCounter);
+	JobSystem.Wait(rootCounter);
+	JobSystem.Wait(childCounter);
+	double elapsed = SecondsSince(start);
+
+	printf("  worker schedule: %u jobs, %.1f ns/job\n", jobCount, elapsed * 1e9 / jobCount);
+}
+
+// Chain of jobs where each one depends on the previous, measures dependency release latency
+static void BenchmarkDependencyChain(KonideJobSystem& JobSystem, uint32_t chainLength)
+{
+	std::vector<KonideJobCounter> counters(chainLength);
+
+	Clock::time_point start = Clock::now();
+	JobSystem.Schedule([]() {}, &counters[0]);
+	for (uint32_t i = 1; i < chainLength; i++)
+	{
+		JobSystem.Schedule([]() {}, &counters[i], &counters[i - 1]);
+	}
+	JobSystem.Wait(counters.back());
+	double elapsed = SecondsSince(start);
+
+	printf("  dependency chain: %u jobs, %.1f ns/link\n", chainLength, elapsed * 1e9 / chainLength);
+}
+
+// Fixed amount of arithmetic split with ParallelFor, returns the wall time
+static double RunParallelWorkload(KonideJobSystem& JobSystem, const std::vector<float>& input, std::vector<float>& output, uint32_t grainSize)
+{
+	Clock::time_point start = Clock::now();
+	JobSystem.ParallelFor((uint32_t)input.size(), grainSize, [&input, &output](uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			float value = input[i];
+			for (int k = 0; k < 32; k++)
+			{
+				value = std::sqrt(value * value + 1.0f) * 0.5f;
+			}
+			output[i] = value;
+		}
+	});
+	return SecondsSince(start);
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	uint32_t jobCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 0;
+	if (jobCount == 0)
+	{
+		jobCount = 100000;
+	}
+
+	std::vector<float> input(1 << 22);
+	std::vector<float> output(input.size());
+	for (size_t i = 0; i < input.size(); i++)
+	{
+		input[i] = (float)(i % 1024);
+	}
+
+	double baseline = 0.0;
+
+	// Worker count 0 runs everything on the calling thread, N workers plus the caller use N + 1 threads
+	for (uint32_t workerCount = 0; workerCount < hardwareThreads; workerCount++)
+	{
+		KonideJobSystem JobSystem;
+		if (workerCount > 0)
+		{
+			JobSystem.Start(workerCount);
+		}
+
+		printf("%u threads:\n", workerCount + 1);
+
+		BenchmarkExternalOverhead(JobSystem, jobCount);
+		BenchmarkWorkerOverhead(JobSystem, jobCount);
+		BenchmarkDependencyChain(JobSystem, std::min(jobCount, 10000u));
+
+		// Warm up, then keep the best of a few runs
+		RunParallelWorkload(JobSystem, input, output, 4096);
+		double best = 1e30;
+		for (int run = 0; run < 5; run++)
+		{
+			best = std::min(best, RunParallelWorkload(JobSystem, input, output, 4096));
+		}
+
+		if (workerCount == 0)
+		{
+			baseline = best;
+		}
+
+		KonideJobSystemStats stats = JobSystem.GetStats();
+		printf("  parallel for: %.3f ms, %.2fx speedup, %llu jobs executed, %llu stolen\n",
+			best * 1000.0,
+			baseline / best,
+			(unsigned long long)stats.jobsExecuted,
+			(unsigned long long)stats.jobsStolen);
+	}
+
+	return 0;
+}
@@ -0,0 +1,498 @@
+#define SDL_MAIN_HANDLED
+
+#include <konide.h>
+#include <konide/generic/KonideSceneLayer.h>
+#include <SDL.h>
+#include <SDL_Vulkan.h>
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Run with VK_ICD_FILENAMES pointing at a software ICD (e.g. lavapipe) to compare CPU/GPU overlap.
+
+// Every benchmark presents to this window through a renderer of its own
+struct BenchmarkWindow
+{
+	SDL_Window* window = nullptr;
+	std::vector<const char*> extensions;
+	int width = 1280;
+	int height = 720;
+};
+
+static int FindArgument(int argc, char** argv, const char* name)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], name) == 0)
+		{
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+// Fresh renderer with a swapchain for Window, nothing a previous benchmark set up carries over
+static std::unique_ptr<KonideRenderer> CreateBenchmarkRenderer(const BenchmarkWindow& Window)
+{
+	std::unique_ptr<KonideRenderer> renderer = std::make_unique<KonideRenderer>(KONIDE_RENDER_FEATURE_SWAPCHAIN);
+	renderer->Initialize(Window.extensions);
+
+	VkSurfaceKHR surface;
+	if (SDL_Vulkan_CreateSurface(Window.window, renderer->GetInstance(), &surface) == SDL_FALSE)
+	{
+		return nullptr;
+	}
+
+	renderer->SetSurface(surface);
+	renderer->CreateDevice();
+	renderer->CreateSwapchain(Window.width, Window.height);
+
+	return renderer;
+}
+
+static void RenderFrames(KonideRenderer& Renderer, int frameCount)
+{
+	SDL_Event event;
+
+	for (int i = 0; i < frameCount; i++)
+	{
+		while (SDL_PollEvent(&event)) {}
+		Renderer.FlushRender();
+	}
+}
+
+// Warm up so every frame slot has allocated what it needs before measuring
+static void WarmUp(KonideRenderer& Renderer)
+{
+	RenderFrames(Renderer, (int)Renderer.GetFramesInFlight() * 4);
+}
+
+// Renders a fixed number of frames for every frames-in-flight count and reports pacing
+static void RunFramesInFlightBenchmark(const BenchmarkWindow& Window, int frameCount)
+{
+	// Outlives the renderer drawing it
+	KonideSceneLayer sceneLayer;
+
+	std::unique_ptr<KonideRenderer> Renderer = CreateBenchmarkRenderer(Window);
+	if (!Renderer)
+	{
+		return;
+	}
+
+	Renderer->AddLayer(&sceneLayer);
+
+	for (uint32_t n = 1; n <= KONIDE_MAX_FRAMES_IN_FLIGHT; n++)
+	{
+		Renderer->SetFramesInFlight(n);
+
+		WarmUp(*Renderer);
+
+		Renderer->ResetPacingStats();
+		Renderer->ResetCommandStats();
+
+		RenderFrames(*Renderer, frameCount);
+
+		KonideFramePacingStats stats = Renderer->GetPacingStats();
+		if (stats.frameCount == 0)
+		{
+			SDL_Log("frames in flight %u: no frames rendered, %llu skipped", n, (unsigned long long)stats.skippedFrames);
+			continue;
+		}
+
+		SDL_Log("frames in flight %u: %.1f fps, cpu %.3f ms/frame, frame wait %.3f ms/frame, acquire wait %.3f ms/frame, overlap %.1f%%, %llu skipped",
+			n,
+			stats.GetFramesPerSecond(),
+			stats.cpuTime * 1000.0 / stats.frameCount,
+			stats.frameWaitTime * 1000.0 / stats.frameCount,
+			stats.acquireWaitTime * 1000.0 / stats.frameCount,
+			stats.GetOverlap() * 100.0,
+			(unsigned long long)stats.skippedFrames);
+
+		// Steady state must not touch the command buffer allocator
+		KonideCommandStats cmdStats = Renderer->GetCommandStats();
+		SDL_Log("frames in flight %u: %llu command buffer allocations, %llu command pool resets, %.2f queue submits/frame",
+			n,
+			(unsigned long long)cmdStats.commandBufferAllocations,
+			(unsigned long long)cmdStats.commandPoolResets,
+			(double)cmdStats.queueSubmits / stats.frameCount);
+		SDL_Log("frames in flight %u: %.2f barrier batches/frame, %.2f barriers/frame, %.2f layout transitions/frame",
+			n,
+			(double)cmdStats.barrierBatches / stats.frameCount,
+			(double)(cmdStats.imageBarriers + cmdStats.bufferBarriers) / stats.frameCount,
+			(double)cmdStats.layoutTransitions / stats.frameCount);
+	}
+}
+
+// Draws per benchmark layer unless a benchmark asks for something else
+#define BENCHMARK_DRAW_COUNT 2000
+
+// Benchmarks own their layers, declared ahead of the renderer so they outlive it
+typedef std::vector<std::unique_ptr<KonideLayer>> BenchmarkLayers;
+
+template<class LayerType>
+static LayerType* AddBenchmarkLayer(KonideRenderer& Renderer, BenchmarkLayers& Layers, LayerType* layer)
+{
+	Layers.emplace_back(layer);
+	Renderer.AddLayer(layer);
+	return layer;
+}
+
+// Stand-in for a layer with real content: derives per draw state on the CPU and records it
+class BenchmarkLayer : public KonideLayer
+{
+	uint32_t drawCount;
+public:
+	BenchmarkLayer(uint32_t newDrawCount = BENCHMARK_DRAW_COUNT) : drawCount(newDrawCount) {}
+
+	virtual void Render(VkCommandBuffer cmd, VkDevice device) override
+	{
+		for (uint32_t i = 0; i < drawCount; i++)
+		{
+			VkViewport viewport = {};
+			viewport.x = (float)(i % 64);
+			viewport.y = (float)(i / 64 % 64);
+			viewport.width = 64.0f;
+			viewport.height = 64.0f;
+			viewport.maxDepth = 1.0f;
+			DeviceTable->vkCmdSetViewport(cmd, 0, 1, &viewport);
+
+			VkRect2D scissor = {};
+			scissor.offset.x = (int32_t)viewport.x;
+			scissor.offset.y = (int32_t)viewport.y;
+			scissor.extent.width = 64;
+			scissor.extent.height = 64;
+			DeviceTable->vkCmdSetScissor(cmd, 0, 1, &scissor);
+		}
+	}
+};
+
+// Same content as BenchmarkLayer, encoded into its command list instead of recorded directly
+class EncodedBenchmarkLayer : public KonideLayer
+{
+	uint32_t drawCount;
+public:
+	EncodedBenchmarkLayer(uint32_t newDrawCount = BENCHMARK_DRAW_COUNT) : drawCount(newDrawCount) {}
+
+	virtual void Encode(KonideCommandList& commandList) override
+	{
+		for (uint32_t i = 0; i < drawCount; i++)
+		{
+			VkViewport viewport = {};
+			viewport.x = (float)(i % 64);
+			viewport.y = (float)(i / 64 % 64);
+			viewport.width = 64.0f;
+			viewport.height = 64.0f;
+			viewport.maxDepth = 1.0f;
+			commandList.SetViewport(viewport);
+
+			VkRect2D scissor = {};
+			scissor.offset.x = (int32_t)viewport.x;
+			scissor.offset.y = (int32_t)viewport.y;
+			scissor.extent.width = 64;
+			scissor.extent.height = 64;
+			commandList.SetScissor(scissor);
+		}
+	}
+};
+
+// Records layerCount benchmark layers inline, then in parallel on 1..N threads, and logs record times
+static void RunParallelRecordBenchmark(const BenchmarkWindow& Window, int layerCount, int frameCount)
+{
+	BenchmarkLayers Layers;
+	std::unique_ptr<KonideRenderer> Renderer = CreateBenchmarkRenderer(Window);
+	if (!Renderer)
+	{
+		return;
+	}
+
+	for (int i = 0; i < layerCount; i++)
+	{
+		AddBenchmarkLayer(*Renderer, Layers, new BenchmarkLayer());
+	}
+
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	double singleThreadRecord = 0.0;
+
+	for (uint32_t threads = 0; threads <= maxThreads; threads++)
+	{
+		Renderer->SetRecordingThreads(threads);
+
+		WarmUp(*Renderer);
+
+		Renderer->GetFrameStats().Reset();
+		Renderer->ResetCommandStats();
+
+		RenderFrames(*Renderer, frameCount);
+
+		KonideFrameStats& frameStats = Renderer->GetFrameStats();
+		double record = frameStats.GetPercentile(KONIDE_FRAME_PHASE_RECORD, 50.0);
+		if (threads == 1)
+		{
+			singleThreadRecord = record;
+		}
+
+		SDL_Log("%d layers, %u recording threads%s: record p50 %.3f ms, p95 %.3f ms, %.2fx vs 1 thread, %llu allocations",
+			layerCount,
+			threads,
+			threads == 0 ? " (inline)" : "",
+			record * 1000.0,
+			frameStats.GetPercentile(KONIDE_FRAME_PHASE_RECORD, 95.0) * 1000.0,
+			singleThreadRecord > 0.0 ? singleThreadRecord / record : 1.0,
+			(unsigned long long)Renderer->GetCommandStats().commandBufferAllocations);
+	}
+}
+
+// Records layerCount benchmark layers every frame, then as cacheable layers that only replay, and logs record times
+static void RunLayerCacheBenchmark(const BenchmarkWindow& Window, int layerCount, int frameCount)
+{
+	BenchmarkLayers Layers;
+	std::unique_ptr<KonideRenderer> Renderer = CreateBenchmarkRenderer(Window);
+	if (!Renderer)
+	{
+		return;
+	}
+
+	for (int i = 0; i < layerCount; i++)
+	{
+		AddBenchmarkLayer(*Renderer, Layers, new BenchmarkLayer());
+	}
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		bool bCacheable = pass == 1;
+		for (std::unique_ptr<KonideLayer>& layer : Layers)
+		{
+			layer->SetCacheable(bCacheable);
+		}
+
+		WarmUp(*Renderer);
+
+		Renderer->GetFrameStats().Reset();
+		Renderer->ResetCommandStats();
+
+		RenderFrames(*Renderer, frameCount);
+
+		KonideCommandStats cmdStats = Renderer->GetCommandStats();
+		SDL_Log("%d %s layers: record p50 %.3f ms, p95 %.3f ms, %llu cache hits, %llu cache records",
+			layerCount,
+			bCacheable ? "cacheable" : "uncached",
+			Renderer->GetFrameStats().GetPercentile(KONIDE_FRAME_PHASE_RECORD, 50.0) * 1000.0,
+			Renderer->GetFrameStats().GetPercentile(KONIDE_FRAME_PHASE_RECORD, 95.0) * 1000.0,
+			(unsigned long long)cmdStats.layerCacheHits,
+			(unsigned long long)cmdStats.layerCacheRecords);
+	}
+}
+
+// Sets the same viewport and scissor ahead of every draw, the way naive per draw code does
+class RedundantStateLayer : public KonideLayer
+{
+	uint32_t drawCount;
+	bool bElide = true;
+public:
+	RedundantStateLayer(uint32_t newDrawCount = BENCHMARK_DRAW_COUNT) : drawCount(newDrawCount) {}
+
+	void SetElision(bool bNewElide) { bElide = bNewElide; }
+
+	virtual void Encode(KonideCommandList& commandList) override
+	{
+		VkViewport viewport = {};
+		viewport.width = 64.0f;
+		viewport.height = 64.0f;
+		viewport.maxDepth = 1.0f;
+
+		VkRect2D scissor = {};
+		scissor.extent.width = 64;
+		scissor.extent.height = 64;
+
+		for (uint32_t i = 0; i < drawCount; i++)
+		{
+			commandList.SetViewport(viewport);
+			commandList.SetScissor(scissor);
+		}
+	}
+
+	virtual void Render(VkCommandBuffer cmd, VkDevice device) override
+	{
+		recorder.SetElision(bElide);
+		KonideLayer::Render(cmd, device);
+	}
+};
+
+// Records layerCount layers with redundant state, passing every call on and then eliding, and logs record times
+static void RunStateCacheBenchmark(const BenchmarkWindow& Window, int layerCount, int frameCount)
+{
+	BenchmarkLayers Layers;
+	std::vector<RedundantStateLayer*> stateLayers;
+	std::unique_ptr<KonideRenderer> Renderer = CreateBenchmarkRenderer(Window);
+	if (!Renderer)
+	{
+		return;
+	}
+
+	for (int i = 0; i < layerCount; i++)
+	{
+		stateLayers.push_back(AddBenchmarkLayer(*Renderer, Layers, new RedundantStateLayer()));
+	}
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		bool bElide = pass == 1;
+		for (RedundantStateLayer* layer : stateLayers)
+		{
+			layer->SetElision(bElide);
+		}
+
+		WarmUp(*Renderer);
+
+		Renderer->GetFrameStats().Reset();
+		Renderer->ResetCommandStats();
+
+		RenderFrames(*Renderer, frameCount);
+
+		KonideCommandStats cmdStats = Renderer->GetCommandStats();
+		SDL_Log("%d layers, elision %s: record p50 %.3f ms, p95 %.3f ms, %.0f state calls/frame issued, %.0f elided",
+			layerCount,
+			bElide ? "on" : "off",
+			Renderer->GetFrameStats().GetPercentile(KONIDE_FRAME_PHASE_RECORD, 50.0) * 1000.0,
+			Renderer->GetFrameStats().GetPercentile(KONIDE_FRAME_PHASE_RECORD, 95.0) * 1000.0,
+			(double)cmdStats.issuedStateCalls / frameCount,
+			(double)cmdStats.elidedStateCalls / frameCount);
+	}
+}
+
+// Records layerCount layers directly, then through encoded command lists, and logs record times
+static void RunCommandListBenchmark(const BenchmarkWindow& Window, int layerCount, int frameCount)
+{
+	BenchmarkLayers DirectLayers;
+	BenchmarkLayers EncodedLayers;
+	std::unique_ptr<KonideRenderer> Renderer = CreateBenchmarkRenderer(Window);
+	if (!Renderer)
+	{
+		return;
+	}
+
+	for (int i = 0; i < layerCount; i++)
+	{
+		AddBenchmarkLayer(*Renderer, DirectLayers, new BenchmarkLayer());
+	}
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		bool bEncoded = pass == 1;
+		if (bEncoded)
+		{
+			// Swap the direct layers for encoded ones with the same content, only one kind is measured at a time
+			for (std::unique_ptr<KonideLayer>& layer : DirectLayers)
+			{
+				Renderer->RemoveLayer(layer.get());
+			}
+			for (int i = 0; i < layerCount; i++)
+			{
+				AddBenchmarkLayer(*Renderer, EncodedLayers, new EncodedBenchmarkLayer());
+			}
+		}
+
+		WarmUp(*Renderer);
+
+		Renderer->GetFrameStats().Reset();
+		Renderer->ResetCommandStats();
+		uint64_t arenaAllocations = Renderer->GetCommandArenaStats().blockAllocations;
+
+		RenderFrames(*Renderer, frameCount);
+
+		KonideCommandStats cmdStats = Renderer->GetCommandStats();
+		SDL_Log("%d %s layers: record p50 %.3f ms, p95 %.3f ms, %.0f commands/frame, %llu bytes/frame, %llu arena allocations",
+			layerCount,
+			bEncoded ? "encoded" : "direct",
+			Renderer->GetFrameStats().GetPercentile(KONIDE_FRAME_PHASE_RECORD, 50.0) * 1000.0,
+			Renderer->GetFrameStats().GetPercentile(KONIDE_FRAME_PHASE_RECORD, 95.0) * 1000.0,
+			(double)cmdStats.encodedCommands / frameCount,
+			(unsigned long long)cmdStats.lastFrameEncodedBytes,
+			(unsigned long long)(Renderer->GetCommandArenaStats().blockAllocations - arenaAllocations));
+	}
+}
+
+// Reads the optional [layers] [frames] following a benchmark's argument
+static void ParseLayerArguments(int argc, char** argv, int arg, int& layerCount, int& frameCount)
+{
+	layerCount = arg + 1 < argc ? atoi(argv[arg + 1]) : 0;
+	frameCount = arg + 2 < argc ? atoi(argv[arg + 2]) : 0;
+	layerCount = layerCount > 0 ? layerCount : 48;
+	frameCount = frameCount > 0 ? frameCount : 300;
+}
+
+// RendererBenchmarks [--frames-in-flight [frames]] [--parallel-record [layers] [frames]] [--layer-cache [layers] [frames]]
+//                    [--command-list [layers] [frames]] [--state-cache [layers] [frames]]
+// Runs every benchmark when none is picked.
+int main(int argc, char** argv)
+{
+	SDL_SetMainReady();
+	if (SDL_Init(SDL_INIT_VIDEO) < 0)
+	{
+		return 1;
+	}
+
+	BenchmarkWindow Window;
+	Window.window = SDL_CreateWindow("konide benchmarks", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, Window.width, Window.height, SDL_WINDOW_SHOWN | SDL_WINDOW_VULKAN);
+	if (!Window.window)
+	{
+		return 1;
+	}
+
+	unsigned int extensionCount = 0;
+	SDL_Vulkan_GetInstanceExtensions(Window.window, &extensionCount, nullptr);
+	Window.extensions.resize(extensionCount);
+	if (SDL_Vulkan_GetInstanceExtensions(Window.window, &extensionCount, Window.extensions.data()) == SDL_FALSE)
+	{
+		return 2;
+	}
+
+	int framesInFlightArg = FindArgument(argc, argv, "--frames-in-flight");
+	int parallelRecordArg = FindArgument(argc, argv, "--parallel-record");
+	int layerCacheArg = FindArgument(argc, argv, "--layer-cache");
+	int commandListArg = FindArgument(argc, argv, "--command-list");
+	int stateCacheArg = FindArgument(argc, argv, "--state-cache");
+	bool bRunAll = !framesInFlightArg && !parallelRecordArg && !layerCacheArg && !commandListArg && !stateCacheArg;
+
+	int layerCount, frameCount;
+
+	if (bRunAll || framesInFlightArg)
+	{
+		frameCount = framesInFlightArg && framesInFlightArg + 1 < argc ? atoi(argv[framesInFlightArg + 1]) : 0;
+		RunFramesInFlightBenchmark(Window, frameCount > 0 ? frameCount : 500);
+	}
+
+	if (bRunAll || parallelRecordArg)
+	{
+		ParseLayerArguments(argc, argv, parallelRecordArg ? parallelRecordArg : argc, layerCount, frameCount);
+		RunParallelRecordBenchmark(Window, layerCount, frameCount);
+	}
+
+	if (bRunAll || layerCacheArg)
+	{
+		ParseLayerArguments(argc, argv, layerCacheArg ? layerCacheArg : argc, layerCount, frameCount);
+		RunLayerCacheBenchmark(Window, layerCount, frameCount);
+	}
+
+	if (bRunAll || commandListArg)
+	{
+		ParseLayerArguments(argc, argv, commandListArg ? commandListArg : argc, layerCount, frameCount);
+		RunCommandListBenchmark(Window, layerCount, frameCount);
+	}
+
+	if (bRunAll || stateCacheArg)
+	{
+		ParseLayerArguments(argc, argv, stateCacheArg ? stateCacheArg : argc, layerCount, frameCount);
+		RunStateCacheBenchmark(Window, layerCount, frameCount);
+	}
+
+	SDL_DestroyWindow(Window.window);
+	SDL_Quit();
+
+	return 0;
+}
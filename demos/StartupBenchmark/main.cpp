@@ -0,0 +1,58 @@
+#include <konide/renderer.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+
+static double SecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Creates and destroys iterations headless renderers with and without entrypoint pruning and prints the loader time they took.
+// Without a surface nothing waits on a window system, so only instance and device creation are measured.
+static void RunStartupBenchmark(int iterations)
+{
+	const char* modeNames[2] = { "core + enabled extensions", "every entrypoint" };
+	for (int mode = 0; mode < 2; mode++)
+	{
+		uint32_t features = KONIDE_RENDER_FEATURE_SWAPCHAIN | (mode == 1 ? KONIDE_RENDER_FEATURE_LOAD_ALL_ENTRYPOINTS : 0);
+
+		KonideLoaderStats totals;
+		double startupTime = 0.0;
+		for (int i = 0; i < iterations; i++)
+		{
+			Clock::time_point start = Clock::now();
+
+			std::unique_ptr<KonideRenderer> renderer = std::make_unique<KonideRenderer>(features);
+			renderer->Initialize();
+			renderer->CreateDevice();
+
+			startupTime += SecondsSince(start);
+
+			const KonideLoaderStats& stats = renderer->GetLoaderStats();
+			totals.instanceLoadTime += stats.instanceLoadTime;
+			totals.deviceLoadTime += stats.deviceLoadTime;
+			totals.instanceLookups += stats.instanceLookups;
+			totals.deviceLookups += stats.deviceLookups;
+		}
+
+		printf("startup, %s: %.3f ms instance load (%u lookups), %.3f ms device load (%u lookups), %.3f ms total startup\n",
+			modeNames[mode],
+			totals.instanceLoadTime * 1000.0 / iterations, totals.instanceLookups / iterations,
+			totals.deviceLoadTime * 1000.0 / iterations, totals.deviceLookups / iterations,
+			startupTime * 1000.0 / iterations);
+	}
+}
+
+// StartupBenchmark [iterations]
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? atoi(argv[1]) : 0;
+	RunStartupBenchmark(iterations > 0 ? iterations : 20);
+
+	return 0;
+}
@@ -1,8 +1,6 @@
 #ifndef _KONIDE_H
 #define _KONIDE_H
 
-#include "konide/vulkan/vkloader_symbols.h"
-
 #include "./konide/renderer.h"
 #include "./konide/proxy.h"
 #include "./konide/layer.h"
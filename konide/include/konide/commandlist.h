@@ -0,0 +1,278 @@
+#ifndef _KONIDE_COMMAND_LIST_H
+#define _KONIDE_COMMAND_LIST_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include "commandrecorder.h"
+#include "drawsort.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Arena blocks are handed to command lists whole, lists bump allocate inside them
+#define KONIDE_ARENA_BLOCK_SIZE (64 * 1024)
+// Commands and their trailing data are kept at this alignment
+#define KONIDE_COMMAND_ALIGNMENT 8
+
+struct KonideFrameArenaStats {
+    // Blocks allocated from the heap, drops to 0 once the arena has seen the largest frame
+    uint64_t blockAllocations = 0;
+    // Bytes handed out during the current frame
+    size_t bytesUsed = 0;
+    size_t capacity = 0;
+};
+
+// Linear allocator for one frame's command lists. Blocks are handed out under a lock, any thread may
+// ask for one, and are all taken back at once by Reset. Memory is kept across frames, so steady state
+// never touches the heap.
+class KonideFrameArena
+{
+protected:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size = 0;
+    };
+
+    std::mutex mutex;
+    std::vector<Block> blocks;
+    // Blocks before this index are in use this frame
+    size_t usedBlocks = 0;
+    // Bumped by Reset, lists encoded before it are stale
+    uint64_t generation = 1;
+
+    KonideFrameArenaStats stats;
+public:
+    // Thread safe, returns a block of at least minSize bytes and its actual size
+    uint8_t* AllocateBlock(size_t minSize, size_t& size);
+
+    // Takes every block back, no list encoded into the arena may be in use anymore
+    void Reset();
+
+    uint64_t GetGeneration() const { return generation; }
+    KonideFrameArenaStats GetStats();
+};
+
+enum EKonideCommandType
+{
+    KONIDE_COMMAND_BIND_PIPELINE = 0,
+    KONIDE_COMMAND_BIND_DESCRIPTOR_SETS = 1,
+    KONIDE_COMMAND_BIND_VERTEX_BUFFER = 2,
+    KONIDE_COMMAND_BIND_INDEX_BUFFER = 3,
+    KONIDE_COMMAND_PUSH_CONSTANTS = 4,
+    KONIDE_COMMAND_SET_VIEWPORT = 5,
+    KONIDE_COMMAND_SET_SCISSOR = 6,
+    KONIDE_COMMAND_DRAW = 7,
+    KONIDE_COMMAND_DRAW_INDEXED = 8,
+    KONIDE_COMMAND_DISPATCH = 9,
+    KONIDE_COMMAND_COPY_BUFFER = 10,
+    KONIDE_COMMAND_COPY_BUFFER_TO_IMAGE = 11,
+    KONIDE_COMMAND_BEGIN_DRAW = 12
+};
+
+// Starts every encoded command, size covers the command and its trailing data
+struct KonideCommandHeader {
+    uint32_t type;
+    uint32_t size;
+};
+
+// Starts a draw, every command up to the next one belongs to it and moves with it when sorted
+struct KonideCommandBeginDraw {
+    KonideCommandHeader header;
+    uint64_t sortKey;
+};
+
+struct KonideCommandBindPipeline {
+    KonideCommandHeader header;
+    VkPipelineBindPoint bindPoint;
+    VkPipeline pipeline;
+};
+
+// Followed by setCount VkDescriptorSets, then dynamicOffsetCount uint32_t offsets
+struct KonideCommandBindDescriptorSets {
+    KonideCommandHeader header;
+    VkPipelineBindPoint bindPoint;
+    VkPipelineLayout layout;
+    uint32_t firstSet;
+    uint32_t setCount;
+    uint32_t dynamicOffsetCount;
+};
+
+struct KonideCommandBindVertexBuffer {
+    KonideCommandHeader header;
+    uint32_t binding;
+    VkBuffer buffer;
+    VkDeviceSize offset;
+};
+
+struct KonideCommandBindIndexBuffer {
+    KonideCommandHeader header;
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    VkIndexType indexType;
+};
+
+// Followed by size bytes of constants
+struct KonideCommandPushConstants {
+    KonideCommandHeader header;
+    VkPipelineLayout layout;
+    VkShaderStageFlags stageFlags;
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct KonideCommandSetViewport {
+    KonideCommandHeader header;
+    VkViewport viewport;
+};
+
+struct KonideCommandSetScissor {
+    KonideCommandHeader header;
+    VkRect2D scissor;
+};
+
+struct KonideCommandDraw {
+    KonideCommandHeader header;
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+struct KonideCommandDrawIndexed {
+    KonideCommandHeader header;
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+};
+
+struct KonideCommandDispatch {
+    KonideCommandHeader header;
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
+};
+
+struct KonideCommandCopyBuffer {
+    KonideCommandHeader header;
+    VkBuffer srcBuffer;
+    VkBuffer dstBuffer;
+    VkBufferCopy region;
+};
+
+struct KonideCommandCopyBufferToImage {
+    KonideCommandHeader header;
+    VkBuffer srcBuffer;
+    VkImage dstImage;
+    VkImageLayout dstImageLayout;
+    VkBufferImageCopy region;
+};
+
+// Compact recording of draws, dispatches, binds and copies, independent of any command buffer.
+// A list is filled by one thread at a time, any thread, into memory from a frame arena and turned
+// into Vulkan commands later with Translate on whichever thread owns the command buffer. Commands
+// can be walked with ForEach before that, to sort or drop them. Handles are stored as is, the list
+// doesn't own anything it references.
+//
+// Commands encoded after BeginDraw form a draw that SortDraws orders by its key, so a list can be
+// filled in whatever order is convenient. Commands before the first BeginDraw always come first.
+class KonideCommandList
+{
+protected:
+    // Contiguous run of commands inside one arena block
+    struct Segment {
+        uint8_t* begin;
+        uint8_t* end;
+    };
+
+    struct DrawRange {
+        const KonideCommandHeader* begin;
+        uint32_t segment;
+        uint32_t commandCount;
+    };
+
+    KonideFrameArena* arena = nullptr;
+    uint64_t generation = 0;
+
+    std::vector<Segment> segments;
+    uint8_t* blockEnd = nullptr;
+    uint32_t commandCount = 0;
+    size_t bytes = 0;
+
+    std::vector<DrawRange> draws;
+    // Commands ahead of the first draw
+    uint32_t prologueCount = 0;
+    // Sort keys in encoding order, then in draw order once sorted, index points into draws
+    std::vector<KonideDrawSortItem> drawOrder;
+    bool bSorted = false;
+
+    uint8_t* Allocate(EKonideCommandType type, size_t size);
+    void TranslateRange(KonideCommandRecorder& recorder, const KonideCommandHeader* begin, uint32_t segment, uint32_t count) const;
+public:
+    // Drops previous contents and encodes into newArena from now on
+    void Begin(KonideFrameArena& newArena);
+    void Clear();
+
+    // True when encoded since the arena's last Reset, stale lists must not be translated
+    bool IsCurrent() const { return arena && arena->GetGeneration() == generation; }
+    bool IsEmpty() const { return commandCount == 0; }
+    uint32_t GetCommandCount() const { return commandCount; }
+    uint32_t GetDrawCount() const { return (uint32_t)draws.size(); }
+    size_t GetSize() const { return bytes; }
+
+    // Starts a new draw ordered by sortKey, see drawsort.h for building keys
+    void BeginDraw(uint64_t sortKey);
+    // Orders draws by key with sorter, draws with equal keys keep their encoding order
+    void SortDraws(KonideRadixSorter& sorter);
+    bool IsSorted() const { return bSorted; }
+
+    void BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline);
+    void BindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* sets,
+        uint32_t dynamicOffsetCount = 0, const uint32_t* dynamicOffsets = nullptr);
+    void BindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0);
+    void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+    void PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values);
+    void SetViewport(const VkViewport& viewport);
+    void SetScissor(const VkRect2D& scissor);
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0);
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0);
+
+    // Only valid outside of rendering, translate lists holding these from a frame graph pass
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+    void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& region);
+    void CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, const VkBufferImageCopy& region);
+
+    // Calls function(const KonideCommandHeader&) for every command in encoding order, BeginDraw included
+    template <class Function>
+    void ForEach(Function function) const;
+
+    // Records every command through recorder, draws in sorted order if sorted, so binds and state the
+    // command buffer already has are dropped. Returns how many commands it translated.
+    uint32_t Translate(KonideCommandRecorder& recorder) const;
+    // Same through a recorder that starts without any known state
+    uint32_t Translate(VkCommandBuffer commandBuffer, const KonideDeviceTable& deviceTable) const;
+    // Records a single command
+    static void TranslateCommand(KonideCommandRecorder& recorder, const KonideCommandHeader& command);
+};
+
+template <class Function>
+inline void KonideCommandList::ForEach(Function function) const
+{
+    for (const Segment& segment : segments) {
+        for (const uint8_t* cursor = segment.begin; cursor < segment.end; ) {
+            const KonideCommandHeader& command = *reinterpret_cast<const KonideCommandHeader*>(cursor);
+            function(command);
+            cursor += command.size;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef _KONIDE_COMMAND_RECORDER_H
+#define _KONIDE_COMMAND_RECORDER_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include "vulkan/vkloader_tables.h"
+
+#include <cstdint>
+
+#define KONIDE_RECORDER_MAX_DESCRIPTOR_SETS 8
+#define KONIDE_RECORDER_MAX_VERTEX_BINDINGS 16
+#define KONIDE_RECORDER_MAX_VIEWPORTS 4
+#define KONIDE_RECORDER_MAX_PUSH_CONSTANTS 256
+
+// Dynamic state a pipeline declares dynamic, everything else is reset by binding it
+enum EKonideRecorderDynamicState
+{
+    KONIDE_RECORDER_DYNAMIC_VIEWPORT = 1 << 0,
+    KONIDE_RECORDER_DYNAMIC_SCISSOR = 1 << 1,
+    KONIDE_RECORDER_DYNAMIC_LINE_WIDTH = 1 << 2,
+    KONIDE_RECORDER_DYNAMIC_DEPTH_BIAS = 1 << 3,
+    KONIDE_RECORDER_DYNAMIC_BLEND_CONSTANTS = 1 << 4,
+    KONIDE_RECORDER_DYNAMIC_STENCIL_REFERENCE = 1 << 5,
+    KONIDE_RECORDER_DYNAMIC_ALL = (1 << 6) - 1
+};
+
+struct KonideCommandRecorderStats {
+    // State calls that reached the driver and calls dropped because they changed nothing
+    uint64_t issuedCalls = 0;
+    uint64_t elidedCalls = 0;
+    uint64_t elidedPipelineBinds = 0;
+    uint64_t elidedDescriptorBinds = 0;
+    uint64_t elidedBufferBinds = 0;
+    uint64_t elidedDynamicState = 0;
+    uint64_t elidedPushConstants = 0;
+
+    KonideCommandRecorderStats& operator+=(const KonideCommandRecorderStats& other);
+};
+
+// Records into one command buffer at a time and drops binds and dynamic state that match what the
+// command buffer already has. Draws, dispatches and copies pass straight through. Only calls made
+// through the recorder are known to it, call Invalidate after recording around it, e.g. executing
+// secondaries or beginning rendering. Binding a pipeline resets the dynamic state it doesn't declare
+// dynamic, by default everything but viewport and scissor.
+class KonideCommandRecorder
+{
+protected:
+    struct DescriptorSetState {
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+    };
+
+    struct BindPointState {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        DescriptorSetState sets[KONIDE_RECORDER_MAX_DESCRIPTOR_SETS];
+    };
+
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    const KonideDeviceTable* deviceTable = nullptr;
+    bool bElide = true;
+
+    // Graphics and compute
+    BindPointState bindPoints[2];
+
+    // A null handle means unknown
+    VkBuffer vertexBuffers[KONIDE_RECORDER_MAX_VERTEX_BINDINGS] = {};
+    VkDeviceSize vertexOffsets[KONIDE_RECORDER_MAX_VERTEX_BINDINGS] = {};
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize indexOffset = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT16;
+
+    // Bits of EKonideRecorderDynamicState whose cached value below is what the command buffer has
+    uint32_t validDynamicState = 0;
+    VkViewport viewports[KONIDE_RECORDER_MAX_VIEWPORTS];
+    VkRect2D scissors[KONIDE_RECORDER_MAX_VIEWPORTS];
+    // Viewports and scissors known, counted from index 0
+    uint32_t viewportCount = 0;
+    uint32_t scissorCount = 0;
+    float lineWidth = 1.0f;
+    float depthBias[3] = {};
+    float blendConstants[4] = {};
+    // Front and back, stencilFaces has a bit per face whose reference is known
+    uint32_t stencilReference[2] = {};
+    uint32_t stencilFaces = 0;
+
+    // Push constant bytes in [pushConstantBegin, pushConstantEnd) known for one layout and set of stages
+    VkPipelineLayout pushConstantLayout = VK_NULL_HANDLE;
+    VkShaderStageFlags pushConstantStages = 0;
+    uint32_t pushConstantBegin = 0;
+    uint32_t pushConstantEnd = 0;
+    uint8_t pushConstants[KONIDE_RECORDER_MAX_PUSH_CONSTANTS];
+
+    KonideCommandRecorderStats stats;
+
+    // Null for bind points the recorder doesn't cache, e.g. ray tracing
+    BindPointState* GetBindPoint(VkPipelineBindPoint bindPoint);
+    void CountElided(uint64_t& counter);
+public:
+    // Starts recording into newCommandBuffer through the table of the device owning it, nothing about its state is known yet
+    void Begin(VkCommandBuffer newCommandBuffer, const KonideDeviceTable& newDeviceTable);
+    // Forgets all cached state, the next call of each kind reaches the driver
+    void Invalidate();
+    VkCommandBuffer GetCommandBuffer() const { return commandBuffer; }
+
+    // Without elision every call goes straight through, e.g. to compare against
+    void SetElision(bool bNewElide) { bElide = bNewElide; }
+
+    void BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline, uint32_t dynamicStateMask = KONIDE_RECORDER_DYNAMIC_VIEWPORT | KONIDE_RECORDER_DYNAMIC_SCISSOR);
+    void BindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* sets,
+        uint32_t dynamicOffsetCount = 0, const uint32_t* dynamicOffsets = nullptr);
+    void BindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* buffers, const VkDeviceSize* offsets);
+    void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type);
+    void PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values);
+
+    void SetViewport(uint32_t firstViewport, uint32_t count, const VkViewport* newViewports);
+    void SetScissor(uint32_t firstScissor, uint32_t count, const VkRect2D* newScissors);
+    void SetLineWidth(float newLineWidth);
+    void SetDepthBias(float constantFactor, float clamp, float slopeFactor);
+    void SetBlendConstants(const float newBlendConstants[4]);
+    void SetStencilReference(VkStencilFaceFlags faceMask, uint32_t reference);
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+    void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+    void CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy* regions);
+    void CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkBufferImageCopy* regions);
+
+    const KonideCommandRecorderStats& GetStats() const { return stats; }
+    void ResetStats() { stats = KonideCommandRecorderStats(); }
+};
+
+#endif
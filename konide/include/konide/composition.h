@@ -13,14 +13,25 @@ class KonideLayer;
 #include "layer.h"
 
 struct KonideSwapchain {
-    VkSwapchainKHR swapchain;
+    VkSwapchainKHR swapchain = VK_NULL_HANDLE;
     std::vector<VkImage> images;
     std::vector<VkImageView> imageViews;
-    std::vector<VkFramebuffer> framebuffers;
-    VkSurfaceKHR surface;
+    // Signaled by the frame that rendered image i, waited on by its present
+    std::vector<VkSemaphore> presentSemaphores;
+    VkSurfaceKHR surface = VK_NULL_HANDLE;
 
     VkFormat swapChainImageFormat;
     VkExtent2D swapChainExtent;
+    VkPresentModeKHR presentMode;
+    VkImageUsageFlags imageUsage = 0;
+
+    // Size asked for by the owner, the surface may clamp it
+    uint32_t requestedWidth = 0;
+    uint32_t requestedHeight = 0;
+    // Rebuilt before the next frame acquires from it
+    bool bOutOfDate = false;
+    // Bumped on every rebuild, recordings made against an older generation are stale
+    uint64_t generation = 0;
 };
 
 class KonideComposition
@@ -30,10 +41,14 @@ protected:
     std::vector<KonideLayer*> Layers;
 public:
     KonideComposition(VkSurfaceKHR surface);
+    virtual ~KonideComposition() {}
 
     virtual uint32_t AddLayer(KonideLayer* proxy);
+    virtual void RemoveLayer(KonideLayer* layer);
 
     const KonideSwapchain& GetSwapchainInfo() const { return swapchain; }
+    KonideSwapchain& GetSwapchain() { return swapchain; }
+    const std::vector<KonideLayer*>& GetLayers() const { return Layers; }
 
     virtual void Render(VkCommandBuffer commandBuffer, VkDevice device);
 };
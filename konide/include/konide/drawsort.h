@@ -0,0 +1,97 @@
+#ifndef _KONIDE_DRAW_SORT_H
+#define _KONIDE_DRAW_SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Draw sort keys, compared as plain 64-bit integers, most significant field first:
+//   opaque:      layer 8 | pass 4 | pipeline 12 | material 16 | mesh 12 | depth 12 (near first)
+//   transparent: layer 8 | pass 4 | depth 24 (far first) | pipeline 12 | material 16
+// Within a pass opaque draws group by state to keep pipeline and descriptor switches down, transparent
+// draws keep back to front order and only group state among draws at the same depth. Pipeline, material
+// and mesh are small ids handed out by the caller, wider ids are truncated.
+#define KONIDE_DRAW_KEY_LAYER_BITS 8
+#define KONIDE_DRAW_KEY_PASS_BITS 4
+#define KONIDE_DRAW_KEY_PIPELINE_BITS 12
+#define KONIDE_DRAW_KEY_MATERIAL_BITS 16
+#define KONIDE_DRAW_KEY_MESH_BITS 12
+#define KONIDE_DRAW_KEY_DEPTH_BITS 12
+#define KONIDE_DRAW_KEY_TRANSPARENT_DEPTH_BITS 24
+
+// Passes draw in this order inside a layer, pick the transparent key layout for blended passes
+enum EKonideDrawPass
+{
+    KONIDE_DRAW_PASS_OPAQUE = 0,
+    KONIDE_DRAW_PASS_MASKED = 1,
+    KONIDE_DRAW_PASS_TRANSPARENT = 2,
+    KONIDE_DRAW_PASS_OVERLAY = 3
+};
+
+inline uint64_t KonideDrawKeyField(uint64_t value, uint32_t bits)
+{
+    return value & ((1ull << bits) - 1);
+}
+
+// depth is normalized to [0, 1], 0 being the near plane
+inline uint64_t KonideQuantizeDrawDepth(float depth, uint32_t bits)
+{
+    depth = std::min(std::max(depth, 0.0f), 1.0f);
+    return (uint64_t)(depth * (float)((1ull << bits) - 1));
+}
+
+inline uint64_t KonideMakeDrawKey(uint32_t layer, uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth)
+{
+    uint64_t key = KonideDrawKeyField(layer, KONIDE_DRAW_KEY_LAYER_BITS);
+    key = (key << KONIDE_DRAW_KEY_PASS_BITS) | KonideDrawKeyField(pass, KONIDE_DRAW_KEY_PASS_BITS);
+    key = (key << KONIDE_DRAW_KEY_PIPELINE_BITS) | KonideDrawKeyField(pipeline, KONIDE_DRAW_KEY_PIPELINE_BITS);
+    key = (key << KONIDE_DRAW_KEY_MATERIAL_BITS) | KonideDrawKeyField(material, KONIDE_DRAW_KEY_MATERIAL_BITS);
+    key = (key << KONIDE_DRAW_KEY_MESH_BITS) | KonideDrawKeyField(mesh, KONIDE_DRAW_KEY_MESH_BITS);
+    key = (key << KONIDE_DRAW_KEY_DEPTH_BITS) | KonideQuantizeDrawDepth(depth, KONIDE_DRAW_KEY_DEPTH_BITS);
+    return key;
+}
+
+inline uint64_t KonideMakeTransparentDrawKey(uint32_t layer, uint32_t pass, float depth, uint32_t pipeline, uint32_t material)
+{
+    uint64_t farFirst = ((1ull << KONIDE_DRAW_KEY_TRANSPARENT_DEPTH_BITS) - 1) - KonideQuantizeDrawDepth(depth, KONIDE_DRAW_KEY_TRANSPARENT_DEPTH_BITS);
+
+    uint64_t key = KonideDrawKeyField(layer, KONIDE_DRAW_KEY_LAYER_BITS);
+    key = (key << KONIDE_DRAW_KEY_PASS_BITS) | KonideDrawKeyField(pass, KONIDE_DRAW_KEY_PASS_BITS);
+    key = (key << KONIDE_DRAW_KEY_TRANSPARENT_DEPTH_BITS) | farFirst;
+    key = (key << KONIDE_DRAW_KEY_PIPELINE_BITS) | KonideDrawKeyField(pipeline, KONIDE_DRAW_KEY_PIPELINE_BITS);
+    key = (key << KONIDE_DRAW_KEY_MATERIAL_BITS) | KonideDrawKeyField(material, KONIDE_DRAW_KEY_MATERIAL_BITS);
+    return key;
+}
+
+struct KonideDrawSortItem {
+    uint64_t key;
+    // Whatever the caller needs to find the draw again, e.g. its index in submission order
+    uint32_t index;
+};
+
+struct KonideRadixSortStats {
+    uint64_t sorts = 0;
+    uint64_t keysSorted = 0;
+    // Byte passes run and skipped because every key shared that byte
+    uint64_t passes = 0;
+    uint64_t skippedPasses = 0;
+};
+
+// Stable LSD radix sort over the 8 key bytes. All histograms are built in one read over the items, bytes
+// every key has in common are skipped, so keys only using a few fields cost few passes. Items with equal
+// keys keep their order, e.g. transparent draws at the same depth stay in submission order. The scratch
+// buffer is kept between sorts, one sorter per thread.
+class KonideRadixSorter
+{
+protected:
+    std::vector<KonideDrawSortItem> scratch;
+    KonideRadixSortStats stats;
+public:
+    void Sort(KonideDrawSortItem* items, uint32_t count);
+    void Sort(std::vector<KonideDrawSortItem>& items) { Sort(items.data(), (uint32_t)items.size()); }
+
+    const KonideRadixSortStats& GetStats() const { return stats; }
+    void ResetStats() { stats = KonideRadixSortStats(); }
+};
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef _KONIDE_FRAME_GRAPH_H
+#define _KONIDE_FRAME_GRAPH_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include "layouttracker.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef uint32_t KonideFrameGraphResource;
+#define KONIDE_FRAME_GRAPH_INVALID_RESOURCE UINT32_MAX
+
+enum EKonideFrameGraphResourceType
+{
+    KONIDE_FRAME_GRAPH_IMAGE = 0,
+    KONIDE_FRAME_GRAPH_BUFFER = 1
+};
+
+struct KonideFrameGraphImageDesc {
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent = {};
+    VkImageUsageFlags usage = 0;
+    VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    uint32_t mipLevels = 1;
+    uint32_t arrayLayers = 1;
+};
+
+struct KonideFrameGraphBufferDesc {
+    VkDeviceSize size = 0;
+    VkBufferUsageFlags usage = 0;
+};
+
+// One pass's use of a resource, accesses of the same pass to the same resource are merged
+struct KonideFrameGraphAccess {
+    KonideFrameGraphResource resource = KONIDE_FRAME_GRAPH_INVALID_RESOURCE;
+    VkPipelineStageFlags2 stageMask = 0;
+    VkAccessFlags2 accessMask = 0;
+    // Images only, a levelCount of 0 covers the whole resource
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageSubresourceRange range = {};
+    bool bWrite = false;
+
+    // Compile results for picking attachment load and store ops
+    // Something earlier left contents the pass could load
+    bool bContentsDefined = false;
+    // A later pass or the importer still needs what the pass leaves behind
+    bool bContentsUsed = false;
+};
+
+struct KonideFrameGraphResourceNode {
+    std::string name;
+    EKonideFrameGraphResourceType type = KONIDE_FRAME_GRAPH_IMAGE;
+
+    // Imported resources live outside the graph, writing one keeps the writer alive
+    bool bImported = false;
+    VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    // Last use before the graph, the first access waits for it
+    VkPipelineStageFlags2 initialStageMask = 0;
+    VkAccessFlags2 initialAccessMask = 0;
+    // UNDEFINED keeps whatever layout the last pass left
+    VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    KonideFrameGraphImageDesc imageDesc;
+    KonideFrameGraphBufferDesc bufferDesc;
+
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView imageView = VK_NULL_HANDLE;
+    VkImageSubresourceRange range = {};
+    VkBuffer buffer = VK_NULL_HANDLE;
+
+    // Compile results: live pass range and, for transients, the memory block
+    uint32_t firstPass = UINT32_MAX;
+    uint32_t lastPass = 0;
+    int32_t memoryBlock = -1;
+};
+
+struct KonideFrameGraphPass {
+    std::string name;
+    std::vector<KonideFrameGraphAccess> accesses;
+    std::function<void(VkCommandBuffer)> execute;
+
+    // Never culled, e.g. passes writing outside the graph
+    bool bSideEffects = false;
+    bool bCulled = false;
+
+    // Recorded right before the pass in one vkCmdPipelineBarrier2
+    std::vector<VkImageMemoryBarrier2> imageBarriers;
+    std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+
+    // CPU time of the last Execute, in seconds
+    double recordTime = 0.0;
+};
+
+class KonideFrameGraph;
+
+// Handed to a pass's setup function to declare what the pass touches
+class KonideFrameGraphPassBuilder
+{
+protected:
+    KonideFrameGraph& graph;
+    uint32_t passIdx;
+
+    void AddAccess(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkImageLayout layout, bool bWrite,
+        const VkImageSubresourceRange* range);
+public:
+    KonideFrameGraphPassBuilder(KonideFrameGraph& newGraph, uint32_t newPassIdx) : graph(newGraph), passIdx(newPassIdx) {}
+
+    // Transient resources only exist for the frame, their memory is aliased with others whose lifetimes don't overlap
+    KonideFrameGraphResource CreateImage(const std::string& name, const KonideFrameGraphImageDesc& desc);
+    KonideFrameGraphResource CreateBuffer(const std::string& name, const KonideFrameGraphBufferDesc& desc);
+
+    // range limits an image access to some mips or layers, e.g. one mip per pass of a downsample chain
+    void Read(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        const VkImageSubresourceRange* range = nullptr);
+    void Write(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED,
+        const VkImageSubresourceRange* range = nullptr);
+
+    void ColorAttachment(KonideFrameGraphResource resource);
+    void SampledImage(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    void TransferDst(KonideFrameGraphResource resource);
+
+    void SetSideEffects();
+};
+
+// Aliasing slot for transient resources, occupants never overlap in lifetime
+struct KonideFrameGraphMemoryBlock {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+    uint32_t memoryTypeBits = UINT32_MAX;
+    std::vector<KonideFrameGraphResource> occupants;
+
+    // Last use, carried into the next occupant and the next frame
+    VkPipelineStageFlags2 lastStageMask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 lastAccessMask = VK_ACCESS_2_NONE;
+};
+
+// Vulkan objects backing one transient resource
+struct KonideFrameGraphTransient {
+    KonideFrameGraphResource resource = KONIDE_FRAME_GRAPH_INVALID_RESOURCE;
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView imageView = VK_NULL_HANDLE;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkMemoryRequirements memoryRequirements = {};
+    int32_t memoryBlock = -1;
+};
+
+struct KonideFrameGraphStats {
+    uint32_t passes = 0;
+    uint32_t culledPasses = 0;
+    // vkCmdPipelineBarrier2 calls and the barriers inside them
+    uint32_t barrierBatches = 0;
+    uint32_t imageBarriers = 0;
+    uint32_t bufferBarriers = 0;
+    uint32_t layoutTransitions = 0;
+    // Transient memory with and without aliasing
+    VkDeviceSize transientMemory = 0;
+    VkDeviceSize unaliasedMemory = 0;
+    // Seconds
+    double compileTime = 0.0;
+    double executeTime = 0.0;
+};
+
+// Per frame graph of passes and the images and buffers they read and write. Passes are declared in
+// execution order. Compile culls passes whose results nobody uses, places transient resources into
+// aliased memory and derives synchronization2 barriers; Execute records barriers and passes.
+class KonideFrameGraph
+{
+    friend class KonideFrameGraphPassBuilder;
+protected:
+    VkDevice device = VK_NULL_HANDLE;
+    const KonideDeviceTable* deviceTable = nullptr;
+    VkPhysicalDeviceMemoryProperties memoryProperties = {};
+    std::function<void(std::function<void()>)> deferDestruction;
+
+    std::vector<KonideFrameGraphResourceNode> resources;
+    std::vector<KonideFrameGraphPass> passes;
+    std::vector<VkImageMemoryBarrier2> finalImageBarriers;
+    std::vector<VkBufferMemoryBarrier2> finalBufferBarriers;
+
+    // Transient objects survive across frames while the graph keeps the same shape
+    std::string transientSignature;
+    std::vector<KonideFrameGraphMemoryBlock> memoryBlocks;
+    std::vector<KonideFrameGraphTransient> transients;
+
+    // Derives the barriers, per subresource, while Compile walks the passes
+    KonideLayoutTracker tracker;
+
+    KonideFrameGraphStats stats;
+    bool bCompiled = false;
+    uint32_t executingPass = UINT32_MAX;
+
+    void CullPasses();
+    void ComputeLifetimes();
+    void AllocateTransients();
+    void ReleaseTransients();
+    void BuildBarriers();
+
+    std::string BuildTransientSignature() const;
+    uint32_t FindMemoryType(uint32_t typeBits) const;
+public:
+    ~KonideFrameGraph();
+
+    // deferDestruction must run its argument once frames recorded so far are complete, newDeviceTable must outlive the graph
+    void Initialize(VkDevice newDevice, const KonideDeviceTable& newDeviceTable, const VkPhysicalDeviceMemoryProperties& newMemoryProperties, std::function<void(std::function<void()>)> newDeferDestruction);
+    // Frees every transient object right away, the device must be idle
+    void Shutdown();
+
+    // Starts a new frame, transient objects are kept for reuse
+    void Reset();
+
+    KonideFrameGraphResource ImportImage(const std::string& name, VkImage image, VkImageView imageView, const VkImageSubresourceRange& range,
+        VkImageLayout initialLayout, VkPipelineStageFlags2 initialStageMask, VkImageLayout finalLayout);
+    KonideFrameGraphResource ImportBuffer(const std::string& name, VkBuffer buffer, VkDeviceSize size,
+        VkPipelineStageFlags2 initialStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VkAccessFlags2 initialAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT);
+
+    uint32_t AddPass(const std::string& name, const std::function<void(KonideFrameGraphPassBuilder&)>& setup, std::function<void(VkCommandBuffer)> execute);
+
+    void Compile();
+    void Execute(VkCommandBuffer commandBuffer);
+
+    // Valid inside pass execution
+    VkImage GetImage(KonideFrameGraphResource resource) const { return resources[resource].image; }
+    VkImageView GetImageView(KonideFrameGraphResource resource) const { return resources[resource].imageView; }
+    VkBuffer GetBuffer(KonideFrameGraphResource resource) const { return resources[resource].buffer; }
+    const KonideFrameGraphResourceNode& GetResource(KonideFrameGraphResource resource) const { return resources[resource]; }
+
+    // Valid inside pass execution, for attachments of the executing pass. LOAD turns into DONT_CARE
+    // when nothing defined the contents yet, STORE into DONT_CARE when nothing reads them afterwards.
+    VkAttachmentLoadOp GetAttachmentLoadOp(KonideFrameGraphResource resource, VkAttachmentLoadOp requested = VK_ATTACHMENT_LOAD_OP_LOAD) const;
+    VkAttachmentStoreOp GetAttachmentStoreOp(KonideFrameGraphResource resource) const;
+
+    const KonideFrameGraphStats& GetStats() const { return stats; }
+
+    // Human readable compiled graph: passes, barriers, transient placement and timings
+    std::string Dump() const;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _KONIDE_FRAME_PACKET_H
+#define _KONIDE_FRAME_PACKET_H
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <chrono>
+
+class KonideLayer;
+class KonideProxy;
+
+// A single layer/proxy state change, applied on the render thread before the frame is recorded
+struct KonideStateDelta {
+    KonideLayer* layer = nullptr;
+    KonideProxy* proxy = nullptr;
+    std::function<void()> apply;
+};
+
+// Everything the render thread needs from the application thread to produce one frame
+struct KonideFramePacket {
+    uint64_t packetIndex = 0;
+    std::vector<KonideStateDelta> deltas;
+    std::chrono::steady_clock::time_point submitTime;
+};
+
+// Accumulated render thread timings, all times in seconds
+struct KonideRenderThreadStats {
+    uint64_t packetsSubmitted = 0;
+    // Submissions that found the queue full and waited for the render thread
+    uint64_t packetsBlocked = 0;
+    uint64_t packetsRendered = 0;
+
+    // Application thread, handoff includes the wait for queue space
+    double appHandoffTime = 0.0;
+    double appWaitTime = 0.0;
+
+    // Render thread
+    double renderIdleTime = 0.0;
+    double renderApplyTime = 0.0;
+    double renderFlushTime = 0.0;
+    // Time packets spent queued between SubmitFramePacket and the render thread picking them up
+    double packetQueueTime = 0.0;
+};
+
+#endif
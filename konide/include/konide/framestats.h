@@ -0,0 +1,83 @@
+#ifndef _KONIDE_FRAME_STATS_H
+#define _KONIDE_FRAME_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define KONIDE_FRAME_STATS_CAPACITY 1024
+
+enum EKonideFramePhase
+{
+    // Waiting for the frame slot's previous submission
+    KONIDE_FRAME_PHASE_FRAME_WAIT = 0,
+    KONIDE_FRAME_PHASE_ACQUIRE_WAIT = 1,
+    KONIDE_FRAME_PHASE_RECORD = 2,
+    KONIDE_FRAME_PHASE_SUBMIT = 3,
+    KONIDE_FRAME_PHASE_PRESENT = 4,
+    // Whole FlushRender call, including the phases above
+    KONIDE_FRAME_PHASE_TOTAL = 5,
+
+    KONIDE_FRAME_PHASE_COUNT
+};
+
+const char* KonideFramePhaseName(EKonideFramePhase phase);
+
+// Phase timings of one produced frame, all times in seconds
+struct KonideFrameTiming {
+    uint64_t frame = 0;
+    double phases[KONIDE_FRAME_PHASE_COUNT] = {};
+};
+
+struct KonideFrameHistogram {
+    EKonideFramePhase phase = KONIDE_FRAME_PHASE_TOTAL;
+    double bucketWidth = 0.0;
+    // buckets[i] counts samples in [i * bucketWidth, (i + 1) * bucketWidth)
+    std::vector<uint64_t> buckets;
+    // Samples past the last bucket
+    uint64_t overflow = 0;
+    uint64_t sampleCount = 0;
+
+    // "lower_ms,upper_ms,count" lines, the overflow bucket has an empty upper bound
+    std::string ToCSV() const;
+};
+
+// Fixed ring of the most recent frame timings. One thread records (the one calling FlushRender),
+// any thread may query at the same time without locks; a slot overwritten mid-read is dropped.
+class KonideFrameStats
+{
+protected:
+    struct Slot {
+        // 2 * index + 1 while the slot is being written, 2 * index + 2 once it holds sample index
+        std::atomic<uint64_t> sequence{ 0 };
+        std::atomic<uint64_t> frame{ 0 };
+        std::atomic<uint64_t> phases[KONIDE_FRAME_PHASE_COUNT] = {};
+    };
+
+    Slot slots[KONIDE_FRAME_STATS_CAPACITY];
+
+    std::atomic<uint64_t> writeCount{ 0 };
+    // Samples below this index were dropped by Reset
+    std::atomic<uint64_t> firstSample{ 0 };
+
+    bool ReadSlot(uint64_t index, KonideFrameTiming& timing) const;
+public:
+    void Record(const KonideFrameTiming& timing);
+
+    // Copies the retained samples, oldest first
+    void Snapshot(std::vector<KonideFrameTiming>& timings) const;
+
+    // Nearest-rank percentile in seconds, percentile in [0, 100], 0 without samples
+    double GetPercentile(EKonideFramePhase phase, double percentile) const;
+
+    // Evaluates several percentiles from a single snapshot
+    void GetPercentiles(EKonideFramePhase phase, const double* percentiles, double* results, uint32_t count) const;
+
+    KonideFrameHistogram GetHistogram(EKonideFramePhase phase, double bucketWidth, uint32_t bucketCount) const;
+
+    uint64_t GetSampleCount() const;
+    void Reset();
+};
+
+#endif
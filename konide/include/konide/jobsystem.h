@@ -0,0 +1,116 @@
+#ifndef _KONIDE_JOB_SYSTEM_H
+#define _KONIDE_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Per worker deque capacity, jobs pushed past it go to the shared queue
+#define KONIDE_JOB_DEQUE_CAPACITY 4096
+
+struct KonideJob;
+
+// Tracks a group of scheduled jobs. Jobs scheduled with a counter increment it and decrement it
+// once they finished; jobs scheduled with it as a dependency start once it drops to zero.
+class KonideJobCounter
+{
+    friend class KonideJobSystem;
+protected:
+    std::atomic<uint32_t> pending{ 0 };
+    // Finishing jobs still touching the counter, it may only be destroyed once this is zero too
+    std::atomic<uint32_t> finishing{ 0 };
+
+    std::mutex continuationMutex;
+    std::vector<KonideJob*> continuations;
+public:
+    bool IsDone() const { return pending.load() == 0 && finishing.load() == 0; }
+};
+
+struct KonideJob {
+    std::function<void()> function;
+    KonideJobCounter* counter = nullptr;
+};
+
+struct KonideJobSystemStats {
+    uint64_t jobsExecuted = 0;
+    // Jobs taken from another worker's deque
+    uint64_t jobsStolen = 0;
+};
+
+// Fixed size Chase-Lev deque: the owning worker pushes and pops at the bottom, any thread steals from the top
+class KonideJobDeque
+{
+protected:
+    std::atomic<int64_t> top{ 0 };
+    std::atomic<int64_t> bottom{ 0 };
+    std::atomic<KonideJob*> jobs[KONIDE_JOB_DEQUE_CAPACITY] = {};
+public:
+    bool Push(KonideJob* job);
+    KonideJob* Pop();
+    KonideJob* Steal();
+};
+
+// Work stealing scheduler shared by every parallel path of a renderer. Each worker owns a deque,
+// jobs scheduled from a worker go to its own deque, jobs from any other thread go to a shared queue.
+// Idle workers steal, threads waiting on a counter run jobs instead of blocking.
+class KonideJobSystem
+{
+protected:
+    struct alignas(64) Worker {
+        KonideJobDeque deque;
+        std::thread thread;
+        std::atomic<uint64_t> jobsExecuted{ 0 };
+        std::atomic<uint64_t> jobsStolen{ 0 };
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex sharedMutex;
+    std::deque<KonideJob*> sharedJobs;
+    // Jobs run by threads that aren't workers
+    std::atomic<uint64_t> externalJobsExecuted{ 0 };
+
+    // Scheduled but not yet picked up, idle workers sleep while this is zero
+    std::atomic<int64_t> queuedJobs{ 0 };
+    std::atomic<uint32_t> sleepingWorkers{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<bool> bExit{ false };
+
+    void Push(KonideJob* job);
+    KonideJob* FindJob(int32_t workerIdx);
+    void Execute(KonideJob* job, int32_t workerIdx);
+    void FinishJob(KonideJobCounter* counter);
+
+    void WorkerMain(int32_t workerIdx);
+public:
+    ~KonideJobSystem();
+
+    // 0 starts one worker less than there are hardware threads, leaving room for the calling thread
+    void Start(uint32_t workerCount = 0);
+    // Runs every job still queued, then joins the workers
+    void Stop();
+    uint32_t GetWorkerCount() const { return (uint32_t)workers.size(); }
+    // Index of the calling thread's worker in this job system, -1 for any other thread
+    int32_t GetCurrentWorkerIndex() const;
+
+    // Schedule dependents only after scheduling the jobs they depend on, a dependency that is
+    // still at zero counts as done.
+    void Schedule(std::function<void()> function, KonideJobCounter* counter = nullptr, KonideJobCounter* dependency = nullptr);
+
+    // Runs other jobs until counter drops to zero, works with no workers started as well
+    void Wait(KonideJobCounter& counter);
+
+    // Calls function(begin, end) on ranges of at most grainSize indices in [0, count) and waits for all of them
+    void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& function);
+
+    KonideJobSystemStats GetStats() const;
+};
+
+#endif
@@ -6,18 +6,62 @@
 #endif
 #include <vulkan/vulkan.h>
 
+#include "commandlist.h"
+#include "framegraph.h"
+
+#include <atomic>
 #include <cstdint>
 
 class KonideProxy;
+class KonideJobSystem;
 
 class KonideLayer
 {
 protected:
+    // Scheduler of the renderer owning this layer, for work that can fan out across threads
+    KonideJobSystem* JobSystem = nullptr;
+    // Entry points of the renderer's device, record through these instead of the global ones
+    const KonideDeviceTable* DeviceTable = nullptr;
+
+    // Cacheable layers are recorded once per frame slot and output, then replayed until MarkDirty
+    bool bCacheable = false;
+    std::atomic<uint64_t> revision{ 1 };
 
+    // What Encode produced for the current frame, translated by the default Render
+    KonideCommandList commandList;
+    // Drops redundant binds and dynamic state, layers overriding Render may record through it too
+    KonideCommandRecorder recorder;
 public:
+    virtual ~KonideLayer() {}
+
+    void SetJobSystem(KonideJobSystem* NewJobSystem) { JobSystem = NewJobSystem; }
+    void SetDeviceTable(const KonideDeviceTable* NewDeviceTable) { DeviceTable = NewDeviceTable; }
+
+    void SetCacheable(bool bNewCacheable) { bCacheable = bNewCacheable; }
+    bool IsCacheable() const { return bCacheable; }
+
+    // Call whenever what Render records changes, cached recordings are redone on their next use
+    void MarkDirty() { revision.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t GetRevision() const { return revision.load(std::memory_order_relaxed); }
+
     virtual uint32_t AddProxy(KonideProxy* proxy);
 
-    virtual void Render(VkCommandBuffer commandBuffer, VkDevice device){}
+    // Adds passes that run before the layers draw into target, e.g. to fill transient images Render samples
+    virtual void SetupPasses(KonideFrameGraph& frameGraph, KonideFrameGraphResource target) {}
+
+    // Encodes what the layer draws, runs on any thread before the frame is recorded. Cacheable layers
+    // only encode when their recording is redone. Layers that record directly override Render instead.
+    virtual void Encode(KonideCommandList& commandList) {}
+    // Restarts the layer's list in arena and runs Encode on it
+    void EncodeCommands(KonideFrameArena& arena);
+    const KonideCommandList& GetCommandList() const { return commandList; }
+
+    // Calls the recorder made and dropped since the last reset
+    const KonideCommandRecorderStats& GetRecorderStats() const { return recorder.GetStats(); }
+    void ResetRecorderStats() { recorder.ResetStats(); }
+
+    // Translates the encoded list unless overridden
+    virtual void Render(VkCommandBuffer commandBuffer, VkDevice device);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef _KONIDE_LAYOUT_TRACKER_H
+#define _KONIDE_LAYOUT_TRACKER_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include "vulkan/vkloader_tables.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct KonideLayoutTrackerStats {
+    // vkCmdPipelineBarrier2 calls, or batches taken, and the barriers inside them
+    uint64_t barrierBatches = 0;
+    uint64_t imageBarriers = 0;
+    uint64_t bufferBarriers = 0;
+    uint64_t layoutTransitions = 0;
+    // Requests that needed no barrier because an earlier one already covered them
+    uint64_t elidedRequests = 0;
+};
+
+// Layout and access state of one image subresource or one buffer
+struct KonideTrackedState {
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    // Last write, or layout transition, every later access has to wait for
+    VkPipelineStageFlags2 writeStageMask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 writeAccessMask = VK_ACCESS_2_NONE;
+    // Reads since that write, a later write waits for them and readers already covered skip the barrier
+    VkPipelineStageFlags2 readStageMask = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 readAccessMask = VK_ACCESS_2_NONE;
+    // Batch holding a barrier for this state that hasn't been recorded yet
+    uint64_t pendingBatch = 0;
+};
+
+// One vkCmdPipelineBarrier2 worth of barriers
+struct KonideBarrierBatch {
+    std::vector<VkImageMemoryBarrier2> imageBarriers;
+    std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+};
+
+// Tracks layout and last access per image subresource (mip level and array layer) and per buffer.
+// Accesses are requested as they come up, the tracker works out the barriers they need, merges
+// neighbouring subresources into one barrier and collects everything into a batch that is recorded
+// with a single vkCmdPipelineBarrier2. A request that touches a subresource already waiting in the
+// current batch starts a new batch, barriers inside one call aren't ordered against each other.
+class KonideLayoutTracker
+{
+protected:
+    struct ImageState {
+        VkImageAspectFlags aspectMask = 0;
+        uint32_t mipLevels = 1;
+        uint32_t arrayLayers = 1;
+        // Indexed by mip * arrayLayers + layer
+        std::vector<KonideTrackedState> subresources;
+    };
+
+    std::unordered_map<VkImage, ImageState> images;
+    std::unordered_map<VkBuffer, KonideTrackedState> buffers;
+
+    // Batches are kept around so their vectors keep their capacity across frames
+    std::vector<KonideBarrierBatch> batches;
+    uint32_t pendingBatches = 0;
+    // Id of the batch currently collecting barriers, pendingBatch of a state compares against it
+    uint64_t batchId = 1;
+
+    KonideLayoutTrackerStats stats;
+
+    KonideBarrierBatch& CurrentBatch(bool bConflict);
+    // Computes the barrier an access to state needs, if any, and moves state past the access
+    bool ResolveAccess(KonideTrackedState& state, bool bImage, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask,
+        bool bWrite, VkPipelineStageFlags2& srcStageMask, VkAccessFlags2& srcAccessMask, VkImageLayout& oldLayout);
+    void CountBatch(const KonideBarrierBatch& batch);
+public:
+    // Starts tracking image with every subresource in initialLayout, last touched at initialStageMask
+    void RegisterImage(VkImage image, VkImageAspectFlags aspectMask, uint32_t mipLevels, uint32_t arrayLayers, VkImageLayout initialLayout,
+        VkPipelineStageFlags2 initialStageMask = VK_PIPELINE_STAGE_2_NONE, VkAccessFlags2 initialAccessMask = VK_ACCESS_2_NONE);
+    void RegisterBuffer(VkBuffer buffer, VkPipelineStageFlags2 initialStageMask = VK_PIPELINE_STAGE_2_NONE, VkAccessFlags2 initialAccessMask = VK_ACCESS_2_NONE);
+    void Unregister(VkImage image);
+    void Unregister(VkBuffer buffer);
+    // Forgets every image and buffer and drops pending barriers
+    void Clear();
+
+    bool IsTracked(VkImage image) const { return images.count(image) != 0; }
+    bool IsTracked(VkBuffer buffer) const { return buffers.count(buffer) != 0; }
+    VkImageLayout GetLayout(VkImage image, uint32_t mipLevel = 0, uint32_t arrayLayer = 0) const;
+
+    // Stages and writes the next user of the memory has to wait for, across every subresource
+    void GetLastUse(VkImage image, VkPipelineStageFlags2& stageMask, VkAccessFlags2& accessMask) const;
+    void GetLastUse(VkBuffer buffer, VkPipelineStageFlags2& stageMask, VkAccessFlags2& accessMask) const;
+
+    // Layout UNDEFINED keeps the current layout. Requests never record anything, Flush or TakeBatch does.
+    void RequestImage(VkImage image, const VkImageSubresourceRange& range, VkImageLayout layout, VkPipelineStageFlags2 stageMask,
+        VkAccessFlags2 accessMask, bool bWrite);
+    void RequestBuffer(VkBuffer buffer, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, bool bWrite);
+
+    bool HasPending() const { return pendingBatches > 0; }
+    uint32_t GetPendingBatchCount() const { return pendingBatches; }
+
+    // Records every pending batch, one vkCmdPipelineBarrier2 each. Returns how many calls it made.
+    uint32_t Flush(VkCommandBuffer commandBuffer, const KonideDeviceTable& deviceTable);
+    // Moves the pending barriers out instead of recording them, for callers that record later.
+    // Returns false if there were none, throws if they span more than one batch.
+    bool TakeBatch(std::vector<VkImageMemoryBarrier2>& imageBarriers, std::vector<VkBufferMemoryBarrier2>& bufferBarriers);
+
+    const KonideLayoutTrackerStats& GetStats() const { return stats; }
+    void ResetStats() { stats = KonideLayoutTrackerStats(); }
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef _KONIDE_PARALLEL_RECORDER_H
+#define _KONIDE_PARALLEL_RECORDER_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include "vulkan/vkloader_tables.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define KONIDE_RECORDER_MAX_FRAME_SLOTS 3
+
+class KonideLayer;
+class KonideJobSystem;
+
+// Records layers into secondary command buffers on the renderer's job system. Every job system
+// worker owns one command pool per frame slot so recording never touches a pool another thread
+// uses, threads that aren't workers share one more set. Layers record in any order, but the
+// returned buffers are always in layer order.
+class KonideParallelRecorder
+{
+protected:
+    struct Context {
+        // Only contended by threads that aren't workers, recursive since a layer waiting on jobs may record another
+        std::recursive_mutex mutex;
+        VkCommandPool pools[KONIDE_RECORDER_MAX_FRAME_SLOTS] = {};
+        std::vector<VkCommandBuffer> buffers[KONIDE_RECORDER_MAX_FRAME_SLOTS];
+        uint32_t usedBuffers = 0;
+        // Buffers this context had to allocate during lastJob
+        uint32_t allocations = 0;
+        uint64_t lastJob = 0;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    const KonideDeviceTable* deviceTable = nullptr;
+    uint32_t queueFamily = 0;
+    KonideJobSystem* jobSystem = nullptr;
+
+    // One per job system worker, the last one for every other thread
+    std::vector<std::unique_ptr<Context>> contexts;
+    uint64_t jobCount = 0;
+
+    Context& GetContext();
+    void CreateContextPools(Context& context);
+
+    void RecordLayers(const std::vector<KonideLayer*>& layers, const std::vector<VkFormat>& formats, uint32_t frameSlot,
+        uint64_t job, uint32_t begin, uint32_t end, VkCommandBuffer* buffers);
+public:
+    ~KonideParallelRecorder();
+
+    // newDeviceTable and newJobSystem must outlive the recorder, the job system must already be started
+    void Initialize(VkDevice newDevice, const KonideDeviceTable& newDeviceTable, uint32_t newQueueFamily, KonideJobSystem& newJobSystem);
+    // Frees every pool, no frame recorded with them may still be executing
+    void Destroy();
+
+    // Records every layer into its own secondary command buffer from the frameSlot pools, split into
+    // at most maxRanges job system ranges. The previous frame recorded into frameSlot must be complete.
+    // Each buffer continues a dynamic rendering instance with a single color attachment of the layer's
+    // entry in formats. buffers receives one buffer per layer, in layer order. Returns how many secondary
+    // buffers had to be allocated, which drops to 0 once every pool has seen the layers it records.
+    uint32_t Record(const std::vector<KonideLayer*>& layers, const std::vector<VkFormat>& formats, uint32_t frameSlot, uint32_t maxRanges, std::vector<VkCommandBuffer>& buffers);
+};
+
+#endif
@@ -2,10 +2,30 @@
 #define _KONIDE_RENDERER_H
 
 #include <vector>
+#include <map>
+#include <utility>
 #include <string>
 #include <optional>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <exception>
 
+#include "commandlist.h"
 #include "composition.h"
+#include "framepacket.h"
+#include "framestats.h"
+#include "framegraph.h"
+#include "parallelrecorder.h"
+#include "jobsystem.h"
+#include "submitbatcher.h"
+#include "trace.h"
+#include "vulkan/vkloader_tables.h"
 
 #ifndef VK_NO_PROTOTYPES
 #	define VK_NO_PROTOTYPES
@@ -17,7 +37,106 @@ enum EKonideRenderFeatureFlags
     KONIDE_RENDER_FEATURE_NONE = 0,
     KONIDE_RENDER_FEATURE_SWAPCHAIN = 1 << 0,
     KONIDE_RENDER_FEATURE_RAYTRACING = 1 << 1,
-    KONIDE_RENDER_FEATURE_VALIDATION_LAYERS = 1 << 2
+    KONIDE_RENDER_FEATURE_VALIDATION_LAYERS = 1 << 2,
+    // Resolve every entrypoint compiled in instead of core and enabled extensions only, e.g. to compare startup time
+    KONIDE_RENDER_FEATURE_LOAD_ALL_ENTRYPOINTS = 1 << 3
+};
+
+enum EKonideAcquirePolicy
+{
+    // Wait as long as it takes for a swapchain image
+    KONIDE_ACQUIRE_BLOCKING = 0,
+    // Wait up to the acquire timeout, skip the frame when no image shows up in time
+    KONIDE_ACQUIRE_BOUNDED_WAIT = 1,
+    // Never wait, skip the frame right away when no image is ready
+    KONIDE_ACQUIRE_SKIP_FRAME = 2
+};
+
+#define KONIDE_DEFAULT_FRAMES_IN_FLIGHT 2
+#define KONIDE_MAX_FRAMES_IN_FLIGHT 3
+#define KONIDE_MAX_LATENCY_SAMPLES 4096
+
+static_assert(KONIDE_MAX_FRAMES_IN_FLIGHT <= KONIDE_RECORDER_MAX_FRAME_SLOTS, "parallel recorder needs a pool per frame slot");
+
+// A cacheable layer's recording for one frame slot and output
+struct KonideLayerCacheEntry {
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    uint64_t revision = 0;
+    uint64_t swapchainGeneration = 0;
+};
+
+// Per frame-in-flight resources, reused once the frame timeline reaches the slot's last submission
+struct KonideFrameSlot {
+    VkCommandPool cmdPool = VK_NULL_HANDLE;
+    VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+
+    VkCommandPool cachePool = VK_NULL_HANDLE;
+    std::map<std::pair<const KonideLayer*, const KonideSwapchain*>, KonideLayerCacheEntry> layerCache;
+    // Acquire cannot signal a timeline semaphore, one binary semaphore per frame output
+    std::vector<VkSemaphore> aquireSemaphores;
+
+    // Frame timeline value signaled by this slot's last submission
+    uint64_t submittedFrames = 0;
+};
+
+// Destruction postponed until every frame submitted before it was queued has completed
+struct KonideDeferredDeletion {
+    uint64_t frame;
+    std::function<void()> destroy;
+};
+
+// Accumulated FlushRender timings, all times in seconds
+struct KonideFramePacingStats {
+    uint64_t frameCount = 0;
+    // FlushRender calls that returned without producing a frame
+    uint64_t skippedFrames = 0;
+    double totalTime = 0.0;
+    double frameWaitTime = 0.0;
+    // Blocked in vkAcquireNextImageKHR waiting for the presentation engine to release an image
+    double acquireWaitTime = 0.0;
+    // FlushRender time minus both waits
+    double cpuTime = 0.0;
+
+    double GetFramesPerSecond() const { return totalTime > 0.0 ? frameCount / totalTime : 0.0; }
+    // Share of frame time the CPU spent working instead of blocking on the GPU or the presentation engine
+    double GetOverlap() const { return totalTime > 0.0 ? cpuTime / totalTime : 0.0; }
+};
+
+// Input-to-present latency of one frame, measured in low latency mode
+struct KonideLatencySample {
+    uint64_t frame;
+    // Seconds from the frame's start (WaitForFrameLatency) until it was presented
+    double latency;
+    // True when measured with VK_KHR_present_wait, false when estimated from GPU completion
+    bool bPresentWait;
+};
+
+// Command memory churn counters, allocations only happen when frame slots are (re)created
+struct KonideCommandStats {
+    uint64_t commandBufferAllocations = 0;
+    uint64_t commandPoolResets = 0;
+    // vkQueueSubmit2 calls in total and in the most recent frame
+    uint64_t queueSubmits = 0;
+    uint32_t lastFrameQueueSubmits = 0;
+    // Cacheable layers replayed as is and re-recorded after a change
+    uint64_t layerCacheHits = 0;
+    uint64_t layerCacheRecords = 0;
+    // Frame graph pipeline barriers in total and in the most recent frame
+    uint64_t barrierBatches = 0;
+    uint64_t imageBarriers = 0;
+    uint64_t bufferBarriers = 0;
+    uint64_t layoutTransitions = 0;
+    uint32_t lastFrameBarrierBatches = 0;
+    uint32_t lastFrameBarriers = 0;
+    // Commands layers encoded in total and arena bytes their lists took in the most recent frame
+    uint64_t encodedCommands = 0;
+    size_t lastFrameEncodedBytes = 0;
+    // Draws ordered by sort key across all encoded lists
+    uint64_t sortedDraws = 0;
+    // Bind and dynamic state calls layer recorders passed on and dropped as redundant
+    uint64_t issuedStateCalls = 0;
+    uint64_t elidedStateCalls = 0;
+    uint64_t lastFrameElidedStateCalls = 0;
 };
 
 struct KonideQueueFamilyIndices {
@@ -29,6 +148,22 @@ struct KonideQueueFamilyIndices {
     }
 };
 
+// A swapchain presented to by the current frame
+struct KonideFrameOutput {
+    KonideSwapchain* swapchain = nullptr;
+    // Null for the renderer's own swapchain
+    KonideComposition* composition = nullptr;
+
+    bool bAcquired = false;
+    uint32_t imageIndex = 0;
+    VkSemaphore acquireSemaphore = VK_NULL_HANDLE;
+
+    // Renderer layers for the renderer's own swapchain, the composition's otherwise
+    const std::vector<KonideLayer*>* layers = nullptr;
+};
+
+// Each renderer owns its instance, device, queues and dispatch tables, several can live in one process
+// and be initialized from different threads at the same time
 class KonideRenderer
 {
 private:
@@ -36,28 +171,125 @@ private:
 
     VkInstance instance;
     VkPhysicalDevice physDevice;
-    VkDevice device;
+    VkDevice device = VK_NULL_HANDLE;
+
+    // Entry points of this renderer's instance and device, every call the renderer makes goes through these
+    KonideInstanceTable instanceTable = {};
+    KonideDeviceTable deviceTable = {};
+    KonideLoaderStats loaderStats;
 
     VkDebugUtilsMessengerEXT debugMessenger;
 
     VkQueue graphicsQueue;
-    VkQueue presentQueue;
+    VkQueue presentQueue = VK_NULL_HANDLE;
+
+    std::vector<KonideFrameSlot> frames;
+    uint32_t framesInFlight = KONIDE_DEFAULT_FRAMES_IN_FLIGHT;
+    uint32_t currentFrame = 0;
+
+    // Timeline semaphore signaled with frameNumber by every frame submission
+    VkSemaphore frameTimeline = VK_NULL_HANDLE;
+
+    // Frames submitted so far and frames known to be finished on the GPU
+    uint64_t frameNumber = 0;
+    uint64_t completedFrames = 0;
+
+    std::deque<KonideDeferredDeletion> deferredDeletions;
+
+    KonideSubmitBatcher submitBatcher;
+
+    // Low latency pacing state
+    bool bPresentWaitSupported = false;
+    bool bLowLatencyMode = false;
+    uint32_t maxQueuedFrames = 1;
+    bool bFrameStarted = false;
+    uint64_t swapchainFirstPresentId = 0;
+    std::chrono::steady_clock::time_point frameStartTime;
+    std::deque<std::pair<uint64_t, std::chrono::steady_clock::time_point>> pendingLatencyFrames;
+
+    // Render thread mode: the application thread fills buildingPacket and hands it off,
+    // renderThread consumes pendingPackets and runs FlushRender
+    std::thread renderThread;
+    std::mutex packetMutex;
+    std::condition_variable packetCondition;
+    // Signalled when the render thread takes a packet or fails, SubmitFramePacket waits on it while the queue is full
+    std::condition_variable packetSpaceCondition;
+    std::deque<KonideFramePacket> pendingPackets;
+    KonideFramePacket buildingPacket;
+    uint64_t packetCounter = 0;
+    uint32_t maxPendingPackets = 1;
+    bool bRenderThreadExit = false;
+    // Set when FlushRender threw on the render thread, rethrown by the next SubmitFramePacket
+    std::exception_ptr renderThreadError;
+    KonideRenderThreadStats renderThreadStats;
+
+    // Only touched by whichever thread runs FlushRender
+    KonideFramePacingStats pacingStats;
+    KonideCommandStats commandStats;
+    KonideFrameStats frameStats;
+
+    // Copies of the stats above as of the end of the last FlushRender, what the getters return.
+    // Resets are requested here and carried out at the start of the next FlushRender.
+    std::mutex statsMutex;
+    KonideFramePacingStats publishedPacingStats;
+    KonideCommandStats publishedCommandStats;
+    std::deque<KonideLatencySample> latencySamples;
+    bool bResetPacingStats = false;
+    bool bResetCommandStats = false;
+
+    // Vulkan calls made up to the end of the last FlushRender, gathered on every way out of it, skipped frames included
+    std::mutex vulkanCallMutex;
+    std::vector<KonideVulkanCallStats> lastFrameVulkanCalls;
+
+    // Created by the first StartVulkanCapture and kept, the tables may still hold it after a stop
+    std::unique_ptr<KonideTraceWriter> traceWriter;
 
-    VkSemaphore aquireSemaphore;
-    VkSemaphore submitSemaphore;
-    VkCommandPool cmdPool;
-    VkCommandBuffer cmdBuffer;
+    KonideJobSystem jobSystem;
+
+    // Backs every layer's command list, reset at the start of each recorded frame
+    KonideFrameArena commandArena;
+    std::vector<KonideLayer*> encodeLayers;
+
+    // 0 records layers inline on the frame's primary command buffer
+    uint32_t recordingThreads = 0;
+    KonideParallelRecorder layerRecorder;
+    std::vector<KonideLayer*> recordLayers;
+    std::vector<VkFormat> recordFormats;
+    std::vector<VkCommandBuffer> layerBuffers;
+    std::vector<VkCommandBuffer> outputBuffers;
+
+    // Rebuilt every frame from the acquired outputs and whatever passes their layers add
+    KonideFrameGraph frameGraph;
+
+    // Per frame scratch for presenting every output with one vkQueuePresentKHR
+    std::vector<KonideFrameOutput> frameOutputs;
+    std::vector<VkSwapchainKHR> presentSwapchains;
+    std::vector<uint32_t> presentImageIndices;
+    std::vector<VkSemaphore> presentWaitSemaphores;
+    std::vector<uint64_t> presentIds;
+    std::vector<VkResult> presentResults;
 
     KonideSwapchain swapchain;
 
     KonideQueueFamilyIndices queueFamilyIndices;
 
-    VkPhysicalDevice (*DelegatePickPhysDevice)(std::vector<VkPhysicalDevice> &PhysicalDevices) = &KonideRenderer::InternalPickPhysDevice;
+    // Null picks the first device with a graphics queue
+    VkPhysicalDevice (*DelegatePickPhysDevice)(std::vector<VkPhysicalDevice> &PhysicalDevices) = nullptr;
 
     uint32_t RenderFeatureFlags = 0;
 
-    static VkPhysicalDevice InternalPickPhysDevice(std::vector<VkPhysicalDevice> &PhysicalDevices);
-    static KonideQueueFamilyIndices InternalFindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface = 0);
+    EKonideAcquirePolicy acquirePolicy = KONIDE_ACQUIRE_BLOCKING;
+    uint64_t acquireTimeout = UINT64_MAX;
+
+    VkPresentModeKHR requestedPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+    uint32_t requestedImageCount = 0;
+
+    VkPhysicalDevice InternalPickPhysDevice(std::vector<VkPhysicalDevice> &PhysicalDevices);
+    KonideQueueFamilyIndices InternalFindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface = 0);
+    // A family that can present to every surface, preferred first if it can
+    std::optional<uint32_t> InternalFindPresentFamily(VkPhysicalDevice device, const std::vector<VkSurfaceKHR>& surfaces, std::optional<uint32_t> preferred);
+    bool InternalIsDeviceExtensionSupported(VkPhysicalDevice device, const char* name);
+    static VkPresentModeKHR InternalChoosePresentMode(const std::vector<VkPresentModeKHR>& available, VkPresentModeKHR requested);
 
     std::vector<const char*> InternalAssembleExtensions();
     std::vector<const char*> InternalAssembleLayers();
@@ -67,7 +299,35 @@ private:
 protected:
     std::vector<KonideLayer*> Composition;
 
-    void DestroySwapchain();
+    // Creates or rebuilds target from its surface, returns false while the surface has no usable size
+    bool BuildSwapchain(KonideSwapchain& target, uint32_t width, uint32_t height);
+    void DestroySwapchain(KonideSwapchain& target);
+
+    void CreateFrameSlots();
+    void DestroyFrameSlots();
+
+    void ProcessDeferredDeletions();
+
+    void CreatePresentSemaphores(KonideSwapchain& target);
+
+    void GatherFrameOutputs();
+
+    // Returns layer's recording for this slot and target, re-recorded if the layer or swapchain changed
+    VkCommandBuffer GetCachedLayerBuffer(KonideFrameSlot& frame, KonideLayer* layer, KonideSwapchain& target);
+    // Frees the cached recordings of layer on any output, or of any layer on target when layer is null
+    void EvictLayerCache(const KonideLayer* layer, const KonideSwapchain* target);
+
+    // Draws output's layers into target inside dynamic rendering, first recorded buffer of the output at firstRecorded
+    void RenderOutputLayers(VkCommandBuffer commandBuffer, KonideFrameSlot& frame, const KonideFrameOutput& output, uint32_t firstRecorded, KonideFrameGraphResource target);
+
+    void RecordFrameLatency(uint64_t presentedFrame, bool bPresentWait);
+    // Moves the table counters into lastFrameVulkanCalls and restarts them
+    void CollectVulkanCalls();
+    // Copies pacingStats and commandStats for the getters, called next to CollectVulkanCalls
+    void PublishFrameStats();
+
+    void RenderThreadMain();
+    bool IsOffRenderThread() const;
 
 public:
     KonideRenderer(uint32_t RenderFeatures);
@@ -78,6 +338,8 @@ public:
     template <class LayerType>
     uint32_t CreateLayer(std::string name = "Default");
     uint32_t AddLayer(KonideLayer* layer);
+    // Stops rendering layer on every output, the layer isn't deleted. Ids of layers added after it shift down by one.
+    void RemoveLayer(KonideLayer* layer);
 
     template <class LayerType>
     std::vector<KonideLayer*> GetLayersTyped();
@@ -85,27 +347,145 @@ public:
     KonideLayer* GetLayer(std::string name);
 
     VkInstance GetInstance() const { return instance; }
+    VkPhysicalDevice GetPhysicalDevice() const { return physDevice; }
+    VkDevice GetDevice() const { return device; }
+    // Filled by Initialize and CreateDevice, stays at the same address for the renderer's lifetime
+    const KonideInstanceTable& GetInstanceTable() const { return instanceTable; }
+    const KonideDeviceTable& GetDeviceTable() const { return deviceTable; }
+    // Entrypoint loading done by Initialize and CreateDevice
+    const KonideLoaderStats& GetLoaderStats() const { return loaderStats; }
 
     void SetPickPhysicalDeviceDelegate(VkPhysicalDevice (*NewDelegatePickPhysDevice)(std::vector<VkPhysicalDevice> &PhysicalDevices)) { DelegatePickPhysDevice = NewDelegatePickPhysDevice; }
 
     void SetSurface(VkSurfaceKHR newSurface) {swapchain.surface = newSurface;}
 
-    uint32_t CreateComposition(VkSurfaceKHR surface);
+    // Adds an output with its own swapchain on surface, the renderer takes ownership of the surface.
+    // Every composition is acquired, recorded and presented together with the renderer's own swapchain.
+    uint32_t CreateComposition(VkSurfaceKHR surface, uint32_t width, uint32_t height);
+    KonideComposition* GetComposition(uint32_t index) { return Compositions[index]; }
+    uint32_t GetCompositionCount() const { return (uint32_t)Compositions.size(); }
+    // Rebuilds the composition's swapchain before the next frame, safe to call from the application thread
+    void ResizeComposition(uint32_t index, uint32_t width, uint32_t height);
     
     void CreateDebugMessenger(PFN_vkDebugUtilsMessengerCallbackEXT callback, void* userData);
     void CreateDevice(std::vector<const char*> devExtensions = {}, std::vector<const char*> devLayers = {}); 
     void CreateSwapchain(uint32_t width, uint32_t height);
+    // Builds a new swapchain from the current one, the old images are retired through the deferred deletion queue.
+    // FlushRender does this on its own, before the next acquire, once the swapchain is out of date or suboptimal.
     void RecreateSwapchain(uint32_t width, uint32_t height);
 
-    void FlushRender();
+    // Work added here before FlushRender is submitted together with the frame, in the same vkQueueSubmit2 calls
+    KonideSubmitBatcher& GetSubmitBatcher() { return submitBatcher; }
+    VkQueue GetGraphicsQueue() const { return graphicsQueue; }
+    uint32_t GetGraphicsQueueFamily() const { return queueFamilyIndices.graphicsFamily.value(); }
+
+    // Runs destroy once all frames submitted so far have finished on the GPU
+    void DeferDestruction(std::function<void()> destroy);
+
+    // Frame clock: every frame submission signals GetFrameTimeline() with the next frame value.
+    // External submissions may wait on it to order themselves after "frame N complete".
+    VkSemaphore GetFrameTimeline() const { return frameTimeline; }
+    uint64_t GetSubmittedFrameValue() const { return frameNumber; }
+    uint64_t GetCompletedFrameValue();
+    void WaitForFrame(uint64_t value, uint64_t timeout = UINT64_MAX);
+
+    // Low latency mode keeps at most maxQueued frames between the CPU and the display and starts
+    // frame work just in time. Uses VK_KHR_present_wait when the device supports it, otherwise
+    // paces on GPU completion of the frame timeline.
+    void SetLowLatencyMode(bool bEnable, uint32_t maxQueued = 1);
+    bool IsLowLatencyMode() const { return bLowLatencyMode; }
+    bool IsPresentWaitSupported() const { return bPresentWaitSupported; }
+
+    // Blocks until the next frame may start, call right before sampling input.
+    // FlushRender calls it itself when the application did not.
+    void WaitForFrameLatency();
+
+    // Latency of the most recent frames, oldest first, capped at KONIDE_MAX_LATENCY_SAMPLES.
+    // Safe to query from any thread.
+    std::deque<KonideLatencySample> GetLatencySamples();
+    void ClearLatencySamples();
+
+    // Moves recording, submission and presentation to a dedicated thread. While it runs the
+    // application must not call FlushRender, it builds frame packets and submits them instead.
+    // maxPending packets may queue up, further submissions block until the render thread takes one.
+    void StartRenderThread(uint32_t maxPending = 1);
+    // Renders the packets still queued, then joins the thread
+    void StopRenderThread();
+    bool IsRenderThreadRunning() const { return renderThread.joinable(); }
+
+    // Records a state change into the packet being built, only call from the application thread
+    void EnqueueFrameUpdate(KonideLayer* layer, KonideProxy* proxy, std::function<void()> apply);
+    // Hands the built packet to the render thread without waiting for the GPU, blocking only while the queue is full.
+    // Without a render thread the packet is applied and rendered immediately.
+    // Rethrows an exception the render thread hit since the last call, the render thread has stopped by then.
+    void SubmitFramePacket();
+
+    KonideRenderThreadStats GetRenderThreadStats();
+    void ResetRenderThreadStats();
+
+    // Preferred present mode, falls back to the closest mode the surface supports (FIFO is always available).
+    // Takes effect on the next CreateSwapchain/RecreateSwapchain.
+    void SetPresentMode(VkPresentModeKHR mode) { requestedPresentMode = mode; }
+    VkPresentModeKHR GetPresentMode() const { return swapchain.presentMode; }
+
+    // Desired swapchain image count (e.g. 3 for triple buffering), clamped to the surface capabilities.
+    // 0 picks minImageCount + 1.
+    void SetSwapchainImageCount(uint32_t count) { requestedImageCount = count; }
+
+    // Number of frames the CPU may record ahead of the GPU, clamped to [1, KONIDE_MAX_FRAMES_IN_FLIGHT]
+    void SetFramesInFlight(uint32_t count);
+    uint32_t GetFramesInFlight() const { return framesInFlight; }
+
+    // As of the end of the last FlushRender, safe to query and reset from any thread
+    KonideFramePacingStats GetPacingStats();
+    void ResetPacingStats();
+
+    KonideCommandStats GetCommandStats();
+    void ResetCommandStats();
+
+    // Calls and time per entrypoint over the last frame, safe to query from any thread. Always empty unless konide
+    // is built with KONIDE_VULKAN_INSTRUMENTATION.
+    std::vector<KonideVulkanCallStats> GetVulkanCallStats();
+
+    // Writes every Vulkan call made through the renderer's tables to a trace at path, with a frame marker after each
+    // FlushRender, until StopVulkanCapture. Start it before Initialize to include device and resource creation, and
+    // only while no frame is being rendered. Returns false if path can't be written or konide is built without
+    // KONIDE_VULKAN_CAPTURE. Traces are replayed by konide_replay.
+    bool StartVulkanCapture(const char* path);
+    void StopVulkanCapture();
+    KonideTraceStats GetVulkanCaptureStats();
+
+    // Per phase timings of recent frames, safe to query from any thread
+    KonideFrameStats& GetFrameStats() { return frameStats; }
+    const KonideFrameStats& GetFrameStats() const { return frameStats; }
+
+    // Shared scheduler, started with the renderer and handed to every layer it creates
+    KonideJobSystem& GetJobSystem() { return jobSystem; }
+
+    // Memory behind the layers' command lists, blockAllocations stays flat once every frame fits
+    KonideFrameArenaStats GetCommandArenaStats() { return commandArena.GetStats(); }
+
+    // Graph of the last recorded frame, only valid on the thread running FlushRender
+    const KonideFrameGraph& GetFrameGraph() const { return frameGraph; }
+
+    // Records every layer into its own secondary command buffer, split into at most count job system
+    // ranges (the calling thread takes one), and executes them in layer order. 0 records inline on the primary.
+    void SetRecordingThreads(uint32_t count);
+    uint32_t GetRecordingThreads() const { return recordingThreads; }
+
+    // How FlushRender waits for a swapchain image, timeout (nanoseconds) only applies to KONIDE_ACQUIRE_BOUNDED_WAIT
+    void SetAcquirePolicy(EKonideAcquirePolicy policy, uint64_t timeout = 0);
+    EKonideAcquirePolicy GetAcquirePolicy() const { return acquirePolicy; }
+
+    // Records, submits and presents one frame. Returns false when no frame was produced,
+    // e.g. the acquire policy skipped it or the swapchain had to be recreated.
+    bool FlushRender();
 };
 
 template <class LayerType>
 inline uint32_t KonideRenderer::CreateLayer(std::string name)
 {
-    KonideLayer* layer = new LayerType();
-    Composition.push_back(layer);
-    return Composition.size()-1;
+    return AddLayer(new LayerType());
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef _KONIDE_SUBMIT_BATCHER_H
+#define _KONIDE_SUBMIT_BATCHER_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include "vulkan/vkloader_tables.h"
+
+#include <cstdint>
+#include <vector>
+
+// One VkSubmitInfo2: waits happen before the command buffers, signals after them
+struct KonideSubmitBatch {
+    std::vector<VkSemaphoreSubmitInfo> waits;
+    std::vector<VkCommandBufferSubmitInfo> commandBuffers;
+    std::vector<VkSemaphoreSubmitInfo> signals;
+
+    bool IsEmpty() const { return waits.empty() && commandBuffers.empty() && signals.empty(); }
+};
+
+struct KonideQueueSubmission {
+    VkQueue queue = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+    // Only the first batchCount batches are live, the rest keep their storage for the next frame
+    uint32_t batchCount = 0;
+    std::vector<KonideSubmitBatch> batches;
+};
+
+// Gathers every wait, command buffer and signal of a frame and submits them with one
+// vkQueueSubmit2 call per queue. Operations keep their order: a wait added after command
+// buffers, or a command buffer added after a signal, starts a new VkSubmitInfo2 in the same call.
+class KonideSubmitBatcher
+{
+protected:
+    std::vector<KonideQueueSubmission> submissions;
+    std::vector<VkSubmitInfo2> submitInfos;
+
+    uint32_t lastFlushSubmitCount = 0;
+    uint64_t totalSubmitCount = 0;
+
+    KonideQueueSubmission& GetSubmission(VkQueue queue);
+    KonideSubmitBatch& OpenBatch(KonideQueueSubmission& submission);
+public:
+    void AddWait(VkQueue queue, VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags2 stageMask);
+    void AddCommandBuffer(VkQueue queue, VkCommandBuffer commandBuffer);
+    void AddSignal(VkQueue queue, VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags2 stageMask);
+    void SetFence(VkQueue queue, VkFence fence);
+
+    // Submits everything gathered so far through deviceTable, returns the number of vkQueueSubmit2 calls made
+    uint32_t Flush(const KonideDeviceTable& deviceTable);
+    void Reset();
+
+    uint32_t GetLastFlushSubmitCount() const { return lastFlushSubmitCount; }
+    uint64_t GetTotalSubmitCount() const { return totalSubmitCount; }
+};
+
+#endif
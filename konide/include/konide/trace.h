@@ -0,0 +1,127 @@
+#ifndef _KONIDE_TRACE_H
+#define _KONIDE_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// "KTRC" read as a little-endian uint32_t
+#define KONIDE_TRACE_MAGIC 0x4352544bu
+#define KONIDE_TRACE_VERSION 2
+// Records are buffered up to this size before they're written out
+#define KONIDE_TRACE_BUFFER_SIZE (1024 * 1024)
+
+/* A trace is a KonideTraceFileHeader followed by records, each a KonideTraceRecordHeader and its payload.
+ * Entrypoints are named once by an entrypoint record before their first call, calls refer to them by the
+ * order those records appear in. Call payloads are encoded as described in vulkan/vkcapture.h.
+ */
+enum EKonideTraceRecord
+{
+    // Payload is the entrypoint's name
+    KONIDE_TRACE_RECORD_ENTRYPOINT = 0,
+    // Payload is the result and arguments of one call
+    KONIDE_TRACE_RECORD_CALL = 1,
+    // Marks the end of a frame, the payload is the frame's number as a uint64_t
+    KONIDE_TRACE_RECORD_FRAME = 2,
+    // Host writes to mapped memory, the payload is a KonideTraceMemoryHeader followed by the bytes. Written
+    // ahead of the call that made them visible to the device.
+    KONIDE_TRACE_RECORD_MEMORY = 3
+};
+
+struct KonideTraceFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    // Handles are captured as pointers, a trace only replays in a process of the same pointer size
+    uint32_t pointerSize;
+    uint32_t reserved;
+};
+
+struct KonideTraceMemoryHeader {
+    // The VkDeviceMemory as captured
+    uint64_t memory;
+    // Offset of the bytes into the allocation
+    uint64_t offset;
+};
+
+struct KonideTraceRecordHeader {
+    uint16_t type;
+    uint16_t entrypoint;
+    uint32_t size;
+    // Small ids given to threads in the order they first record
+    uint32_t thread;
+    uint32_t reserved;
+    // Nanoseconds since the capture started, calls are stamped when they were made
+    uint64_t timestamp;
+    // Nanoseconds spent in the call
+    uint64_t duration;
+};
+
+struct KonideTraceStats {
+    uint64_t calls = 0;
+    uint64_t frames = 0;
+    // Mapped memory contents written, included in bytes
+    uint64_t memoryBytes = 0;
+    uint64_t bytes = 0;
+};
+
+// Appends records to a trace file, safe to call from any thread. Everything is a no-op while no file is open.
+class KonideTraceWriter
+{
+protected:
+    std::mutex mutex;
+    FILE* file = nullptr;
+    std::vector<uint8_t> buffer;
+    std::unordered_map<const char*, uint16_t> entrypoints;
+    std::chrono::steady_clock::time_point start;
+    KonideTraceStats stats;
+
+    void WriteRecord(EKonideTraceRecord type, uint16_t entrypoint, uint64_t timestamp, uint64_t duration, const void* payload, uint32_t size, const void* extra = nullptr, uint32_t extraSize = 0);
+    void Flush();
+public:
+    KonideTraceWriter() = default;
+    KonideTraceWriter(const KonideTraceWriter&) = delete;
+    KonideTraceWriter& operator=(const KonideTraceWriter&) = delete;
+    ~KonideTraceWriter();
+
+    // Closes any open trace first, returns false if path can't be written
+    bool Open(const char* path);
+    void Close();
+    bool IsOpen();
+
+    // Nanoseconds since Open
+    uint64_t GetTime() const;
+
+    // entrypoint must stay valid while the trace is open, entrypoints are told apart by the pointer
+    void WriteCall(const char* entrypoint, uint64_t timestamp, uint64_t duration, const std::vector<uint8_t>& payload);
+    void WriteFrame(uint64_t frame);
+    void WriteMemory(uint64_t memory, uint64_t offset, const void* data, uint32_t size);
+
+    KonideTraceStats GetStats();
+};
+
+struct KonideTraceRecord {
+    KonideTraceRecordHeader header;
+    const uint8_t* payload;
+};
+
+// Loads a whole trace into memory, records point into it
+class KonideTraceReader
+{
+protected:
+    std::vector<uint8_t> data;
+    std::vector<std::string> entrypoints;
+    std::vector<KonideTraceRecord> records;
+public:
+    // Returns false if path can't be read or isn't a trace this build can replay, a cut off last record is dropped
+    bool Load(const char* path);
+
+    // Entrypoint records are consumed, only calls, frames and memory writes are left
+    const std::vector<KonideTraceRecord>& GetRecords() const { return records; }
+    const std::vector<std::string>& GetEntrypoints() const { return entrypoints; }
+};
+
+#endif
@@ -0,0 +1,568 @@
+#pragma once
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/* Argument encoding of captured calls. A call's payload is its return value followed by its arguments in
+ * order, each starting with an EKonideTraceArg tag:
+ *   VALUE    u8 size, then the bytes. Scalars, enums and handles.
+ *   NULL     a null pointer
+ *   STRING   u32 length, then the characters without terminator
+ *   ARRAY    u32 byte size of the rest, u32 element size, u32 count, the elements, then each element's nested arrays
+ *   BLOB     u32 size, then the bytes, e.g. push constant data
+ *   OPAQUE   a pointer whose contents aren't captured, e.g. allocation callbacks, or the result of a void call
+ * Pointer arguments are captured as arrays. The element count is taken from the integer argument right before
+ * the pointer, as in Vulkan's count and pointer pairs, or from what an output count pointer returned, or from
+ * the array right before for parallel arrays such as buffers and offsets. Otherwise it's 1. Arguments are
+ * encoded after the call returned, so outputs hold what the driver wrote. Pointers inside structs are only
+ * followed for the structs KonideCaptureNested knows, other pointers and pNext chains are left out.
+ */
+enum EKonideTraceArg
+{
+    KONIDE_TRACE_ARG_VALUE = 0,
+    KONIDE_TRACE_ARG_NULL = 1,
+    KONIDE_TRACE_ARG_STRING = 2,
+    KONIDE_TRACE_ARG_ARRAY = 3,
+    KONIDE_TRACE_ARG_BLOB = 4,
+    KONIDE_TRACE_ARG_OPAQUE = 5
+};
+
+// Longer arrays and blobs are cut short
+#define KONIDE_CAPTURE_MAX_ARRAY (64 * 1024)
+#define KONIDE_CAPTURE_MAX_BLOB (16 * 1024 * 1024)
+
+class KonideCaptureEncoder;
+class KonideCaptureDecoder;
+
+// Handles are pointers to types that are never defined
+template<typename T, typename = void>
+struct KonideCaptureIsComplete : std::false_type {};
+template<typename T>
+struct KonideCaptureIsComplete<T, decltype(void(sizeof(T)))> : std::true_type {};
+
+// Decoded structs never point at the capturing process' memory
+template<typename T>
+auto KonideCaptureClearNext(T& value, int) -> decltype(value.pNext = nullptr, void()) { value.pNext = nullptr; }
+template<typename T>
+void KonideCaptureClearNext(T&, long) {}
+
+// Arrays a struct points to, encoded after the struct's own bytes. Decode points the struct at the decoded copies.
+template<typename T>
+struct KonideCaptureNested {
+    static void Encode(KonideCaptureEncoder&, const T&) {}
+    static bool Decode(KonideCaptureDecoder&, T& value) { KonideCaptureClearNext(value, 0); return true; }
+};
+
+// Handles a create or allocate call returns for one info, e.g. command buffers allocated from one allocate info
+template<typename T>
+struct KonideCaptureCreateCount {
+    static uint64_t Get(const T&) { return 1; }
+};
+
+// Payload of the call being captured on this thread
+inline std::vector<uint8_t>& KonideCaptureScratch()
+{
+    static thread_local std::vector<uint8_t> scratch;
+    return scratch;
+}
+
+class KonideCaptureEncoder
+{
+protected:
+    std::vector<uint8_t>& data;
+
+    // What the previous argument says about the count of the next pointer, see above
+    uint64_t countArg = 0;
+    bool bCountArg = false;
+    uint64_t countOut = 0;
+    bool bCountOut = false;
+    uint64_t arrayCount = 0;
+    bool bArrayCount = false;
+
+    void Write(const void* bytes, size_t size)
+    {
+        const uint8_t* begin = (const uint8_t*)bytes;
+        data.insert(data.end(), begin, begin + size);
+    }
+
+    template<typename T>
+    void WritePod(const T& value) { Write(&value, sizeof(T)); }
+public:
+    KonideCaptureEncoder(std::vector<uint8_t>& newData) : data(newData) {}
+
+    template<typename T>
+    void EncodeValue(const T& value)
+    {
+        data.push_back(KONIDE_TRACE_ARG_VALUE);
+        data.push_back((uint8_t)sizeof(T));
+        WritePod(value);
+    }
+
+    void EncodeNull() { data.push_back(KONIDE_TRACE_ARG_NULL); }
+    void EncodeOpaque() { data.push_back(KONIDE_TRACE_ARG_OPAQUE); }
+
+    void EncodeString(const char* string)
+    {
+        if (!string) {
+            EncodeNull();
+            return;
+        }
+        uint32_t length = (uint32_t)strlen(string);
+        data.push_back(KONIDE_TRACE_ARG_STRING);
+        WritePod(length);
+        Write(string, length);
+    }
+
+    void EncodeBlob(const void* bytes, uint64_t size)
+    {
+        if (!bytes) {
+            EncodeNull();
+            return;
+        }
+        uint32_t blobSize = (uint32_t)(size < KONIDE_CAPTURE_MAX_BLOB ? size : KONIDE_CAPTURE_MAX_BLOB);
+        data.push_back(KONIDE_TRACE_ARG_BLOB);
+        WritePod(blobSize);
+        Write(bytes, blobSize);
+    }
+
+    template<typename T>
+    void EncodeArray(const T* items, uint64_t count)
+    {
+        if (!items) {
+            EncodeNull();
+            return;
+        }
+        uint32_t itemCount = (uint32_t)(count < KONIDE_CAPTURE_MAX_ARRAY ? count : KONIDE_CAPTURE_MAX_ARRAY);
+
+        data.push_back(KONIDE_TRACE_ARG_ARRAY);
+        size_t sizeOffset = data.size();
+        WritePod<uint32_t>(0);
+        WritePod<uint32_t>((uint32_t)sizeof(T));
+        WritePod(itemCount);
+        Write(items, sizeof(T) * itemCount);
+        for (uint32_t i = 0; i < itemCount; i++) {
+            KonideCaptureNested<T>::Encode(*this, items[i]);
+        }
+
+        uint32_t size = (uint32_t)(data.size() - sizeOffset - sizeof(uint32_t));
+        memcpy(&data[sizeOffset], &size, sizeof(size));
+    }
+
+    template<typename T>
+    void EncodeArg(T value)
+    {
+        uint64_t nextCountArg = 0;
+        bool bNextCountArg = false;
+        uint64_t nextCountOut = 0;
+        bool bNextCountOut = false;
+        uint64_t nextArrayCount = 0;
+        bool bNextArrayCount = false;
+
+        if constexpr (std::is_pointer<T>::value) {
+            typedef typename std::remove_pointer<T>::type Pointee;
+            typedef typename std::remove_cv<Pointee>::type Element;
+            constexpr bool bInput = std::is_const<Pointee>::value;
+
+            if constexpr (std::is_same<Element, char>::value) {
+                EncodeString(value);
+            } else if constexpr (std::is_void<Element>::value) {
+                if (bCountArg) {
+                    EncodeBlob(value, countArg);
+                } else if (value) {
+                    EncodeOpaque();
+                } else {
+                    EncodeNull();
+                }
+            } else if constexpr (std::is_same<Element, VkAllocationCallbacks>::value) {
+                if (value) EncodeOpaque(); else EncodeNull();
+                // Sits between create infos and the handles created from them
+                nextArrayCount = arrayCount;
+                bNextArrayCount = bArrayCount;
+            } else if constexpr (!KonideCaptureIsComplete<Element>::value) {
+                EncodeValue(value);
+            } else if constexpr (std::is_pointer<Element>::value && std::is_same<typename std::remove_cv<typename std::remove_pointer<Element>::type>::type, char>::value) {
+                // Layer and extension names
+                if (value) EncodeOpaque(); else EncodeNull();
+            } else {
+                uint64_t count = 1;
+                if (bInput && bCountArg) {
+                    count = countArg;
+                } else if (!bInput && bCountOut) {
+                    count = countOut;
+                } else if (bArrayCount) {
+                    count = arrayCount;
+                }
+
+                EncodeArray((const Element*)value, count);
+                if (value) {
+                    nextArrayCount = count;
+                    if constexpr (bInput) {
+                        if (count == 1) nextArrayCount = KonideCaptureCreateCount<Element>::Get(*value);
+                    }
+                    bNextArrayCount = true;
+                    if constexpr (!bInput && std::is_integral<Element>::value) {
+                        nextCountOut = (uint64_t)*value;
+                        bNextCountOut = true;
+                    }
+                }
+            }
+        } else {
+            EncodeValue(value);
+            // Non-dispatchable handles are 64-bit integers on 32-bit platforms, they're no counts
+            if constexpr (std::is_integral<T>::value && sizeof(T) <= sizeof(void*)) {
+                nextCountArg = (uint64_t)value;
+                bNextCountArg = true;
+            }
+        }
+
+        countArg = nextCountArg;
+        bCountArg = bNextCountArg;
+        countOut = nextCountOut;
+        bCountOut = bNextCountOut;
+        arrayCount = nextArrayCount;
+        bArrayCount = bNextArrayCount;
+    }
+
+    template<typename... Args>
+    void EncodeArgs(Args... args) { (EncodeArg(args), ...); }
+};
+
+// Reads one call's payload. Arrays are copied out and stay valid for the decoder's lifetime.
+class KonideCaptureDecoder
+{
+protected:
+    const uint8_t* data;
+    const uint8_t* end;
+    std::vector<std::unique_ptr<uint8_t[]>> storage;
+    bool bFailed = false;
+
+    bool Read(void* out, size_t size)
+    {
+        if (bFailed || (size_t)(end - data) < size) {
+            bFailed = true;
+            return false;
+        }
+        memcpy(out, data, size);
+        data += size;
+        return true;
+    }
+
+    bool ReadTag(EKonideTraceArg& tag)
+    {
+        uint8_t value = 0;
+        if (!Read(&value, 1)) {
+            return false;
+        }
+        tag = (EKonideTraceArg)value;
+        return true;
+    }
+
+    uint8_t* Allocate(size_t size)
+    {
+        storage.emplace_back(new uint8_t[size ? size : 1]);
+        return storage.back().get();
+    }
+
+    bool Fail()
+    {
+        bFailed = true;
+        return false;
+    }
+public:
+    KonideCaptureDecoder(const uint8_t* payload, uint32_t size) : data(payload), end(payload + size) {}
+
+    bool Failed() const { return bFailed; }
+    bool AtEnd() const { return data == end; }
+
+    // Steps over the next argument whatever it holds
+    bool Skip()
+    {
+        EKonideTraceArg tag;
+        if (!ReadTag(tag)) {
+            return false;
+        }
+
+        uint32_t size = 0;
+        switch (tag) {
+        case KONIDE_TRACE_ARG_VALUE: {
+            uint8_t valueSize = 0;
+            if (!Read(&valueSize, 1)) return false;
+            size = valueSize;
+            break;
+        }
+        case KONIDE_TRACE_ARG_STRING:
+        case KONIDE_TRACE_ARG_ARRAY:
+        case KONIDE_TRACE_ARG_BLOB:
+            if (!Read(&size, sizeof(size))) return false;
+            break;
+        case KONIDE_TRACE_ARG_NULL:
+        case KONIDE_TRACE_ARG_OPAQUE:
+            return true;
+        default:
+            return Fail();
+        }
+
+        if ((size_t)(end - data) < size) {
+            return Fail();
+        }
+        data += size;
+        return true;
+    }
+
+    template<typename T>
+    bool DecodeValue(T& value)
+    {
+        EKonideTraceArg tag;
+        uint8_t size = 0;
+        if (!ReadTag(tag) || tag != KONIDE_TRACE_ARG_VALUE || !Read(&size, 1) || size != sizeof(T)) {
+            return Fail();
+        }
+        return Read(&value, sizeof(T));
+    }
+
+    // Null and opaque pointers decode to null
+    bool DecodeString(const char*& string)
+    {
+        EKonideTraceArg tag;
+        if (!ReadTag(tag)) {
+            return false;
+        }
+        string = nullptr;
+        if (tag == KONIDE_TRACE_ARG_NULL || tag == KONIDE_TRACE_ARG_OPAQUE) {
+            return true;
+        }
+
+        uint32_t length = 0;
+        if (tag != KONIDE_TRACE_ARG_STRING || !Read(&length, sizeof(length))) {
+            return Fail();
+        }
+        char* copy = (char*)Allocate(length + 1);
+        if (!Read(copy, length)) {
+            return false;
+        }
+        copy[length] = '\0';
+        string = copy;
+        return true;
+    }
+
+    bool DecodeBlob(const void*& bytes, uint32_t& size)
+    {
+        EKonideTraceArg tag;
+        if (!ReadTag(tag)) {
+            return false;
+        }
+        bytes = nullptr;
+        size = 0;
+        if (tag == KONIDE_TRACE_ARG_NULL || tag == KONIDE_TRACE_ARG_OPAQUE) {
+            return true;
+        }
+
+        if (tag != KONIDE_TRACE_ARG_BLOB || !Read(&size, sizeof(size)) || (size_t)(end - data) < size) {
+            return Fail();
+        }
+        bytes = data;
+        data += size;
+        return true;
+    }
+
+    template<typename T>
+    bool DecodeArray(T*& items, uint32_t* count = nullptr)
+    {
+        typedef typename std::remove_const<T>::type Element;
+
+        EKonideTraceArg tag;
+        if (!ReadTag(tag)) {
+            return false;
+        }
+        items = nullptr;
+        if (count) *count = 0;
+        if (tag == KONIDE_TRACE_ARG_NULL || tag == KONIDE_TRACE_ARG_OPAQUE) {
+            return true;
+        }
+
+        uint32_t size = 0;
+        uint32_t elementSize = 0;
+        uint32_t itemCount = 0;
+        if (tag != KONIDE_TRACE_ARG_ARRAY || !Read(&size, sizeof(size)) || !Read(&elementSize, sizeof(elementSize)) ||
+            !Read(&itemCount, sizeof(itemCount)) || elementSize != sizeof(Element) || (size_t)(end - data) < (size_t)elementSize * itemCount) {
+            return Fail();
+        }
+
+        Element* copy = (Element*)Allocate(sizeof(Element) * itemCount);
+        Read(copy, sizeof(Element) * itemCount);
+        for (uint32_t i = 0; i < itemCount; i++) {
+            if (!KonideCaptureNested<Element>::Decode(*this, copy[i])) {
+                return Fail();
+            }
+        }
+
+        items = copy;
+        if (count) *count = itemCount;
+        return true;
+    }
+};
+
+#if defined(VK_VERSION_1_3)
+
+template<>
+struct KonideCaptureNested<VkRenderingInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkRenderingInfo& info)
+    {
+        encoder.EncodeArray(info.pColorAttachments, info.colorAttachmentCount);
+        encoder.EncodeArray(info.pDepthAttachment, 1);
+        encoder.EncodeArray(info.pStencilAttachment, 1);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkRenderingInfo& info)
+    {
+        info.pNext = nullptr;
+        return decoder.DecodeArray(info.pColorAttachments) && decoder.DecodeArray(info.pDepthAttachment) && decoder.DecodeArray(info.pStencilAttachment);
+    }
+};
+
+template<>
+struct KonideCaptureNested<VkDependencyInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkDependencyInfo& info)
+    {
+        encoder.EncodeArray(info.pMemoryBarriers, info.memoryBarrierCount);
+        encoder.EncodeArray(info.pBufferMemoryBarriers, info.bufferMemoryBarrierCount);
+        encoder.EncodeArray(info.pImageMemoryBarriers, info.imageMemoryBarrierCount);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkDependencyInfo& info)
+    {
+        info.pNext = nullptr;
+        return decoder.DecodeArray(info.pMemoryBarriers) && decoder.DecodeArray(info.pBufferMemoryBarriers) && decoder.DecodeArray(info.pImageMemoryBarriers);
+    }
+};
+
+template<>
+struct KonideCaptureNested<VkSubmitInfo2> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkSubmitInfo2& info)
+    {
+        encoder.EncodeArray(info.pWaitSemaphoreInfos, info.waitSemaphoreInfoCount);
+        encoder.EncodeArray(info.pCommandBufferInfos, info.commandBufferInfoCount);
+        encoder.EncodeArray(info.pSignalSemaphoreInfos, info.signalSemaphoreInfoCount);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkSubmitInfo2& info)
+    {
+        info.pNext = nullptr;
+        return decoder.DecodeArray(info.pWaitSemaphoreInfos) && decoder.DecodeArray(info.pCommandBufferInfos) && decoder.DecodeArray(info.pSignalSemaphoreInfos);
+    }
+};
+
+template<>
+struct KonideCaptureNested<VkCommandBufferInheritanceRenderingInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkCommandBufferInheritanceRenderingInfo& info)
+    {
+        encoder.EncodeArray(info.pColorAttachmentFormats, info.colorAttachmentCount);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkCommandBufferInheritanceRenderingInfo& info)
+    {
+        info.pNext = nullptr;
+        return decoder.DecodeArray(info.pColorAttachmentFormats);
+    }
+};
+
+// Secondaries recorded inside dynamic rendering carry their attachment formats in the pNext chain
+template<>
+struct KonideCaptureNested<VkCommandBufferInheritanceInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkCommandBufferInheritanceInfo& info)
+    {
+        const VkCommandBufferInheritanceRenderingInfo* rendering = nullptr;
+        for (const VkBaseInStructure* next = (const VkBaseInStructure*)info.pNext; next; next = next->pNext) {
+            if (next->sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO) {
+                rendering = (const VkCommandBufferInheritanceRenderingInfo*)next;
+                break;
+            }
+        }
+        encoder.EncodeArray(rendering, 1);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkCommandBufferInheritanceInfo& info)
+    {
+        const VkCommandBufferInheritanceRenderingInfo* rendering = nullptr;
+        if (!decoder.DecodeArray(rendering)) {
+            return false;
+        }
+        info.pNext = rendering;
+        return true;
+    }
+};
+
+template<>
+struct KonideCaptureNested<VkCommandBufferBeginInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkCommandBufferBeginInfo& info)
+    {
+        encoder.EncodeArray(info.pInheritanceInfo, 1);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkCommandBufferBeginInfo& info)
+    {
+        info.pNext = nullptr;
+        return decoder.DecodeArray(info.pInheritanceInfo);
+    }
+};
+
+template<>
+struct KonideCaptureCreateCount<VkCommandBufferAllocateInfo> {
+    static uint64_t Get(const VkCommandBufferAllocateInfo& info) { return info.commandBufferCount; }
+};
+
+template<>
+struct KonideCaptureCreateCount<VkDescriptorSetAllocateInfo> {
+    static uint64_t Get(const VkDescriptorSetAllocateInfo& info) { return info.descriptorSetCount; }
+};
+
+// Timeline semaphores carry their type in the pNext chain
+template<>
+struct KonideCaptureNested<VkSemaphoreCreateInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkSemaphoreCreateInfo& info)
+    {
+        const VkSemaphoreTypeCreateInfo* type = nullptr;
+        for (const VkBaseInStructure* next = (const VkBaseInStructure*)info.pNext; next; next = next->pNext) {
+            if (next->sType == VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO) {
+                type = (const VkSemaphoreTypeCreateInfo*)next;
+                break;
+            }
+        }
+        encoder.EncodeArray(type, 1);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkSemaphoreCreateInfo& info)
+    {
+        const VkSemaphoreTypeCreateInfo* type = nullptr;
+        if (!decoder.DecodeArray(type)) {
+            return false;
+        }
+        info.pNext = type;
+        return true;
+    }
+};
+
+template<>
+struct KonideCaptureNested<VkSemaphoreWaitInfo> {
+    static void Encode(KonideCaptureEncoder& encoder, const VkSemaphoreWaitInfo& info)
+    {
+        encoder.EncodeArray(info.pSemaphores, info.semaphoreCount);
+        encoder.EncodeArray(info.pValues, info.semaphoreCount);
+    }
+
+    static bool Decode(KonideCaptureDecoder& decoder, VkSemaphoreWaitInfo& info)
+    {
+        info.pNext = nullptr;
+        return decoder.DecodeArray(info.pSemaphores) && decoder.DecodeArray(info.pValues);
+    }
+};
+
+#endif
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#ifdef KONIDE_VULKAN_CAPTURE
+#   include "vkcapture.h"
+#   include "../trace.h"
+#
+#   include <algorithm>
+#   include <cstring>
+#   include <mutex>
+#   include <tuple>
+#   include <unordered_map>
+#endif
+
+// Calls one entrypoint received over a frame and the time spent inside it, including any blocking in the driver
+struct KonideVulkanCallStats {
+    const char* name;
+    uint64_t calls;
+    double seconds;
+};
+
+/* With KONIDE_VULKAN_INSTRUMENTATION defined every entrypoint in the instance and device tables is wrapped
+ * in a counter and a timer, calls through the tables keep their syntax. With KONIDE_VULKAN_CAPTURE defined
+ * the same wrappers can write every call to a trace, see vkcapture.h. Without either the tables hold plain
+ * function pointers and none of this is compiled in. The defines change the table layout, so they must be
+ * the same for konide and everything including its headers.
+ */
+#if defined(KONIDE_VULKAN_INSTRUMENTATION) || defined(KONIDE_VULKAN_CAPTURE)
+
+class KonideCallCounter
+{
+protected:
+    const char* name;
+    mutable std::atomic<uint64_t> calls;
+    mutable std::atomic<uint64_t> nanoseconds;
+
+    struct Timer {
+        const KonideCallCounter& counter;
+        std::chrono::steady_clock::time_point start;
+
+        Timer(const KonideCallCounter& newCounter) : counter(newCounter), start(std::chrono::steady_clock::now()) {}
+        ~Timer()
+        {
+            uint64_t elapsed = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            counter.calls.fetch_add(1, std::memory_order_relaxed);
+            counter.nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        }
+    };
+public:
+    KonideCallCounter(const char* newName) : name(newName), calls(0), nanoseconds(0) {}
+    KonideCallCounter(const KonideCallCounter&) = delete;
+    KonideCallCounter& operator=(const KonideCallCounter&) = delete;
+
+    // Appends the counts if there were any calls and starts counting from zero again
+    void Collect(std::vector<KonideVulkanCallStats>& out)
+    {
+        uint64_t callCount = calls.exchange(0, std::memory_order_relaxed);
+        uint64_t time = nanoseconds.exchange(0, std::memory_order_relaxed);
+        if (callCount) {
+            out.push_back({ name, callCount, (double)time / 1e9 });
+        }
+    }
+};
+
+#ifdef KONIDE_VULKAN_CAPTURE
+
+// Entrypoints the capture has to look into besides encoding their arguments
+enum EKonideCaptureHook
+{
+    KONIDE_CAPTURE_HOOK_NONE = 0,
+    KONIDE_CAPTURE_HOOK_ALLOCATE_MEMORY,
+    KONIDE_CAPTURE_HOOK_FREE_MEMORY,
+    KONIDE_CAPTURE_HOOK_MAP_MEMORY,
+    KONIDE_CAPTURE_HOOK_UNMAP_MEMORY,
+    // Host writes to mapped memory become visible to the device here
+    KONIDE_CAPTURE_HOOK_SYNC_MEMORY
+};
+
+inline EKonideCaptureHook KonideCaptureFindHook(const char* name)
+{
+    if (strcmp(name, "vkAllocateMemory") == 0) return KONIDE_CAPTURE_HOOK_ALLOCATE_MEMORY;
+    if (strcmp(name, "vkFreeMemory") == 0) return KONIDE_CAPTURE_HOOK_FREE_MEMORY;
+    if (strcmp(name, "vkMapMemory") == 0) return KONIDE_CAPTURE_HOOK_MAP_MEMORY;
+    if (strcmp(name, "vkUnmapMemory") == 0) return KONIDE_CAPTURE_HOOK_UNMAP_MEMORY;
+    if (strcmp(name, "vkQueueSubmit") == 0 || strcmp(name, "vkQueueSubmit2") == 0 || strcmp(name, "vkFlushMappedMemoryRanges") == 0) {
+        return KONIDE_CAPTURE_HOOK_SYNC_MEMORY;
+    }
+    return KONIDE_CAPTURE_HOOK_NONE;
+}
+
+/* Host writes into mapped memory never pass through an entrypoint. Every mapping keeps a shadow copy of
+ * what the trace already holds, at each submit, flush and unmap the mapping is compared against it and the
+ * ranges that changed are written as memory records ahead of the call. Allocations and mappings are tracked
+ * even while nothing is captured, a capture starting later writes mapped memory in full on its first sync.
+ */
+class KonideCaptureMemoryTracker
+{
+protected:
+    // Compared and written in blocks of this many bytes
+    static const size_t BlockSize = 256;
+
+    struct Mapping {
+        const uint8_t* data = nullptr;
+        // Offset of data into the allocation
+        uint64_t offset = 0;
+        std::vector<uint8_t> shadow;
+        // Written in full on the next sync, the trace holds none of it yet
+        bool bFull = true;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<uint64_t, uint64_t> allocationSizes;
+    std::unordered_map<uint64_t, Mapping> mappings;
+
+    template<typename T>
+    static uint64_t Key(T handle)
+    {
+        if constexpr (std::is_pointer<T>::value) {
+            return (uint64_t)(uintptr_t)handle;
+        } else {
+            return (uint64_t)handle;
+        }
+    }
+
+    void Sync(KonideTraceWriter& writer, uint64_t memory, Mapping& mapping)
+    {
+        size_t size = mapping.shadow.size();
+        size_t runStart = SIZE_MAX;
+        // Runs one block past the end so a run reaching it is written too
+        for (size_t block = 0; block < size + BlockSize; block += BlockSize) {
+            size_t blockEnd = std::min(block + BlockSize, size);
+            bool bDirty = block < size && (mapping.bFull || memcmp(mapping.data + block, mapping.shadow.data() + block, blockEnd - block) != 0);
+
+            if (bDirty && runStart == SIZE_MAX) {
+                runStart = block;
+            } else if (!bDirty && runStart != SIZE_MAX) {
+                size_t runSize = std::min(block, size) - runStart;
+                memcpy(mapping.shadow.data() + runStart, mapping.data + runStart, runSize);
+                writer.WriteMemory(memory, mapping.offset + runStart, mapping.shadow.data() + runStart, (uint32_t)runSize);
+                runStart = SIZE_MAX;
+            }
+        }
+        mapping.bFull = false;
+    }
+public:
+    void Allocate(VkDeviceMemory memory, uint64_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        allocationSizes[Key(memory)] = size;
+    }
+
+    void Free(VkDeviceMemory memory)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        allocationSizes.erase(Key(memory));
+        mappings.erase(Key(memory));
+    }
+
+    // Mappings of memory allocated before the tables were loaded can't be sized and stay untracked
+    void Map(VkDeviceMemory memory, uint64_t offset, uint64_t size, const void* data)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto allocation = allocationSizes.find(Key(memory));
+        if (size == VK_WHOLE_SIZE) {
+            if (allocation == allocationSizes.end() || allocation->second < offset) {
+                return;
+            }
+            size = allocation->second - offset;
+        }
+
+        Mapping& mapping = mappings[Key(memory)];
+        mapping.data = (const uint8_t*)data;
+        mapping.offset = offset;
+        mapping.shadow.assign(mapping.data, mapping.data + size);
+        mapping.bFull = true;
+    }
+
+    void Unmap(KonideTraceWriter* writer, VkDeviceMemory memory)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = mappings.find(Key(memory));
+        if (found == mappings.end()) {
+            return;
+        }
+        if (writer) {
+            Sync(*writer, found->first, found->second);
+        }
+        mappings.erase(found);
+    }
+
+    // Writes what changed in every mapping since the last sync
+    void SyncAll(KonideTraceWriter& writer)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& mapping : mappings) {
+            Sync(writer, mapping.first, mapping.second);
+        }
+    }
+
+    // The next sync writes every mapping in full, for a trace that just started
+    void MarkAllDirty()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& mapping : mappings) {
+            mapping.second.bFull = true;
+        }
+    }
+
+    // Runs before the call, args are the hooked entrypoint's. The signature checks keep every other
+    // instantiation a no-op.
+    template<typename... Args>
+    void Before(EKonideCaptureHook hook, KonideTraceWriter* writer, Args... args)
+    {
+        if (hook == KONIDE_CAPTURE_HOOK_SYNC_MEMORY && writer) {
+            SyncAll(*writer);
+        }
+        if constexpr (std::is_same<std::tuple<Args...>, std::tuple<VkDevice, VkDeviceMemory>>::value) {
+            if (hook == KONIDE_CAPTURE_HOOK_UNMAP_MEMORY) {
+                Unmap(writer, std::get<1>(std::make_tuple(args...)));
+            }
+        }
+    }
+
+    // Runs after the call returned result
+    template<typename R, typename... Args>
+    void After(EKonideCaptureHook hook, R result, Args... args)
+    {
+        if constexpr (std::is_same<std::tuple<Args...>, std::tuple<VkDevice, const VkMemoryAllocateInfo*, const VkAllocationCallbacks*, VkDeviceMemory*>>::value) {
+            auto arguments = std::make_tuple(args...);
+            if (hook == KONIDE_CAPTURE_HOOK_ALLOCATE_MEMORY && result == VK_SUCCESS) {
+                Allocate(*std::get<3>(arguments), std::get<1>(arguments)->allocationSize);
+            }
+        } else if constexpr (std::is_same<std::tuple<Args...>, std::tuple<VkDevice, VkDeviceMemory, const VkAllocationCallbacks*>>::value) {
+            if (hook == KONIDE_CAPTURE_HOOK_FREE_MEMORY) {
+                Free(std::get<1>(std::make_tuple(args...)));
+            }
+        } else if constexpr (std::is_same<std::tuple<Args...>, std::tuple<VkDevice, VkDeviceMemory, VkDeviceSize, VkDeviceSize, VkMemoryMapFlags, void**>>::value) {
+            auto arguments = std::make_tuple(args...);
+            if (hook == KONIDE_CAPTURE_HOOK_MAP_MEMORY && result == VK_SUCCESS) {
+                Map(std::get<1>(arguments), std::get<2>(arguments), std::get<3>(arguments), *std::get<5>(arguments));
+            }
+        }
+    }
+};
+
+#endif
+
+// Counters of one table, entries register themselves when the table is constructed
+struct KonideCallRegistry {
+    std::vector<KonideCallCounter*> counters;
+#ifdef KONIDE_VULKAN_CAPTURE
+    // Calls through the table are written here while it's set
+    std::atomic<KonideTraceWriter*> traceWriter{ nullptr };
+    KonideCaptureMemoryTracker memory;
+#endif
+
+    KonideCallRegistry() = default;
+    KonideCallRegistry(const KonideCallRegistry&) = delete;
+    KonideCallRegistry& operator=(const KonideCallRegistry&) = delete;
+
+    void Collect(std::vector<KonideVulkanCallStats>& out)
+    {
+        for (KonideCallCounter* counter : counters) {
+            counter->Collect(out);
+        }
+    }
+};
+
+template<typename PFN>
+class KonideInstrumentedCall;
+
+template<typename R, typename... Args>
+class KonideInstrumentedCall<R (VKAPI_PTR*)(Args...)> : public KonideCallCounter
+{
+public:
+    typedef R (VKAPI_PTR* Function)(Args...);
+protected:
+    Function function = nullptr;
+#ifdef KONIDE_VULKAN_CAPTURE
+    KonideCallRegistry& registry;
+    EKonideCaptureHook hook;
+
+    R Capture(KonideTraceWriter& writer, Args... args) const
+    {
+        if (hook != KONIDE_CAPTURE_HOOK_NONE) {
+            registry.memory.Before(hook, &writer, args...);
+        }
+
+        std::vector<uint8_t>& payload = KonideCaptureScratch();
+        payload.clear();
+        KonideCaptureEncoder encoder(payload);
+
+        uint64_t start = writer.GetTime();
+        if constexpr (std::is_void<R>::value) {
+            function(args...);
+            uint64_t duration = writer.GetTime() - start;
+            if (hook != KONIDE_CAPTURE_HOOK_NONE) {
+                registry.memory.After(hook, VK_SUCCESS, args...);
+            }
+            encoder.EncodeOpaque();
+            encoder.EncodeArgs(args...);
+            writer.WriteCall(name, start, duration, payload);
+        } else {
+            R result = function(args...);
+            uint64_t duration = writer.GetTime() - start;
+            if (hook != KONIDE_CAPTURE_HOOK_NONE) {
+                registry.memory.After(hook, result, args...);
+            }
+            encoder.EncodeValue(result);
+            encoder.EncodeArgs(args...);
+            writer.WriteCall(name, start, duration, payload);
+            return result;
+        }
+    }
+
+    // Keeps the memory tracker current while nothing is captured
+    R Track(Args... args) const
+    {
+        registry.memory.Before(hook, nullptr, args...);
+        if constexpr (std::is_void<R>::value) {
+            function(args...);
+            registry.memory.After(hook, VK_SUCCESS, args...);
+        } else {
+            R result = function(args...);
+            registry.memory.After(hook, result, args...);
+            return result;
+        }
+    }
+#endif
+public:
+#ifdef KONIDE_VULKAN_CAPTURE
+    KonideInstrumentedCall(const char* newName, KonideCallRegistry& newRegistry) : KonideCallCounter(newName), registry(newRegistry), hook(KonideCaptureFindHook(newName)) { newRegistry.counters.push_back(this); }
+#else
+    KonideInstrumentedCall(const char* newName, KonideCallRegistry& registry) : KonideCallCounter(newName) { registry.counters.push_back(this); }
+#endif
+
+    KonideInstrumentedCall& operator=(Function newFunction) { function = newFunction; return *this; }
+    // Calls made through the raw pointer aren't counted or captured
+    operator Function() const { return function; }
+
+    R operator()(Args... args) const
+    {
+#ifdef KONIDE_VULKAN_INSTRUMENTATION
+        // Includes the capture's own cost while capturing
+        Timer timer(*this);
+#endif
+#ifdef KONIDE_VULKAN_CAPTURE
+        KonideTraceWriter* writer = registry.traceWriter.load(std::memory_order_acquire);
+        if (writer) {
+            return Capture(*writer, args...);
+        }
+        if (hook != KONIDE_CAPTURE_HOOK_NONE) {
+            return Track(args...);
+        }
+#endif
+        return function(args...);
+    }
+};
+
+#   define KONIDE_VK_ENTRY(name) KonideInstrumentedCall<PFN_##name> name{ #name, callRegistry }
+
+#else
+
+#   define KONIDE_VK_ENTRY(name) PFN_##name name
+
+#endif
@@ -0,0 +1,1046 @@
+#pragma once
+
+#ifdef _WIN32
+#   define VK_USE_PLATFORM_WIN32_KHR 1
+#endif
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+#		include <vulkan/vk_platform.h>
+#		include <vulkan/vulkan_core.h>
+
+		/* When VK_USE_PLATFORM_WIN32_KHR is defined, instead of including vulkan.h directly, we include individual parts of the SDK
+		 * This is necessary to avoid including <windows.h> which is very heavy - it takes 200ms to parse without WIN32_LEAN_AND_MEAN
+		 * and 100ms to parse with it. vulkan_win32.h only needs a few symbols that are easy to redefine ourselves.
+		 */
+		typedef unsigned long DWORD;
+		typedef const wchar_t* LPCWSTR;
+		typedef void* HANDLE;
+		typedef struct HINSTANCE__* HINSTANCE;
+		typedef struct HINSTANCE__* HMODULE;
+		typedef struct HWND__* HWND;
+		typedef struct HMONITOR__* HMONITOR;
+		typedef struct _SECURITY_ATTRIBUTES SECURITY_ATTRIBUTES;
+
+#		include <vulkan/vulkan_win32.h>
+
+#		ifdef VK_ENABLE_BETA_EXTENSIONS
+#			include <vulkan/vulkan_beta.h>
+#		endif
+#	else
+#		include <vulkan/vulkan.h>
+#	endif
+
+#include "vkinstrumentation.h"
+
+#include <string>
+#include <vector>
+
+/* Function pointers resolved for one VkInstance / VkDevice. Device tables are filled through vkGetDeviceProcAddr,
+ * so calls go straight to the driver without the loader trampolines, and every device gets its own table.
+ * Only core entrypoints up to the requested API version and those of enabled extensions are loaded, the rest stay
+ * null until looked up with Resolve, e.g. entrypoints of an extension a layer enables.
+ * The tables are all the loader keeps per instance and device, each renderer owns its own pair.
+ */
+struct KonideInstanceTable {
+    VkInstance instance;
+    PFN_vkGetInstanceProcAddr getProcAddr;
+    // What the instance was created with, device loads start from it
+    uint32_t apiVersion;
+    std::vector<std::string> extensions;
+
+    PFN_vkVoidFunction Resolve(const char* name) const { return getProcAddr ? getProcAddr(instance, name) : nullptr; }
+
+#if defined(KONIDE_VULKAN_INSTRUMENTATION) || defined(KONIDE_VULKAN_CAPTURE)
+    KonideCallRegistry callRegistry;
+#endif
+
+#if defined(VK_VERSION_1_0)
+    KONIDE_VK_ENTRY(vkCreateDevice);
+    KONIDE_VK_ENTRY(vkDestroyInstance);
+    KONIDE_VK_ENTRY(vkEnumerateDeviceExtensionProperties);
+    KONIDE_VK_ENTRY(vkEnumerateDeviceLayerProperties);
+    KONIDE_VK_ENTRY(vkEnumeratePhysicalDevices);
+    KONIDE_VK_ENTRY(vkGetDeviceProcAddr);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFeatures);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFormatProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceImageFormatProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceMemoryProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceQueueFamilyProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSparseImageFormatProperties);
+#endif /* defined(VK_VERSION_1_0) */
+#if defined(VK_VERSION_1_1)
+    KONIDE_VK_ENTRY(vkEnumeratePhysicalDeviceGroups);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalBufferProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalFenceProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalSemaphoreProperties);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFeatures2);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFormatProperties2);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceImageFormatProperties2);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceMemoryProperties2);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceProperties2);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceQueueFamilyProperties2);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSparseImageFormatProperties2);
+#endif /* defined(VK_VERSION_1_1) */
+#if defined(VK_VERSION_1_3)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceToolProperties);
+#endif /* defined(VK_VERSION_1_3) */
+#if defined(VK_EXT_acquire_drm_display)
+    KONIDE_VK_ENTRY(vkAcquireDrmDisplayEXT);
+    KONIDE_VK_ENTRY(vkGetDrmDisplayEXT);
+#endif /* defined(VK_EXT_acquire_drm_display) */
+#if defined(VK_EXT_acquire_xlib_display)
+    KONIDE_VK_ENTRY(vkAcquireXlibDisplayEXT);
+    KONIDE_VK_ENTRY(vkGetRandROutputDisplayEXT);
+#endif /* defined(VK_EXT_acquire_xlib_display) */
+#if defined(VK_EXT_calibrated_timestamps)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceCalibrateableTimeDomainsEXT);
+#endif /* defined(VK_EXT_calibrated_timestamps) */
+#if defined(VK_EXT_debug_report)
+    KONIDE_VK_ENTRY(vkCreateDebugReportCallbackEXT);
+    KONIDE_VK_ENTRY(vkDebugReportMessageEXT);
+    KONIDE_VK_ENTRY(vkDestroyDebugReportCallbackEXT);
+#endif /* defined(VK_EXT_debug_report) */
+#if defined(VK_EXT_debug_utils)
+    KONIDE_VK_ENTRY(vkCmdBeginDebugUtilsLabelEXT);
+    KONIDE_VK_ENTRY(vkCmdEndDebugUtilsLabelEXT);
+    KONIDE_VK_ENTRY(vkCmdInsertDebugUtilsLabelEXT);
+    KONIDE_VK_ENTRY(vkCreateDebugUtilsMessengerEXT);
+    KONIDE_VK_ENTRY(vkDestroyDebugUtilsMessengerEXT);
+    KONIDE_VK_ENTRY(vkQueueBeginDebugUtilsLabelEXT);
+    KONIDE_VK_ENTRY(vkQueueEndDebugUtilsLabelEXT);
+    KONIDE_VK_ENTRY(vkQueueInsertDebugUtilsLabelEXT);
+    KONIDE_VK_ENTRY(vkSetDebugUtilsObjectNameEXT);
+    KONIDE_VK_ENTRY(vkSetDebugUtilsObjectTagEXT);
+    KONIDE_VK_ENTRY(vkSubmitDebugUtilsMessageEXT);
+#endif /* defined(VK_EXT_debug_utils) */
+#if defined(VK_EXT_direct_mode_display)
+    KONIDE_VK_ENTRY(vkReleaseDisplayEXT);
+#endif /* defined(VK_EXT_direct_mode_display) */
+#if defined(VK_EXT_directfb_surface)
+    KONIDE_VK_ENTRY(vkCreateDirectFBSurfaceEXT);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceDirectFBPresentationSupportEXT);
+#endif /* defined(VK_EXT_directfb_surface) */
+#if defined(VK_EXT_display_surface_counter)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfaceCapabilities2EXT);
+#endif /* defined(VK_EXT_display_surface_counter) */
+#if defined(VK_EXT_full_screen_exclusive)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfacePresentModes2EXT);
+#endif /* defined(VK_EXT_full_screen_exclusive) */
+#if defined(VK_EXT_headless_surface)
+    KONIDE_VK_ENTRY(vkCreateHeadlessSurfaceEXT);
+#endif /* defined(VK_EXT_headless_surface) */
+#if defined(VK_EXT_metal_surface)
+    KONIDE_VK_ENTRY(vkCreateMetalSurfaceEXT);
+#endif /* defined(VK_EXT_metal_surface) */
+#if defined(VK_EXT_sample_locations)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceMultisamplePropertiesEXT);
+#endif /* defined(VK_EXT_sample_locations) */
+#if defined(VK_EXT_tooling_info)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceToolPropertiesEXT);
+#endif /* defined(VK_EXT_tooling_info) */
+#if defined(VK_FUCHSIA_imagepipe_surface)
+    KONIDE_VK_ENTRY(vkCreateImagePipeSurfaceFUCHSIA);
+#endif /* defined(VK_FUCHSIA_imagepipe_surface) */
+#if defined(VK_GGP_stream_descriptor_surface)
+    KONIDE_VK_ENTRY(vkCreateStreamDescriptorSurfaceGGP);
+#endif /* defined(VK_GGP_stream_descriptor_surface) */
+#if defined(VK_KHR_android_surface)
+    KONIDE_VK_ENTRY(vkCreateAndroidSurfaceKHR);
+#endif /* defined(VK_KHR_android_surface) */
+#if defined(VK_KHR_device_group_creation)
+    KONIDE_VK_ENTRY(vkEnumeratePhysicalDeviceGroupsKHR);
+#endif /* defined(VK_KHR_device_group_creation) */
+#if defined(VK_KHR_display)
+    KONIDE_VK_ENTRY(vkCreateDisplayModeKHR);
+    KONIDE_VK_ENTRY(vkCreateDisplayPlaneSurfaceKHR);
+    KONIDE_VK_ENTRY(vkGetDisplayModePropertiesKHR);
+    KONIDE_VK_ENTRY(vkGetDisplayPlaneCapabilitiesKHR);
+    KONIDE_VK_ENTRY(vkGetDisplayPlaneSupportedDisplaysKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceDisplayPlanePropertiesKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceDisplayPropertiesKHR);
+#endif /* defined(VK_KHR_display) */
+#if defined(VK_KHR_external_fence_capabilities)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalFencePropertiesKHR);
+#endif /* defined(VK_KHR_external_fence_capabilities) */
+#if defined(VK_KHR_external_memory_capabilities)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalBufferPropertiesKHR);
+#endif /* defined(VK_KHR_external_memory_capabilities) */
+#if defined(VK_KHR_external_semaphore_capabilities)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalSemaphorePropertiesKHR);
+#endif /* defined(VK_KHR_external_semaphore_capabilities) */
+#if defined(VK_KHR_fragment_shading_rate)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFragmentShadingRatesKHR);
+#endif /* defined(VK_KHR_fragment_shading_rate) */
+#if defined(VK_KHR_get_display_properties2)
+    KONIDE_VK_ENTRY(vkGetDisplayModeProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetDisplayPlaneCapabilities2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceDisplayPlaneProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceDisplayProperties2KHR);
+#endif /* defined(VK_KHR_get_display_properties2) */
+#if defined(VK_KHR_get_physical_device_properties2)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFeatures2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceFormatProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceImageFormatProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceMemoryProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceQueueFamilyProperties2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSparseImageFormatProperties2KHR);
+#endif /* defined(VK_KHR_get_physical_device_properties2) */
+#if defined(VK_KHR_get_surface_capabilities2)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfaceCapabilities2KHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfaceFormats2KHR);
+#endif /* defined(VK_KHR_get_surface_capabilities2) */
+#if defined(VK_KHR_performance_query)
+    KONIDE_VK_ENTRY(vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR);
+#endif /* defined(VK_KHR_performance_query) */
+#if defined(VK_KHR_surface)
+    KONIDE_VK_ENTRY(vkDestroySurfaceKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfaceCapabilitiesKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfaceFormatsKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfacePresentModesKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSurfaceSupportKHR);
+#endif /* defined(VK_KHR_surface) */
+#if defined(VK_KHR_video_queue)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceVideoCapabilitiesKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceVideoFormatPropertiesKHR);
+#endif /* defined(VK_KHR_video_queue) */
+#if defined(VK_KHR_wayland_surface)
+    KONIDE_VK_ENTRY(vkCreateWaylandSurfaceKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceWaylandPresentationSupportKHR);
+#endif /* defined(VK_KHR_wayland_surface) */
+#if defined(VK_KHR_win32_surface)
+    KONIDE_VK_ENTRY(vkCreateWin32SurfaceKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceWin32PresentationSupportKHR);
+#endif /* defined(VK_KHR_win32_surface) */
+#if defined(VK_KHR_xcb_surface)
+    KONIDE_VK_ENTRY(vkCreateXcbSurfaceKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceXcbPresentationSupportKHR);
+#endif /* defined(VK_KHR_xcb_surface) */
+#if defined(VK_KHR_xlib_surface)
+    KONIDE_VK_ENTRY(vkCreateXlibSurfaceKHR);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceXlibPresentationSupportKHR);
+#endif /* defined(VK_KHR_xlib_surface) */
+#if defined(VK_MVK_ios_surface)
+    KONIDE_VK_ENTRY(vkCreateIOSSurfaceMVK);
+#endif /* defined(VK_MVK_ios_surface) */
+#if defined(VK_MVK_macos_surface)
+    KONIDE_VK_ENTRY(vkCreateMacOSSurfaceMVK);
+#endif /* defined(VK_MVK_macos_surface) */
+#if defined(VK_NN_vi_surface)
+    KONIDE_VK_ENTRY(vkCreateViSurfaceNN);
+#endif /* defined(VK_NN_vi_surface) */
+#if defined(VK_NV_acquire_winrt_display)
+    KONIDE_VK_ENTRY(vkAcquireWinrtDisplayNV);
+    KONIDE_VK_ENTRY(vkGetWinrtDisplayNV);
+#endif /* defined(VK_NV_acquire_winrt_display) */
+#if defined(VK_NV_cooperative_matrix)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceCooperativeMatrixPropertiesNV);
+#endif /* defined(VK_NV_cooperative_matrix) */
+#if defined(VK_NV_coverage_reduction_mode)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV);
+#endif /* defined(VK_NV_coverage_reduction_mode) */
+#if defined(VK_NV_external_memory_capabilities)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceExternalImageFormatPropertiesNV);
+#endif /* defined(VK_NV_external_memory_capabilities) */
+#if defined(VK_NV_optical_flow)
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceOpticalFlowImageFormatsNV);
+#endif /* defined(VK_NV_optical_flow) */
+#if defined(VK_QNX_screen_surface)
+    KONIDE_VK_ENTRY(vkCreateScreenSurfaceQNX);
+    KONIDE_VK_ENTRY(vkGetPhysicalDeviceScreenPresentationSupportQNX);
+#endif /* defined(VK_QNX_screen_surface) */
+#if (defined(VK_KHR_device_group) && defined(VK_KHR_surface)) || (defined(VK_KHR_swapchain) && defined(VK_VERSION_1_1))
+    KONIDE_VK_ENTRY(vkGetPhysicalDevicePresentRectanglesKHR);
+#endif /* (defined(VK_KHR_device_group) && defined(VK_KHR_surface)) || (defined(VK_KHR_swapchain) && defined(VK_VERSION_1_1)) */
+};
+
+struct KonideDeviceTable {
+    VkDevice device;
+    PFN_vkGetDeviceProcAddr getProcAddr;
+
+    PFN_vkVoidFunction Resolve(const char* name) const { return getProcAddr ? getProcAddr(device, name) : nullptr; }
+
+#if defined(KONIDE_VULKAN_INSTRUMENTATION) || defined(KONIDE_VULKAN_CAPTURE)
+    KonideCallRegistry callRegistry;
+#endif
+
+#if defined(VK_VERSION_1_0)
+    KONIDE_VK_ENTRY(vkAllocateCommandBuffers);
+    KONIDE_VK_ENTRY(vkAllocateDescriptorSets);
+    KONIDE_VK_ENTRY(vkAllocateMemory);
+    KONIDE_VK_ENTRY(vkBeginCommandBuffer);
+    KONIDE_VK_ENTRY(vkBindBufferMemory);
+    KONIDE_VK_ENTRY(vkBindImageMemory);
+    KONIDE_VK_ENTRY(vkCmdBeginQuery);
+    KONIDE_VK_ENTRY(vkCmdBeginRenderPass);
+    KONIDE_VK_ENTRY(vkCmdBindDescriptorSets);
+    KONIDE_VK_ENTRY(vkCmdBindIndexBuffer);
+    KONIDE_VK_ENTRY(vkCmdBindPipeline);
+    KONIDE_VK_ENTRY(vkCmdBindVertexBuffers);
+    KONIDE_VK_ENTRY(vkCmdBlitImage);
+    KONIDE_VK_ENTRY(vkCmdClearAttachments);
+    KONIDE_VK_ENTRY(vkCmdClearColorImage);
+    KONIDE_VK_ENTRY(vkCmdClearDepthStencilImage);
+    KONIDE_VK_ENTRY(vkCmdCopyBuffer);
+    KONIDE_VK_ENTRY(vkCmdCopyBufferToImage);
+    KONIDE_VK_ENTRY(vkCmdCopyImage);
+    KONIDE_VK_ENTRY(vkCmdCopyImageToBuffer);
+    KONIDE_VK_ENTRY(vkCmdCopyQueryPoolResults);
+    KONIDE_VK_ENTRY(vkCmdDispatch);
+    KONIDE_VK_ENTRY(vkCmdDispatchIndirect);
+    KONIDE_VK_ENTRY(vkCmdDraw);
+    KONIDE_VK_ENTRY(vkCmdDrawIndexed);
+    KONIDE_VK_ENTRY(vkCmdDrawIndexedIndirect);
+    KONIDE_VK_ENTRY(vkCmdDrawIndirect);
+    KONIDE_VK_ENTRY(vkCmdEndQuery);
+    KONIDE_VK_ENTRY(vkCmdEndRenderPass);
+    KONIDE_VK_ENTRY(vkCmdExecuteCommands);
+    KONIDE_VK_ENTRY(vkCmdFillBuffer);
+    KONIDE_VK_ENTRY(vkCmdNextSubpass);
+    KONIDE_VK_ENTRY(vkCmdPipelineBarrier);
+    KONIDE_VK_ENTRY(vkCmdPushConstants);
+    KONIDE_VK_ENTRY(vkCmdResetEvent);
+    KONIDE_VK_ENTRY(vkCmdResetQueryPool);
+    KONIDE_VK_ENTRY(vkCmdResolveImage);
+    KONIDE_VK_ENTRY(vkCmdSetBlendConstants);
+    KONIDE_VK_ENTRY(vkCmdSetDepthBias);
+    KONIDE_VK_ENTRY(vkCmdSetDepthBounds);
+    KONIDE_VK_ENTRY(vkCmdSetEvent);
+    KONIDE_VK_ENTRY(vkCmdSetLineWidth);
+    KONIDE_VK_ENTRY(vkCmdSetScissor);
+    KONIDE_VK_ENTRY(vkCmdSetStencilCompareMask);
+    KONIDE_VK_ENTRY(vkCmdSetStencilReference);
+    KONIDE_VK_ENTRY(vkCmdSetStencilWriteMask);
+    KONIDE_VK_ENTRY(vkCmdSetViewport);
+    KONIDE_VK_ENTRY(vkCmdUpdateBuffer);
+    KONIDE_VK_ENTRY(vkCmdWaitEvents);
+    KONIDE_VK_ENTRY(vkCmdWriteTimestamp);
+    KONIDE_VK_ENTRY(vkCreateBuffer);
+    KONIDE_VK_ENTRY(vkCreateBufferView);
+    KONIDE_VK_ENTRY(vkCreateCommandPool);
+    KONIDE_VK_ENTRY(vkCreateComputePipelines);
+    KONIDE_VK_ENTRY(vkCreateDescriptorPool);
+    KONIDE_VK_ENTRY(vkCreateDescriptorSetLayout);
+    KONIDE_VK_ENTRY(vkCreateEvent);
+    KONIDE_VK_ENTRY(vkCreateFence);
+    KONIDE_VK_ENTRY(vkCreateFramebuffer);
+    KONIDE_VK_ENTRY(vkCreateGraphicsPipelines);
+    KONIDE_VK_ENTRY(vkCreateImage);
+    KONIDE_VK_ENTRY(vkCreateImageView);
+    KONIDE_VK_ENTRY(vkCreatePipelineCache);
+    KONIDE_VK_ENTRY(vkCreatePipelineLayout);
+    KONIDE_VK_ENTRY(vkCreateQueryPool);
+    KONIDE_VK_ENTRY(vkCreateRenderPass);
+    KONIDE_VK_ENTRY(vkCreateSampler);
+    KONIDE_VK_ENTRY(vkCreateSemaphore);
+    KONIDE_VK_ENTRY(vkCreateShaderModule);
+    KONIDE_VK_ENTRY(vkDestroyBuffer);
+    KONIDE_VK_ENTRY(vkDestroyBufferView);
+    KONIDE_VK_ENTRY(vkDestroyCommandPool);
+    KONIDE_VK_ENTRY(vkDestroyDescriptorPool);
+    KONIDE_VK_ENTRY(vkDestroyDescriptorSetLayout);
+    KONIDE_VK_ENTRY(vkDestroyDevice);
+    KONIDE_VK_ENTRY(vkDestroyEvent);
+    KONIDE_VK_ENTRY(vkDestroyFence);
+    KONIDE_VK_ENTRY(vkDestroyFramebuffer);
+    KONIDE_VK_ENTRY(vkDestroyImage);
+    KONIDE_VK_ENTRY(vkDestroyImageView);
+    KONIDE_VK_ENTRY(vkDestroyPipeline);
+    KONIDE_VK_ENTRY(vkDestroyPipelineCache);
+    KONIDE_VK_ENTRY(vkDestroyPipelineLayout);
+    KONIDE_VK_ENTRY(vkDestroyQueryPool);
+    KONIDE_VK_ENTRY(vkDestroyRenderPass);
+    KONIDE_VK_ENTRY(vkDestroySampler);
+    KONIDE_VK_ENTRY(vkDestroySemaphore);
+    KONIDE_VK_ENTRY(vkDestroyShaderModule);
+    KONIDE_VK_ENTRY(vkDeviceWaitIdle);
+    KONIDE_VK_ENTRY(vkEndCommandBuffer);
+    KONIDE_VK_ENTRY(vkFlushMappedMemoryRanges);
+    KONIDE_VK_ENTRY(vkFreeCommandBuffers);
+    KONIDE_VK_ENTRY(vkFreeDescriptorSets);
+    KONIDE_VK_ENTRY(vkFreeMemory);
+    KONIDE_VK_ENTRY(vkGetBufferMemoryRequirements);
+    KONIDE_VK_ENTRY(vkGetDeviceMemoryCommitment);
+    KONIDE_VK_ENTRY(vkGetDeviceQueue);
+    KONIDE_VK_ENTRY(vkGetEventStatus);
+    KONIDE_VK_ENTRY(vkGetFenceStatus);
+    KONIDE_VK_ENTRY(vkGetImageMemoryRequirements);
+    KONIDE_VK_ENTRY(vkGetImageSparseMemoryRequirements);
+    KONIDE_VK_ENTRY(vkGetImageSubresourceLayout);
+    KONIDE_VK_ENTRY(vkGetPipelineCacheData);
+    KONIDE_VK_ENTRY(vkGetQueryPoolResults);
+    KONIDE_VK_ENTRY(vkGetRenderAreaGranularity);
+    KONIDE_VK_ENTRY(vkInvalidateMappedMemoryRanges);
+    KONIDE_VK_ENTRY(vkMapMemory);
+    KONIDE_VK_ENTRY(vkMergePipelineCaches);
+    KONIDE_VK_ENTRY(vkQueueBindSparse);
+    KONIDE_VK_ENTRY(vkQueueSubmit);
+    KONIDE_VK_ENTRY(vkQueueWaitIdle);
+    KONIDE_VK_ENTRY(vkResetCommandBuffer);
+    KONIDE_VK_ENTRY(vkResetCommandPool);
+    KONIDE_VK_ENTRY(vkResetDescriptorPool);
+    KONIDE_VK_ENTRY(vkResetEvent);
+    KONIDE_VK_ENTRY(vkResetFences);
+    KONIDE_VK_ENTRY(vkSetEvent);
+    KONIDE_VK_ENTRY(vkUnmapMemory);
+    KONIDE_VK_ENTRY(vkUpdateDescriptorSets);
+    KONIDE_VK_ENTRY(vkWaitForFences);
+#endif /* defined(VK_VERSION_1_0) */
+#if defined(VK_VERSION_1_1)
+    KONIDE_VK_ENTRY(vkBindBufferMemory2);
+    KONIDE_VK_ENTRY(vkBindImageMemory2);
+    KONIDE_VK_ENTRY(vkCmdDispatchBase);
+    KONIDE_VK_ENTRY(vkCmdSetDeviceMask);
+    KONIDE_VK_ENTRY(vkCreateDescriptorUpdateTemplate);
+    KONIDE_VK_ENTRY(vkCreateSamplerYcbcrConversion);
+    KONIDE_VK_ENTRY(vkDestroyDescriptorUpdateTemplate);
+    KONIDE_VK_ENTRY(vkDestroySamplerYcbcrConversion);
+    KONIDE_VK_ENTRY(vkGetBufferMemoryRequirements2);
+    KONIDE_VK_ENTRY(vkGetDescriptorSetLayoutSupport);
+    KONIDE_VK_ENTRY(vkGetDeviceGroupPeerMemoryFeatures);
+    KONIDE_VK_ENTRY(vkGetDeviceQueue2);
+    KONIDE_VK_ENTRY(vkGetImageMemoryRequirements2);
+    KONIDE_VK_ENTRY(vkGetImageSparseMemoryRequirements2);
+    KONIDE_VK_ENTRY(vkTrimCommandPool);
+    KONIDE_VK_ENTRY(vkUpdateDescriptorSetWithTemplate);
+#endif /* defined(VK_VERSION_1_1) */
+#if defined(VK_VERSION_1_2)
+    KONIDE_VK_ENTRY(vkCmdBeginRenderPass2);
+    KONIDE_VK_ENTRY(vkCmdDrawIndexedIndirectCount);
+    KONIDE_VK_ENTRY(vkCmdDrawIndirectCount);
+    KONIDE_VK_ENTRY(vkCmdEndRenderPass2);
+    KONIDE_VK_ENTRY(vkCmdNextSubpass2);
+    KONIDE_VK_ENTRY(vkCreateRenderPass2);
+    KONIDE_VK_ENTRY(vkGetBufferDeviceAddress);
+    KONIDE_VK_ENTRY(vkGetBufferOpaqueCaptureAddress);
+    KONIDE_VK_ENTRY(vkGetDeviceMemoryOpaqueCaptureAddress);
+    KONIDE_VK_ENTRY(vkGetSemaphoreCounterValue);
+    KONIDE_VK_ENTRY(vkResetQueryPool);
+    KONIDE_VK_ENTRY(vkSignalSemaphore);
+    KONIDE_VK_ENTRY(vkWaitSemaphores);
+#endif /* defined(VK_VERSION_1_2) */
+#if defined(VK_VERSION_1_3)
+    KONIDE_VK_ENTRY(vkCmdBeginRendering);
+    KONIDE_VK_ENTRY(vkCmdBindVertexBuffers2);
+    KONIDE_VK_ENTRY(vkCmdBlitImage2);
+    KONIDE_VK_ENTRY(vkCmdCopyBuffer2);
+    KONIDE_VK_ENTRY(vkCmdCopyBufferToImage2);
+    KONIDE_VK_ENTRY(vkCmdCopyImage2);
+    KONIDE_VK_ENTRY(vkCmdCopyImageToBuffer2);
+    KONIDE_VK_ENTRY(vkCmdEndRendering);
+    KONIDE_VK_ENTRY(vkCmdPipelineBarrier2);
+    KONIDE_VK_ENTRY(vkCmdResetEvent2);
+    KONIDE_VK_ENTRY(vkCmdResolveImage2);
+    KONIDE_VK_ENTRY(vkCmdSetCullMode);
+    KONIDE_VK_ENTRY(vkCmdSetDepthBiasEnable);
+    KONIDE_VK_ENTRY(vkCmdSetDepthBoundsTestEnable);
+    KONIDE_VK_ENTRY(vkCmdSetDepthCompareOp);
+    KONIDE_VK_ENTRY(vkCmdSetDepthTestEnable);
+    KONIDE_VK_ENTRY(vkCmdSetDepthWriteEnable);
+    KONIDE_VK_ENTRY(vkCmdSetEvent2);
+    KONIDE_VK_ENTRY(vkCmdSetFrontFace);
+    KONIDE_VK_ENTRY(vkCmdSetPrimitiveRestartEnable);
+    KONIDE_VK_ENTRY(vkCmdSetPrimitiveTopology);
+    KONIDE_VK_ENTRY(vkCmdSetRasterizerDiscardEnable);
+    KONIDE_VK_ENTRY(vkCmdSetScissorWithCount);
+    KONIDE_VK_ENTRY(vkCmdSetStencilOp);
+    KONIDE_VK_ENTRY(vkCmdSetStencilTestEnable);
+    KONIDE_VK_ENTRY(vkCmdSetViewportWithCount);
+    KONIDE_VK_ENTRY(vkCmdWaitEvents2);
+    KONIDE_VK_ENTRY(vkCmdWriteTimestamp2);
+    KONIDE_VK_ENTRY(vkCreatePrivateDataSlot);
+    KONIDE_VK_ENTRY(vkDestroyPrivateDataSlot);
+    KONIDE_VK_ENTRY(vkGetDeviceBufferMemoryRequirements);
+    KONIDE_VK_ENTRY(vkGetDeviceImageMemoryRequirements);
+    KONIDE_VK_ENTRY(vkGetDeviceImageSparseMemoryRequirements);
+    KONIDE_VK_ENTRY(vkGetPrivateData);
+    KONIDE_VK_ENTRY(vkQueueSubmit2);
+    KONIDE_VK_ENTRY(vkSetPrivateData);
+#endif /* defined(VK_VERSION_1_3) */
+#if defined(VK_AMDX_shader_enqueue)
+    KONIDE_VK_ENTRY(vkCmdDispatchGraphAMDX);
+    KONIDE_VK_ENTRY(vkCmdDispatchGraphIndirectAMDX);
+    KONIDE_VK_ENTRY(vkCmdDispatchGraphIndirectCountAMDX);
+    KONIDE_VK_ENTRY(vkCmdInitializeGraphScratchMemoryAMDX);
+    KONIDE_VK_ENTRY(vkCreateExecutionGraphPipelinesAMDX);
+    KONIDE_VK_ENTRY(vkGetExecutionGraphPipelineNodeIndexAMDX);
+    KONIDE_VK_ENTRY(vkGetExecutionGraphPipelineScratchSizeAMDX);
+#endif /* defined(VK_AMDX_shader_enqueue) */
+#if defined(VK_AMD_buffer_marker)
+    KONIDE_VK_ENTRY(vkCmdWriteBufferMarkerAMD);
+#endif /* defined(VK_AMD_buffer_marker) */
+#if defined(VK_AMD_display_native_hdr)
+    KONIDE_VK_ENTRY(vkSetLocalDimmingAMD);
+#endif /* defined(VK_AMD_display_native_hdr) */
+#if defined(VK_AMD_draw_indirect_count)
+    KONIDE_VK_ENTRY(vkCmdDrawIndexedIndirectCountAMD);
+    KONIDE_VK_ENTRY(vkCmdDrawIndirectCountAMD);
+#endif /* defined(VK_AMD_draw_indirect_count) */
+#if defined(VK_AMD_shader_info)
+    KONIDE_VK_ENTRY(vkGetShaderInfoAMD);
+#endif /* defined(VK_AMD_shader_info) */
+#if defined(VK_ANDROID_external_memory_android_hardware_buffer)
+    KONIDE_VK_ENTRY(vkGetAndroidHardwareBufferPropertiesANDROID);
+    KONIDE_VK_ENTRY(vkGetMemoryAndroidHardwareBufferANDROID);
+#endif /* defined(VK_ANDROID_external_memory_android_hardware_buffer) */
+#if defined(VK_EXT_buffer_device_address)
+    KONIDE_VK_ENTRY(vkGetBufferDeviceAddressEXT);
+#endif /* defined(VK_EXT_buffer_device_address) */
+#if defined(VK_EXT_calibrated_timestamps)
+    KONIDE_VK_ENTRY(vkGetCalibratedTimestampsEXT);
+#endif /* defined(VK_EXT_calibrated_timestamps) */
+#if defined(VK_EXT_color_write_enable)
+    KONIDE_VK_ENTRY(vkCmdSetColorWriteEnableEXT);
+#endif /* defined(VK_EXT_color_write_enable) */
+#if defined(VK_EXT_conditional_rendering)
+    KONIDE_VK_ENTRY(vkCmdBeginConditionalRenderingEXT);
+    KONIDE_VK_ENTRY(vkCmdEndConditionalRenderingEXT);
+#endif /* defined(VK_EXT_conditional_rendering) */
+#if defined(VK_EXT_debug_marker)
+    KONIDE_VK_ENTRY(vkCmdDebugMarkerBeginEXT);
+    KONIDE_VK_ENTRY(vkCmdDebugMarkerEndEXT);
+    KONIDE_VK_ENTRY(vkCmdDebugMarkerInsertEXT);
+    KONIDE_VK_ENTRY(vkDebugMarkerSetObjectNameEXT);
+    KONIDE_VK_ENTRY(vkDebugMarkerSetObjectTagEXT);
+#endif /* defined(VK_EXT_debug_marker) */
+#if defined(VK_EXT_descriptor_buffer)
+    KONIDE_VK_ENTRY(vkCmdBindDescriptorBufferEmbeddedSamplersEXT);
+    KONIDE_VK_ENTRY(vkCmdBindDescriptorBuffersEXT);
+    KONIDE_VK_ENTRY(vkCmdSetDescriptorBufferOffsetsEXT);
+    KONIDE_VK_ENTRY(vkGetBufferOpaqueCaptureDescriptorDataEXT);
+    KONIDE_VK_ENTRY(vkGetDescriptorEXT);
+    KONIDE_VK_ENTRY(vkGetDescriptorSetLayoutBindingOffsetEXT);
+    KONIDE_VK_ENTRY(vkGetDescriptorSetLayoutSizeEXT);
+    KONIDE_VK_ENTRY(vkGetImageOpaqueCaptureDescriptorDataEXT);
+    KONIDE_VK_ENTRY(vkGetImageViewOpaqueCaptureDescriptorDataEXT);
+    KONIDE_VK_ENTRY(vkGetSamplerOpaqueCaptureDescriptorDataEXT);
+#endif /* defined(VK_EXT_descriptor_buffer) */
+#if defined(VK_EXT_descriptor_buffer) && (defined(VK_KHR_acceleration_structure) || defined(VK_NV_ray_tracing))
+    KONIDE_VK_ENTRY(vkGetAccelerationStructureOpaqueCaptureDescriptorDataEXT);
+#endif /* defined(VK_EXT_descriptor_buffer) && (defined(VK_KHR_acceleration_structure) || defined(VK_NV_ray_tracing)) */
+#if defined(VK_EXT_device_fault)
+    KONIDE_VK_ENTRY(vkGetDeviceFaultInfoEXT);
+#endif /* defined(VK_EXT_device_fault) */
+#if defined(VK_EXT_discard_rectangles)
+    KONIDE_VK_ENTRY(vkCmdSetDiscardRectangleEXT);
+#endif /* defined(VK_EXT_discard_rectangles) */
+#if defined(VK_EXT_display_control)
+    KONIDE_VK_ENTRY(vkDisplayPowerControlEXT);
+    KONIDE_VK_ENTRY(vkGetSwapchainCounterEXT);
+    KONIDE_VK_ENTRY(vkRegisterDeviceEventEXT);
+    KONIDE_VK_ENTRY(vkRegisterDisplayEventEXT);
+#endif /* defined(VK_EXT_display_control) */
+#if defined(VK_EXT_external_memory_host)
+    KONIDE_VK_ENTRY(vkGetMemoryHostPointerPropertiesEXT);
+#endif /* defined(VK_EXT_external_memory_host) */
+#if defined(VK_EXT_full_screen_exclusive)
+    KONIDE_VK_ENTRY(vkAcquireFullScreenExclusiveModeEXT);
+    KONIDE_VK_ENTRY(vkReleaseFullScreenExclusiveModeEXT);
+#endif /* defined(VK_EXT_full_screen_exclusive) */
+#if defined(VK_EXT_hdr_metadata)
+    KONIDE_VK_ENTRY(vkSetHdrMetadataEXT);
+#endif /* defined(VK_EXT_hdr_metadata) */
+#if defined(VK_EXT_host_query_reset)
+    KONIDE_VK_ENTRY(vkResetQueryPoolEXT);
+#endif /* defined(VK_EXT_host_query_reset) */
+#if defined(VK_EXT_image_drm_format_modifier)
+    KONIDE_VK_ENTRY(vkGetImageDrmFormatModifierPropertiesEXT);
+#endif /* defined(VK_EXT_image_drm_format_modifier) */
+#if defined(VK_EXT_line_rasterization)
+    KONIDE_VK_ENTRY(vkCmdSetLineStippleEXT);
+#endif /* defined(VK_EXT_line_rasterization) */
+#if defined(VK_EXT_mesh_shader)
+    KONIDE_VK_ENTRY(vkCmdDrawMeshTasksEXT);
+    KONIDE_VK_ENTRY(vkCmdDrawMeshTasksIndirectCountEXT);
+    KONIDE_VK_ENTRY(vkCmdDrawMeshTasksIndirectEXT);
+#endif /* defined(VK_EXT_mesh_shader) */
+#if defined(VK_EXT_metal_objects)
+    KONIDE_VK_ENTRY(vkExportMetalObjectsEXT);
+#endif /* defined(VK_EXT_metal_objects) */
+#if defined(VK_EXT_multi_draw)
+    KONIDE_VK_ENTRY(vkCmdDrawMultiEXT);
+    KONIDE_VK_ENTRY(vkCmdDrawMultiIndexedEXT);
+#endif /* defined(VK_EXT_multi_draw) */
+#if defined(VK_EXT_opacity_micromap)
+    KONIDE_VK_ENTRY(vkBuildMicromapsEXT);
+    KONIDE_VK_ENTRY(vkCmdBuildMicromapsEXT);
+    KONIDE_VK_ENTRY(vkCmdCopyMemoryToMicromapEXT);
+    KONIDE_VK_ENTRY(vkCmdCopyMicromapEXT);
+    KONIDE_VK_ENTRY(vkCmdCopyMicromapToMemoryEXT);
+    KONIDE_VK_ENTRY(vkCmdWriteMicromapsPropertiesEXT);
+    KONIDE_VK_ENTRY(vkCopyMemoryToMicromapEXT);
+    KONIDE_VK_ENTRY(vkCopyMicromapEXT);
+    KONIDE_VK_ENTRY(vkCopyMicromapToMemoryEXT);
+    KONIDE_VK_ENTRY(vkCreateMicromapEXT);
+    KONIDE_VK_ENTRY(vkDestroyMicromapEXT);
+    KONIDE_VK_ENTRY(vkGetDeviceMicromapCompatibilityEXT);
+    KONIDE_VK_ENTRY(vkGetMicromapBuildSizesEXT);
+    KONIDE_VK_ENTRY(vkWriteMicromapsPropertiesEXT);
+#endif /* defined(VK_EXT_opacity_micromap) */
+#if defined(VK_EXT_pageable_device_local_memory)
+    KONIDE_VK_ENTRY(vkSetDeviceMemoryPriorityEXT);
+#endif /* defined(VK_EXT_pageable_device_local_memory) */
+#if defined(VK_EXT_pipeline_properties)
+    KONIDE_VK_ENTRY(vkGetPipelinePropertiesEXT);
+#endif /* defined(VK_EXT_pipeline_properties) */
+#if defined(VK_EXT_private_data)
+    KONIDE_VK_ENTRY(vkCreatePrivateDataSlotEXT);
+    KONIDE_VK_ENTRY(vkDestroyPrivateDataSlotEXT);
+    KONIDE_VK_ENTRY(vkGetPrivateDataEXT);
+    KONIDE_VK_ENTRY(vkSetPrivateDataEXT);
+#endif /* defined(VK_EXT_private_data) */
+#if defined(VK_EXT_sample_locations)
+    KONIDE_VK_ENTRY(vkCmdSetSampleLocationsEXT);
+#endif /* defined(VK_EXT_sample_locations) */
+#if defined(VK_EXT_shader_module_identifier)
+    KONIDE_VK_ENTRY(vkGetShaderModuleCreateInfoIdentifierEXT);
+    KONIDE_VK_ENTRY(vkGetShaderModuleIdentifierEXT);
+#endif /* defined(VK_EXT_shader_module_identifier) */
+#if defined(VK_EXT_swapchain_maintenance1)
+    KONIDE_VK_ENTRY(vkReleaseSwapchainImagesEXT);
+#endif /* defined(VK_EXT_swapchain_maintenance1) */
+#if defined(VK_EXT_transform_feedback)
+    KONIDE_VK_ENTRY(vkCmdBeginQueryIndexedEXT);
+    KONIDE_VK_ENTRY(vkCmdBeginTransformFeedbackEXT);
+    KONIDE_VK_ENTRY(vkCmdBindTransformFeedbackBuffersEXT);
+    KONIDE_VK_ENTRY(vkCmdDrawIndirectByteCountEXT);
+    KONIDE_VK_ENTRY(vkCmdEndQueryIndexedEXT);
+    KONIDE_VK_ENTRY(vkCmdEndTransformFeedbackEXT);
+#endif /* defined(VK_EXT_transform_feedback) */
+#if defined(VK_EXT_validation_cache)
+    KONIDE_VK_ENTRY(vkCreateValidationCacheEXT);
+    KONIDE_VK_ENTRY(vkDestroyValidationCacheEXT);
+    KONIDE_VK_ENTRY(vkGetValidationCacheDataEXT);
+    KONIDE_VK_ENTRY(vkMergeValidationCachesEXT);
+#endif /* defined(VK_EXT_validation_cache) */
+#if defined(VK_FUCHSIA_buffer_collection)
+    KONIDE_VK_ENTRY(vkCreateBufferCollectionFUCHSIA);
+    KONIDE_VK_ENTRY(vkDestroyBufferCollectionFUCHSIA);
+    KONIDE_VK_ENTRY(vkGetBufferCollectionPropertiesFUCHSIA);
+    KONIDE_VK_ENTRY(vkSetBufferCollectionBufferConstraintsFUCHSIA);
+    KONIDE_VK_ENTRY(vkSetBufferCollectionImageConstraintsFUCHSIA);
+#endif /* defined(VK_FUCHSIA_buffer_collection) */
+#if defined(VK_FUCHSIA_external_memory)
+    KONIDE_VK_ENTRY(vkGetMemoryZirconHandleFUCHSIA);
+    KONIDE_VK_ENTRY(vkGetMemoryZirconHandlePropertiesFUCHSIA);
+#endif /* defined(VK_FUCHSIA_external_memory) */
+#if defined(VK_FUCHSIA_external_semaphore)
+    KONIDE_VK_ENTRY(vkGetSemaphoreZirconHandleFUCHSIA);
+    KONIDE_VK_ENTRY(vkImportSemaphoreZirconHandleFUCHSIA);
+#endif /* defined(VK_FUCHSIA_external_semaphore) */
+#if defined(VK_GOOGLE_display_timing)
+    KONIDE_VK_ENTRY(vkGetPastPresentationTimingGOOGLE);
+    KONIDE_VK_ENTRY(vkGetRefreshCycleDurationGOOGLE);
+#endif /* defined(VK_GOOGLE_display_timing) */
+#if defined(VK_HUAWEI_invocation_mask)
+    KONIDE_VK_ENTRY(vkCmdBindInvocationMaskHUAWEI);
+#endif /* defined(VK_HUAWEI_invocation_mask) */
+#if defined(VK_HUAWEI_subpass_shading)
+    KONIDE_VK_ENTRY(vkCmdSubpassShadingHUAWEI);
+    KONIDE_VK_ENTRY(vkGetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI);
+#endif /* defined(VK_HUAWEI_subpass_shading) */
+#if defined(VK_INTEL_performance_query)
+    KONIDE_VK_ENTRY(vkAcquirePerformanceConfigurationINTEL);
+    KONIDE_VK_ENTRY(vkCmdSetPerformanceMarkerINTEL);
+    KONIDE_VK_ENTRY(vkCmdSetPerformanceOverrideINTEL);
+    KONIDE_VK_ENTRY(vkCmdSetPerformanceStreamMarkerINTEL);
+    KONIDE_VK_ENTRY(vkGetPerformanceParameterINTEL);
+    KONIDE_VK_ENTRY(vkInitializePerformanceApiINTEL);
+    KONIDE_VK_ENTRY(vkQueueSetPerformanceConfigurationINTEL);
+    KONIDE_VK_ENTRY(vkReleasePerformanceConfigurationINTEL);
+    KONIDE_VK_ENTRY(vkUninitializePerformanceApiINTEL);
+#endif /* defined(VK_INTEL_performance_query) */
+#if defined(VK_KHR_acceleration_structure)
+    KONIDE_VK_ENTRY(vkBuildAccelerationStructuresKHR);
+    KONIDE_VK_ENTRY(vkCmdBuildAccelerationStructuresIndirectKHR);
+    KONIDE_VK_ENTRY(vkCmdBuildAccelerationStructuresKHR);
+    KONIDE_VK_ENTRY(vkCmdCopyAccelerationStructureKHR);
+    KONIDE_VK_ENTRY(vkCmdCopyAccelerationStructureToMemoryKHR);
+    KONIDE_VK_ENTRY(vkCmdCopyMemoryToAccelerationStructureKHR);
+    KONIDE_VK_ENTRY(vkCmdWriteAccelerationStructuresPropertiesKHR);
+    KONIDE_VK_ENTRY(vkCopyAccelerationStructureKHR);
+    KONIDE_VK_ENTRY(vkCopyAccelerationStructureToMemoryKHR);
+    KONIDE_VK_ENTRY(vkCopyMemoryToAccelerationStructureKHR);
+    KONIDE_VK_ENTRY(vkCreateAccelerationStructureKHR);
+    KONIDE_VK_ENTRY(vkDestroyAccelerationStructureKHR);
+    KONIDE_VK_ENTRY(vkGetAccelerationStructureBuildSizesKHR);
+    KONIDE_VK_ENTRY(vkGetAccelerationStructureDeviceAddressKHR);
+    KONIDE_VK_ENTRY(vkGetDeviceAccelerationStructureCompatibilityKHR);
+    KONIDE_VK_ENTRY(vkWriteAccelerationStructuresPropertiesKHR);
+#endif /* defined(VK_KHR_acceleration_structure) */
+#if defined(VK_KHR_bind_memory2)
+    KONIDE_VK_ENTRY(vkBindBufferMemory2KHR);
+    KONIDE_VK_ENTRY(vkBindImageMemory2KHR);
+#endif /* defined(VK_KHR_bind_memory2) */
+#if defined(VK_KHR_buffer_device_address)
+    KONIDE_VK_ENTRY(vkGetBufferDeviceAddressKHR);
+    KONIDE_VK_ENTRY(vkGetBufferOpaqueCaptureAddressKHR);
+    KONIDE_VK_ENTRY(vkGetDeviceMemoryOpaqueCaptureAddressKHR);
+#endif /* defined(VK_KHR_buffer_device_address) */
+#if defined(VK_KHR_copy_commands2)
+    KONIDE_VK_ENTRY(vkCmdBlitImage2KHR);
+    KONIDE_VK_ENTRY(vkCmdCopyBuffer2KHR);
+    KONIDE_VK_ENTRY(vkCmdCopyBufferToImage2KHR);
+    KONIDE_VK_ENTRY(vkCmdCopyImage2KHR);
+    KONIDE_VK_ENTRY(vkCmdCopyImageToBuffer2KHR);
+    KONIDE_VK_ENTRY(vkCmdResolveImage2KHR);
+#endif /* defined(VK_KHR_copy_commands2) */
+#if defined(VK_KHR_create_renderpass2)
+    KONIDE_VK_ENTRY(vkCmdBeginRenderPass2KHR);
+    KONIDE_VK_ENTRY(vkCmdEndRenderPass2KHR);
+    KONIDE_VK_ENTRY(vkCmdNextSubpass2KHR);
+    KONIDE_VK_ENTRY(vkCreateRenderPass2KHR);
+#endif /* defined(VK_KHR_create_renderpass2) */
+#if defined(VK_KHR_deferred_host_operations)
+    KONIDE_VK_ENTRY(vkCreateDeferredOperationKHR);
+    KONIDE_VK_ENTRY(vkDeferredOperationJoinKHR);
+    KONIDE_VK_ENTRY(vkDestroyDeferredOperationKHR);
+    KONIDE_VK_ENTRY(vkGetDeferredOperationMaxConcurrencyKHR);
+    KONIDE_VK_ENTRY(vkGetDeferredOperationResultKHR);
+#endif /* defined(VK_KHR_deferred_host_operations) */
+#if defined(VK_KHR_descriptor_update_template)
+    KONIDE_VK_ENTRY(vkCreateDescriptorUpdateTemplateKHR);
+    KONIDE_VK_ENTRY(vkDestroyDescriptorUpdateTemplateKHR);
+    KONIDE_VK_ENTRY(vkUpdateDescriptorSetWithTemplateKHR);
+#endif /* defined(VK_KHR_descriptor_update_template) */
+#if defined(VK_KHR_device_group)
+    KONIDE_VK_ENTRY(vkCmdDispatchBaseKHR);
+    KONIDE_VK_ENTRY(vkCmdSetDeviceMaskKHR);
+    KONIDE_VK_ENTRY(vkGetDeviceGroupPeerMemoryFeaturesKHR);
+#endif /* defined(VK_KHR_device_group) */
+#if defined(VK_KHR_display_swapchain)
+    KONIDE_VK_ENTRY(vkCreateSharedSwapchainsKHR);
+#endif /* defined(VK_KHR_display_swapchain) */
+#if defined(VK_KHR_draw_indirect_count)
+    KONIDE_VK_ENTRY(vkCmdDrawIndexedIndirectCountKHR);
+    KONIDE_VK_ENTRY(vkCmdDrawIndirectCountKHR);
+#endif /* defined(VK_KHR_draw_indirect_count) */
+#if defined(VK_KHR_dynamic_rendering)
+    KONIDE_VK_ENTRY(vkCmdBeginRenderingKHR);
+    KONIDE_VK_ENTRY(vkCmdEndRenderingKHR);
+#endif /* defined(VK_KHR_dynamic_rendering) */
+#if defined(VK_KHR_external_fence_fd)
+    KONIDE_VK_ENTRY(vkGetFenceFdKHR);
+    KONIDE_VK_ENTRY(vkImportFenceFdKHR);
+#endif /* defined(VK_KHR_external_fence_fd) */
+#if defined(VK_KHR_external_fence_win32)
+    KONIDE_VK_ENTRY(vkGetFenceWin32HandleKHR);
+    KONIDE_VK_ENTRY(vkImportFenceWin32HandleKHR);
+#endif /* defined(VK_KHR_external_fence_win32) */
+#if defined(VK_KHR_external_memory_fd)
+    KONIDE_VK_ENTRY(vkGetMemoryFdKHR);
+    KONIDE_VK_ENTRY(vkGetMemoryFdPropertiesKHR);
+#endif /* defined(VK_KHR_external_memory_fd) */
+#if defined(VK_KHR_external_memory_win32)
+    KONIDE_VK_ENTRY(vkGetMemoryWin32HandleKHR);
+    KONIDE_VK_ENTRY(vkGetMemoryWin32HandlePropertiesKHR);
+#endif /* defined(VK_KHR_external_memory_win32) */
+#if defined(VK_KHR_external_semaphore_fd)
+    KONIDE_VK_ENTRY(vkGetSemaphoreFdKHR);
+    KONIDE_VK_ENTRY(vkImportSemaphoreFdKHR);
+#endif /* defined(VK_KHR_external_semaphore_fd) */
+#if defined(VK_KHR_external_semaphore_win32)
+    KONIDE_VK_ENTRY(vkGetSemaphoreWin32HandleKHR);
+    KONIDE_VK_ENTRY(vkImportSemaphoreWin32HandleKHR);
+#endif /* defined(VK_KHR_external_semaphore_win32) */
+#if defined(VK_KHR_fragment_shading_rate)
+    KONIDE_VK_ENTRY(vkCmdSetFragmentShadingRateKHR);
+#endif /* defined(VK_KHR_fragment_shading_rate) */
+#if defined(VK_KHR_get_memory_requirements2)
+    KONIDE_VK_ENTRY(vkGetBufferMemoryRequirements2KHR);
+    KONIDE_VK_ENTRY(vkGetImageMemoryRequirements2KHR);
+    KONIDE_VK_ENTRY(vkGetImageSparseMemoryRequirements2KHR);
+#endif /* defined(VK_KHR_get_memory_requirements2) */
+#if defined(VK_KHR_maintenance1)
+    KONIDE_VK_ENTRY(vkTrimCommandPoolKHR);
+#endif /* defined(VK_KHR_maintenance1) */
+#if defined(VK_KHR_maintenance3)
+    KONIDE_VK_ENTRY(vkGetDescriptorSetLayoutSupportKHR);
+#endif /* defined(VK_KHR_maintenance3) */
+#if defined(VK_KHR_maintenance4)
+    KONIDE_VK_ENTRY(vkGetDeviceBufferMemoryRequirementsKHR);
+    KONIDE_VK_ENTRY(vkGetDeviceImageMemoryRequirementsKHR);
+    KONIDE_VK_ENTRY(vkGetDeviceImageSparseMemoryRequirementsKHR);
+#endif /* defined(VK_KHR_maintenance4) */
+#if defined(VK_KHR_performance_query)
+    KONIDE_VK_ENTRY(vkAcquireProfilingLockKHR);
+    KONIDE_VK_ENTRY(vkReleaseProfilingLockKHR);
+#endif /* defined(VK_KHR_performance_query) */
+#if defined(VK_KHR_pipeline_executable_properties)
+    KONIDE_VK_ENTRY(vkGetPipelineExecutableInternalRepresentationsKHR);
+    KONIDE_VK_ENTRY(vkGetPipelineExecutablePropertiesKHR);
+    KONIDE_VK_ENTRY(vkGetPipelineExecutableStatisticsKHR);
+#endif /* defined(VK_KHR_pipeline_executable_properties) */
+#if defined(VK_KHR_present_wait)
+    KONIDE_VK_ENTRY(vkWaitForPresentKHR);
+#endif /* defined(VK_KHR_present_wait) */
+#if defined(VK_KHR_push_descriptor)
+    KONIDE_VK_ENTRY(vkCmdPushDescriptorSetKHR);
+#endif /* defined(VK_KHR_push_descriptor) */
+#if defined(VK_KHR_ray_tracing_maintenance1) && defined(VK_KHR_ray_tracing_pipeline)
+    KONIDE_VK_ENTRY(vkCmdTraceRaysIndirect2KHR);
+#endif /* defined(VK_KHR_ray_tracing_maintenance1) && defined(VK_KHR_ray_tracing_pipeline) */
+#if defined(VK_KHR_ray_tracing_pipeline)
+    KONIDE_VK_ENTRY(vkCmdSetRayTracingPipelineStackSizeKHR);
+    KONIDE_VK_ENTRY(vkCmdTraceRaysIndirectKHR);
+    KONIDE_VK_ENTRY(vkCmdTraceRaysKHR);
+    KONIDE_VK_ENTRY(vkCreateRayTracingPipelinesKHR);
+    KONIDE_VK_ENTRY(vkGetRayTracingCaptureReplayShaderGroupHandlesKHR);
+    KONIDE_VK_ENTRY(vkGetRayTracingShaderGroupHandlesKHR);
+    KONIDE_VK_ENTRY(vkGetRayTracingShaderGroupStackSizeKHR);
+#endif /* defined(VK_KHR_ray_tracing_pipeline) */
+#if defined(VK_KHR_sampler_ycbcr_conversion)
+    KONIDE_VK_ENTRY(vkCreateSamplerYcbcrConversionKHR);
+    KONIDE_VK_ENTRY(vkDestroySamplerYcbcrConversionKHR);
+#endif /* defined(VK_KHR_sampler_ycbcr_conversion) */
+#if defined(VK_KHR_shared_presentable_image)
+    KONIDE_VK_ENTRY(vkGetSwapchainStatusKHR);
+#endif /* defined(VK_KHR_shared_presentable_image) */
+#if defined(VK_KHR_swapchain)
+    KONIDE_VK_ENTRY(vkAcquireNextImageKHR);
+    KONIDE_VK_ENTRY(vkCreateSwapchainKHR);
+    KONIDE_VK_ENTRY(vkDestroySwapchainKHR);
+    KONIDE_VK_ENTRY(vkGetSwapchainImagesKHR);
+    KONIDE_VK_ENTRY(vkQueuePresentKHR);
+#endif /* defined(VK_KHR_swapchain) */
+#if defined(VK_KHR_synchronization2)
+    KONIDE_VK_ENTRY(vkCmdPipelineBarrier2KHR);
+    KONIDE_VK_ENTRY(vkCmdResetEvent2KHR);
+    KONIDE_VK_ENTRY(vkCmdSetEvent2KHR);
+    KONIDE_VK_ENTRY(vkCmdWaitEvents2KHR);
+    KONIDE_VK_ENTRY(vkCmdWriteTimestamp2KHR);
+    KONIDE_VK_ENTRY(vkQueueSubmit2KHR);
+#endif /* defined(VK_KHR_synchronization2) */
+#if defined(VK_KHR_synchronization2) && defined(VK_AMD_buffer_marker)
+    KONIDE_VK_ENTRY(vkCmdWriteBufferMarker2AMD);
+#endif /* defined(VK_KHR_synchronization2) && defined(VK_AMD_buffer_marker) */
+#if defined(VK_KHR_synchronization2) && defined(VK_NV_device_diagnostic_checkpoints)
+    KONIDE_VK_ENTRY(vkGetQueueCheckpointData2NV);
+#endif /* defined(VK_KHR_synchronization2) && defined(VK_NV_device_diagnostic_checkpoints) */
+#if defined(VK_KHR_timeline_semaphore)
+    KONIDE_VK_ENTRY(vkGetSemaphoreCounterValueKHR);
+    KONIDE_VK_ENTRY(vkSignalSemaphoreKHR);
+    KONIDE_VK_ENTRY(vkWaitSemaphoresKHR);
+#endif /* defined(VK_KHR_timeline_semaphore) */
+#if defined(VK_KHR_video_decode_queue)
+    KONIDE_VK_ENTRY(vkCmdDecodeVideoKHR);
+#endif /* defined(VK_KHR_video_decode_queue) */
+#if defined(VK_KHR_video_queue)
+    KONIDE_VK_ENTRY(vkBindVideoSessionMemoryKHR);
+    KONIDE_VK_ENTRY(vkCmdBeginVideoCodingKHR);
+    KONIDE_VK_ENTRY(vkCmdControlVideoCodingKHR);
+    KONIDE_VK_ENTRY(vkCmdEndVideoCodingKHR);
+    KONIDE_VK_ENTRY(vkCreateVideoSessionKHR);
+    KONIDE_VK_ENTRY(vkCreateVideoSessionParametersKHR);
+    KONIDE_VK_ENTRY(vkDestroyVideoSessionKHR);
+    KONIDE_VK_ENTRY(vkDestroyVideoSessionParametersKHR);
+    KONIDE_VK_ENTRY(vkGetVideoSessionMemoryRequirementsKHR);
+    KONIDE_VK_ENTRY(vkUpdateVideoSessionParametersKHR);
+#endif /* defined(VK_KHR_video_queue) */
+#if defined(VK_NVX_binary_import)
+    KONIDE_VK_ENTRY(vkCmdCuLaunchKernelNVX);
+    KONIDE_VK_ENTRY(vkCreateCuFunctionNVX);
+    KONIDE_VK_ENTRY(vkCreateCuModuleNVX);
+    KONIDE_VK_ENTRY(vkDestroyCuFunctionNVX);
+    KONIDE_VK_ENTRY(vkDestroyCuModuleNVX);
+#endif /* defined(VK_NVX_binary_import) */
+#if defined(VK_NVX_image_view_handle)
+    KONIDE_VK_ENTRY(vkGetImageViewAddressNVX);
+    KONIDE_VK_ENTRY(vkGetImageViewHandleNVX);
+#endif /* defined(VK_NVX_image_view_handle) */
+#if defined(VK_NV_clip_space_w_scaling)
+    KONIDE_VK_ENTRY(vkCmdSetViewportWScalingNV);
+#endif /* defined(VK_NV_clip_space_w_scaling) */
+#if defined(VK_NV_copy_memory_indirect)
+    KONIDE_VK_ENTRY(vkCmdCopyMemoryIndirectNV);
+    KONIDE_VK_ENTRY(vkCmdCopyMemoryToImageIndirectNV);
+#endif /* defined(VK_NV_copy_memory_indirect) */
+#if defined(VK_NV_device_diagnostic_checkpoints)
+    KONIDE_VK_ENTRY(vkCmdSetCheckpointNV);
+    KONIDE_VK_ENTRY(vkGetQueueCheckpointDataNV);
+#endif /* defined(VK_NV_device_diagnostic_checkpoints) */
+#if defined(VK_NV_device_generated_commands)
+    KONIDE_VK_ENTRY(vkCmdBindPipelineShaderGroupNV);
+    KONIDE_VK_ENTRY(vkCmdExecuteGeneratedCommandsNV);
+    KONIDE_VK_ENTRY(vkCmdPreprocessGeneratedCommandsNV);
+    KONIDE_VK_ENTRY(vkCreateIndirectCommandsLayoutNV);
+    KONIDE_VK_ENTRY(vkDestroyIndirectCommandsLayoutNV);
+    KONIDE_VK_ENTRY(vkGetGeneratedCommandsMemoryRequirementsNV);
+#endif /* defined(VK_NV_device_generated_commands) */
+#if defined(VK_NV_external_memory_rdma)
+    KONIDE_VK_ENTRY(vkGetMemoryRemoteAddressNV);
+#endif /* defined(VK_NV_external_memory_rdma) */
+#if defined(VK_NV_external_memory_win32)
+    KONIDE_VK_ENTRY(vkGetMemoryWin32HandleNV);
+#endif /* defined(VK_NV_external_memory_win32) */
+#if defined(VK_NV_fragment_shading_rate_enums)
+    KONIDE_VK_ENTRY(vkCmdSetFragmentShadingRateEnumNV);
+#endif /* defined(VK_NV_fragment_shading_rate_enums) */
+#if defined(VK_NV_memory_decompression)
+    KONIDE_VK_ENTRY(vkCmdDecompressMemoryIndirectCountNV);
+    KONIDE_VK_ENTRY(vkCmdDecompressMemoryNV);
+#endif /* defined(VK_NV_memory_decompression) */
+#if defined(VK_NV_mesh_shader)
+    KONIDE_VK_ENTRY(vkCmdDrawMeshTasksIndirectCountNV);
+    KONIDE_VK_ENTRY(vkCmdDrawMeshTasksIndirectNV);
+    KONIDE_VK_ENTRY(vkCmdDrawMeshTasksNV);
+#endif /* defined(VK_NV_mesh_shader) */
+#if defined(VK_NV_optical_flow)
+    KONIDE_VK_ENTRY(vkBindOpticalFlowSessionImageNV);
+    KONIDE_VK_ENTRY(vkCmdOpticalFlowExecuteNV);
+    KONIDE_VK_ENTRY(vkCreateOpticalFlowSessionNV);
+    KONIDE_VK_ENTRY(vkDestroyOpticalFlowSessionNV);
+#endif /* defined(VK_NV_optical_flow) */
+#if defined(VK_NV_ray_tracing)
+    KONIDE_VK_ENTRY(vkBindAccelerationStructureMemoryNV);
+    KONIDE_VK_ENTRY(vkCmdBuildAccelerationStructureNV);
+    KONIDE_VK_ENTRY(vkCmdCopyAccelerationStructureNV);
+    KONIDE_VK_ENTRY(vkCmdTraceRaysNV);
+    KONIDE_VK_ENTRY(vkCmdWriteAccelerationStructuresPropertiesNV);
+    KONIDE_VK_ENTRY(vkCompileDeferredNV);
+    KONIDE_VK_ENTRY(vkCreateAccelerationStructureNV);
+    KONIDE_VK_ENTRY(vkCreateRayTracingPipelinesNV);
+    KONIDE_VK_ENTRY(vkDestroyAccelerationStructureNV);
+    KONIDE_VK_ENTRY(vkGetAccelerationStructureHandleNV);
+    KONIDE_VK_ENTRY(vkGetAccelerationStructureMemoryRequirementsNV);
+    KONIDE_VK_ENTRY(vkGetRayTracingShaderGroupHandlesNV);
+#endif /* defined(VK_NV_ray_tracing) */
+#if defined(VK_NV_scissor_exclusive)
+    KONIDE_VK_ENTRY(vkCmdSetExclusiveScissorNV);
+#endif /* defined(VK_NV_scissor_exclusive) */
+#if defined(VK_NV_shading_rate_image)
+    KONIDE_VK_ENTRY(vkCmdBindShadingRateImageNV);
+    KONIDE_VK_ENTRY(vkCmdSetCoarseSampleOrderNV);
+    KONIDE_VK_ENTRY(vkCmdSetViewportShadingRatePaletteNV);
+#endif /* defined(VK_NV_shading_rate_image) */
+#if defined(VK_QCOM_tile_properties)
+    KONIDE_VK_ENTRY(vkGetDynamicRenderingTilePropertiesQCOM);
+    KONIDE_VK_ENTRY(vkGetFramebufferTilePropertiesQCOM);
+#endif /* defined(VK_QCOM_tile_properties) */
+#if defined(VK_QNX_external_memory_screen_buffer)
+    KONIDE_VK_ENTRY(vkGetScreenBufferPropertiesQNX);
+#endif /* defined(VK_QNX_external_memory_screen_buffer) */
+#if defined(VK_VALVE_descriptor_set_host_mapping)
+    KONIDE_VK_ENTRY(vkGetDescriptorSetHostMappingVALVE);
+    KONIDE_VK_ENTRY(vkGetDescriptorSetLayoutHostMappingInfoVALVE);
+#endif /* defined(VK_VALVE_descriptor_set_host_mapping) */
+#if (defined(VK_EXT_extended_dynamic_state)) || (defined(VK_EXT_shader_object))
+    KONIDE_VK_ENTRY(vkCmdBindVertexBuffers2EXT);
+    KONIDE_VK_ENTRY(vkCmdSetCullModeEXT);
+    KONIDE_VK_ENTRY(vkCmdSetDepthBoundsTestEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetDepthCompareOpEXT);
+    KONIDE_VK_ENTRY(vkCmdSetDepthTestEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetDepthWriteEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetFrontFaceEXT);
+    KONIDE_VK_ENTRY(vkCmdSetPrimitiveTopologyEXT);
+    KONIDE_VK_ENTRY(vkCmdSetScissorWithCountEXT);
+    KONIDE_VK_ENTRY(vkCmdSetStencilOpEXT);
+    KONIDE_VK_ENTRY(vkCmdSetStencilTestEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetViewportWithCountEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state)) || (defined(VK_EXT_shader_object)) */
+#if (defined(VK_EXT_extended_dynamic_state2)) || (defined(VK_EXT_shader_object))
+    KONIDE_VK_ENTRY(vkCmdSetDepthBiasEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetLogicOpEXT);
+    KONIDE_VK_ENTRY(vkCmdSetPatchControlPointsEXT);
+    KONIDE_VK_ENTRY(vkCmdSetPrimitiveRestartEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetRasterizerDiscardEnableEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state2)) || (defined(VK_EXT_shader_object)) */
+#if (defined(VK_EXT_extended_dynamic_state3)) || (defined(VK_EXT_shader_object))
+    KONIDE_VK_ENTRY(vkCmdSetAlphaToCoverageEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetAlphaToOneEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetColorBlendEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetColorBlendEquationEXT);
+    KONIDE_VK_ENTRY(vkCmdSetColorWriteMaskEXT);
+    KONIDE_VK_ENTRY(vkCmdSetDepthClampEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetLogicOpEnableEXT);
+    KONIDE_VK_ENTRY(vkCmdSetPolygonModeEXT);
+    KONIDE_VK_ENTRY(vkCmdSetRasterizationSamplesEXT);
+    KONIDE_VK_ENTRY(vkCmdSetSampleMaskEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3)) || (defined(VK_EXT_shader_object)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && (defined(VK_KHR_maintenance2) || defined(VK_VERSION_1_1))) || (defined(VK_EXT_shader_object))
+    KONIDE_VK_ENTRY(vkCmdSetTessellationDomainOriginEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && (defined(VK_KHR_maintenance2) || defined(VK_VERSION_1_1))) || (defined(VK_EXT_shader_object)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_transform_feedback)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_transform_feedback))
+    KONIDE_VK_ENTRY(vkCmdSetRasterizationStreamEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_transform_feedback)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_transform_feedback)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_conservative_rasterization)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_conservative_rasterization))
+    KONIDE_VK_ENTRY(vkCmdSetConservativeRasterizationModeEXT);
+    KONIDE_VK_ENTRY(vkCmdSetExtraPrimitiveOverestimationSizeEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_conservative_rasterization)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_conservative_rasterization)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_depth_clip_enable)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_depth_clip_enable))
+    KONIDE_VK_ENTRY(vkCmdSetDepthClipEnableEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_depth_clip_enable)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_depth_clip_enable)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_sample_locations)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_sample_locations))
+    KONIDE_VK_ENTRY(vkCmdSetSampleLocationsEnableEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_sample_locations)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_sample_locations)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_blend_operation_advanced)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_blend_operation_advanced))
+    KONIDE_VK_ENTRY(vkCmdSetColorBlendAdvancedEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_blend_operation_advanced)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_blend_operation_advanced)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_provoking_vertex)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_provoking_vertex))
+    KONIDE_VK_ENTRY(vkCmdSetProvokingVertexModeEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_provoking_vertex)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_provoking_vertex)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_line_rasterization)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_line_rasterization))
+    KONIDE_VK_ENTRY(vkCmdSetLineRasterizationModeEXT);
+    KONIDE_VK_ENTRY(vkCmdSetLineStippleEnableEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_line_rasterization)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_line_rasterization)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_depth_clip_control)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_depth_clip_control))
+    KONIDE_VK_ENTRY(vkCmdSetDepthClipNegativeOneToOneEXT);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_EXT_depth_clip_control)) || (defined(VK_EXT_shader_object) && defined(VK_EXT_depth_clip_control)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_clip_space_w_scaling)) || (defined(VK_EXT_shader_object) && defined(VK_NV_clip_space_w_scaling))
+    KONIDE_VK_ENTRY(vkCmdSetViewportWScalingEnableNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_clip_space_w_scaling)) || (defined(VK_EXT_shader_object) && defined(VK_NV_clip_space_w_scaling)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_viewport_swizzle)) || (defined(VK_EXT_shader_object) && defined(VK_NV_viewport_swizzle))
+    KONIDE_VK_ENTRY(vkCmdSetViewportSwizzleNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_viewport_swizzle)) || (defined(VK_EXT_shader_object) && defined(VK_NV_viewport_swizzle)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_fragment_coverage_to_color)) || (defined(VK_EXT_shader_object) && defined(VK_NV_fragment_coverage_to_color))
+    KONIDE_VK_ENTRY(vkCmdSetCoverageToColorEnableNV);
+    KONIDE_VK_ENTRY(vkCmdSetCoverageToColorLocationNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_fragment_coverage_to_color)) || (defined(VK_EXT_shader_object) && defined(VK_NV_fragment_coverage_to_color)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_framebuffer_mixed_samples)) || (defined(VK_EXT_shader_object) && defined(VK_NV_framebuffer_mixed_samples))
+    KONIDE_VK_ENTRY(vkCmdSetCoverageModulationModeNV);
+    KONIDE_VK_ENTRY(vkCmdSetCoverageModulationTableEnableNV);
+    KONIDE_VK_ENTRY(vkCmdSetCoverageModulationTableNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_framebuffer_mixed_samples)) || (defined(VK_EXT_shader_object) && defined(VK_NV_framebuffer_mixed_samples)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_shading_rate_image)) || (defined(VK_EXT_shader_object) && defined(VK_NV_shading_rate_image))
+    KONIDE_VK_ENTRY(vkCmdSetShadingRateImageEnableNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_shading_rate_image)) || (defined(VK_EXT_shader_object) && defined(VK_NV_shading_rate_image)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_representative_fragment_test)) || (defined(VK_EXT_shader_object) && defined(VK_NV_representative_fragment_test))
+    KONIDE_VK_ENTRY(vkCmdSetRepresentativeFragmentTestEnableNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_representative_fragment_test)) || (defined(VK_EXT_shader_object) && defined(VK_NV_representative_fragment_test)) */
+#if (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_coverage_reduction_mode)) || (defined(VK_EXT_shader_object) && defined(VK_NV_coverage_reduction_mode))
+    KONIDE_VK_ENTRY(vkCmdSetCoverageReductionModeNV);
+#endif /* (defined(VK_EXT_extended_dynamic_state3) && defined(VK_NV_coverage_reduction_mode)) || (defined(VK_EXT_shader_object) && defined(VK_NV_coverage_reduction_mode)) */
+#if (defined(VK_EXT_full_screen_exclusive) && defined(VK_KHR_device_group)) || (defined(VK_EXT_full_screen_exclusive) && defined(VK_VERSION_1_1))
+    KONIDE_VK_ENTRY(vkGetDeviceGroupSurfacePresentModes2EXT);
+#endif /* (defined(VK_EXT_full_screen_exclusive) && defined(VK_KHR_device_group)) || (defined(VK_EXT_full_screen_exclusive) && defined(VK_VERSION_1_1)) */
+#if (defined(VK_EXT_host_image_copy)) || (defined(VK_EXT_image_compression_control))
+    KONIDE_VK_ENTRY(vkGetImageSubresourceLayout2EXT);
+#endif /* (defined(VK_EXT_host_image_copy)) || (defined(VK_EXT_image_compression_control)) */
+#if (defined(VK_EXT_shader_object)) || (defined(VK_EXT_vertex_input_dynamic_state))
+    KONIDE_VK_ENTRY(vkCmdSetVertexInputEXT);
+#endif /* (defined(VK_EXT_shader_object)) || (defined(VK_EXT_vertex_input_dynamic_state)) */
+#if (defined(VK_KHR_descriptor_update_template) && defined(VK_KHR_push_descriptor)) || (defined(VK_KHR_push_descriptor) && defined(VK_VERSION_1_1)) || (defined(VK_KHR_push_descriptor) && defined(VK_KHR_descriptor_update_template))
+    KONIDE_VK_ENTRY(vkCmdPushDescriptorSetWithTemplateKHR);
+#endif /* (defined(VK_KHR_descriptor_update_template) && defined(VK_KHR_push_descriptor)) || (defined(VK_KHR_push_descriptor) && defined(VK_VERSION_1_1)) || (defined(VK_KHR_push_descriptor) && defined(VK_KHR_descriptor_update_template)) */
+#if (defined(VK_KHR_device_group) && defined(VK_KHR_surface)) || (defined(VK_KHR_swapchain) && defined(VK_VERSION_1_1))
+    KONIDE_VK_ENTRY(vkGetDeviceGroupPresentCapabilitiesKHR);
+    KONIDE_VK_ENTRY(vkGetDeviceGroupSurfacePresentModesKHR);
+#endif /* (defined(VK_KHR_device_group) && defined(VK_KHR_surface)) || (defined(VK_KHR_swapchain) && defined(VK_VERSION_1_1)) */
+#if (defined(VK_KHR_device_group) && defined(VK_KHR_swapchain)) || (defined(VK_KHR_swapchain) && defined(VK_VERSION_1_1))
+    KONIDE_VK_ENTRY(vkAcquireNextImage2KHR);
+#endif /* (defined(VK_KHR_device_group) && defined(VK_KHR_swapchain)) || (defined(VK_KHR_swapchain) && defined(VK_VERSION_1_1)) */
+};
+
+/* Time spent resolving entrypoints while creating an instance and device, in seconds, and the lookups it took */
+struct KonideLoaderStats {
+    double instanceLoadTime = 0.0;
+    double deviceLoadTime = 0.0;
+    uint32_t instanceLookups = 0;
+    uint32_t deviceLookups = 0;
+};
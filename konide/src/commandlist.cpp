@@ -0,0 +1,352 @@
+#include <konide/commandlist.h>
+
+#include <algorithm>
+#include <cstring>
+
+static size_t InternalAlignCommandSize(size_t size)
+{
+    return (size + KONIDE_COMMAND_ALIGNMENT - 1) & ~(size_t)(KONIDE_COMMAND_ALIGNMENT - 1);
+}
+
+uint8_t* KonideFrameArena::AllocateBlock(size_t minSize, size_t& size)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Prefer a block kept from earlier frames, oversized requests may have to look past the next one
+    for (size_t i = usedBlocks; i < blocks.size(); i++) {
+        if (blocks[i].size >= minSize) {
+            std::swap(blocks[i], blocks[usedBlocks]);
+            size = blocks[usedBlocks].size;
+            stats.bytesUsed += size;
+            return blocks[usedBlocks++].data.get();
+        }
+    }
+
+    Block block;
+    block.size = std::max(minSize, (size_t)KONIDE_ARENA_BLOCK_SIZE);
+    block.data.reset(new uint8_t[block.size]);
+    blocks.push_back(std::move(block));
+    std::swap(blocks.back(), blocks[usedBlocks]);
+
+    stats.blockAllocations++;
+    stats.capacity += blocks[usedBlocks].size;
+    size = blocks[usedBlocks].size;
+    stats.bytesUsed += size;
+    return blocks[usedBlocks++].data.get();
+}
+
+void KonideFrameArena::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    usedBlocks = 0;
+    stats.bytesUsed = 0;
+    generation++;
+}
+
+KonideFrameArenaStats KonideFrameArena::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void KonideCommandList::Begin(KonideFrameArena& newArena)
+{
+    Clear();
+    arena = &newArena;
+    generation = newArena.GetGeneration();
+}
+
+void KonideCommandList::Clear()
+{
+    segments.clear();
+    blockEnd = nullptr;
+    commandCount = 0;
+    bytes = 0;
+
+    draws.clear();
+    drawOrder.clear();
+    prologueCount = 0;
+    bSorted = false;
+}
+
+uint8_t* KonideCommandList::Allocate(EKonideCommandType type, size_t size)
+{
+    size = InternalAlignCommandSize(size);
+
+    // Commands never straddle blocks, a full block starts a new segment
+    if (segments.empty() || (size_t)(blockEnd - segments.back().end) < size) {
+        size_t blockSize = 0;
+        uint8_t* block = arena->AllocateBlock(size, blockSize);
+        segments.push_back({ block, block });
+        blockEnd = block + blockSize;
+    }
+
+    uint8_t* command = segments.back().end;
+    segments.back().end += size;
+    commandCount++;
+    bytes += size;
+
+    if (draws.empty()) {
+        prologueCount++;
+    } else {
+        draws.back().commandCount++;
+    }
+
+    KonideCommandHeader* header = reinterpret_cast<KonideCommandHeader*>(command);
+    header->type = type;
+    header->size = (uint32_t)size;
+    return command;
+}
+
+void KonideCommandList::BeginDraw(uint64_t sortKey)
+{
+    KonideCommandBeginDraw* command = reinterpret_cast<KonideCommandBeginDraw*>(Allocate(KONIDE_COMMAND_BEGIN_DRAW, sizeof(KonideCommandBeginDraw)));
+    command->sortKey = sortKey;
+
+    // Allocate counted the marker as part of the previous draw
+    if (draws.empty()) {
+        prologueCount--;
+    } else {
+        draws.back().commandCount--;
+    }
+
+    DrawRange draw;
+    draw.begin = &command->header;
+    draw.segment = (uint32_t)segments.size() - 1;
+    draw.commandCount = 1;
+    draws.push_back(draw);
+
+    drawOrder.push_back({ sortKey, (uint32_t)draws.size() - 1 });
+    bSorted = false;
+}
+
+void KonideCommandList::SortDraws(KonideRadixSorter& sorter)
+{
+    if (!bSorted) {
+        sorter.Sort(drawOrder);
+        bSorted = true;
+    }
+}
+
+void KonideCommandList::BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline)
+{
+    KonideCommandBindPipeline* command = reinterpret_cast<KonideCommandBindPipeline*>(Allocate(KONIDE_COMMAND_BIND_PIPELINE, sizeof(KonideCommandBindPipeline)));
+    command->bindPoint = bindPoint;
+    command->pipeline = pipeline;
+}
+
+void KonideCommandList::BindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* sets,
+    uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets)
+{
+    size_t size = sizeof(KonideCommandBindDescriptorSets) + setCount * sizeof(VkDescriptorSet) + dynamicOffsetCount * sizeof(uint32_t);
+    uint8_t* data = Allocate(KONIDE_COMMAND_BIND_DESCRIPTOR_SETS, size);
+
+    KonideCommandBindDescriptorSets* command = reinterpret_cast<KonideCommandBindDescriptorSets*>(data);
+    command->bindPoint = bindPoint;
+    command->layout = layout;
+    command->firstSet = firstSet;
+    command->setCount = setCount;
+    command->dynamicOffsetCount = dynamicOffsetCount;
+
+    data += sizeof(KonideCommandBindDescriptorSets);
+    memcpy(data, sets, setCount * sizeof(VkDescriptorSet));
+    if (dynamicOffsetCount > 0) {
+        memcpy(data + setCount * sizeof(VkDescriptorSet), dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+    }
+}
+
+void KonideCommandList::BindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset)
+{
+    KonideCommandBindVertexBuffer* command = reinterpret_cast<KonideCommandBindVertexBuffer*>(Allocate(KONIDE_COMMAND_BIND_VERTEX_BUFFER, sizeof(KonideCommandBindVertexBuffer)));
+    command->binding = binding;
+    command->buffer = buffer;
+    command->offset = offset;
+}
+
+void KonideCommandList::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+{
+    KonideCommandBindIndexBuffer* command = reinterpret_cast<KonideCommandBindIndexBuffer*>(Allocate(KONIDE_COMMAND_BIND_INDEX_BUFFER, sizeof(KonideCommandBindIndexBuffer)));
+    command->buffer = buffer;
+    command->offset = offset;
+    command->indexType = indexType;
+}
+
+void KonideCommandList::PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    uint8_t* data = Allocate(KONIDE_COMMAND_PUSH_CONSTANTS, sizeof(KonideCommandPushConstants) + size);
+
+    KonideCommandPushConstants* command = reinterpret_cast<KonideCommandPushConstants*>(data);
+    command->layout = layout;
+    command->stageFlags = stageFlags;
+    command->offset = offset;
+    command->size = size;
+    memcpy(data + sizeof(KonideCommandPushConstants), values, size);
+}
+
+void KonideCommandList::SetViewport(const VkViewport& viewport)
+{
+    KonideCommandSetViewport* command = reinterpret_cast<KonideCommandSetViewport*>(Allocate(KONIDE_COMMAND_SET_VIEWPORT, sizeof(KonideCommandSetViewport)));
+    command->viewport = viewport;
+}
+
+void KonideCommandList::SetScissor(const VkRect2D& scissor)
+{
+    KonideCommandSetScissor* command = reinterpret_cast<KonideCommandSetScissor*>(Allocate(KONIDE_COMMAND_SET_SCISSOR, sizeof(KonideCommandSetScissor)));
+    command->scissor = scissor;
+}
+
+void KonideCommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    KonideCommandDraw* command = reinterpret_cast<KonideCommandDraw*>(Allocate(KONIDE_COMMAND_DRAW, sizeof(KonideCommandDraw)));
+    command->vertexCount = vertexCount;
+    command->instanceCount = instanceCount;
+    command->firstVertex = firstVertex;
+    command->firstInstance = firstInstance;
+}
+
+void KonideCommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    KonideCommandDrawIndexed* command = reinterpret_cast<KonideCommandDrawIndexed*>(Allocate(KONIDE_COMMAND_DRAW_INDEXED, sizeof(KonideCommandDrawIndexed)));
+    command->indexCount = indexCount;
+    command->instanceCount = instanceCount;
+    command->firstIndex = firstIndex;
+    command->vertexOffset = vertexOffset;
+    command->firstInstance = firstInstance;
+}
+
+void KonideCommandList::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    KonideCommandDispatch* command = reinterpret_cast<KonideCommandDispatch*>(Allocate(KONIDE_COMMAND_DISPATCH, sizeof(KonideCommandDispatch)));
+    command->groupCountX = groupCountX;
+    command->groupCountY = groupCountY;
+    command->groupCountZ = groupCountZ;
+}
+
+void KonideCommandList::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& region)
+{
+    KonideCommandCopyBuffer* command = reinterpret_cast<KonideCommandCopyBuffer*>(Allocate(KONIDE_COMMAND_COPY_BUFFER, sizeof(KonideCommandCopyBuffer)));
+    command->srcBuffer = srcBuffer;
+    command->dstBuffer = dstBuffer;
+    command->region = region;
+}
+
+void KonideCommandList::CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, const VkBufferImageCopy& region)
+{
+    KonideCommandCopyBufferToImage* command = reinterpret_cast<KonideCommandCopyBufferToImage*>(Allocate(KONIDE_COMMAND_COPY_BUFFER_TO_IMAGE, sizeof(KonideCommandCopyBufferToImage)));
+    command->srcBuffer = srcBuffer;
+    command->dstImage = dstImage;
+    command->dstImageLayout = dstImageLayout;
+    command->region = region;
+}
+
+void KonideCommandList::TranslateRange(KonideCommandRecorder& recorder, const KonideCommandHeader* begin, uint32_t segment, uint32_t count) const
+{
+    const uint8_t* cursor = reinterpret_cast<const uint8_t*>(begin);
+    for (uint32_t i = 0; i < count; i++) {
+        // A draw may continue in the next block
+        while (cursor == segments[segment].end) {
+            cursor = segments[++segment].begin;
+        }
+
+        const KonideCommandHeader& command = *reinterpret_cast<const KonideCommandHeader*>(cursor);
+        TranslateCommand(recorder, command);
+        cursor += command.size;
+    }
+}
+
+uint32_t KonideCommandList::Translate(KonideCommandRecorder& recorder) const
+{
+    if (segments.empty()) {
+        return 0;
+    }
+
+    if (draws.empty()) {
+        ForEach([&recorder](const KonideCommandHeader& command) {
+            TranslateCommand(recorder, command);
+        });
+        return commandCount;
+    }
+
+    TranslateRange(recorder, reinterpret_cast<const KonideCommandHeader*>(segments[0].begin), 0, prologueCount);
+    for (const KonideDrawSortItem& item : drawOrder) {
+        const DrawRange& draw = draws[item.index];
+        TranslateRange(recorder, draw.begin, draw.segment, draw.commandCount);
+    }
+    return commandCount;
+}
+
+uint32_t KonideCommandList::Translate(VkCommandBuffer commandBuffer, const KonideDeviceTable& deviceTable) const
+{
+    KonideCommandRecorder recorder;
+    recorder.Begin(commandBuffer, deviceTable);
+    return Translate(recorder);
+}
+
+void KonideCommandList::TranslateCommand(KonideCommandRecorder& recorder, const KonideCommandHeader& command)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&command);
+
+    switch (command.type) {
+    case KONIDE_COMMAND_BIND_PIPELINE: {
+        const KonideCommandBindPipeline& bind = reinterpret_cast<const KonideCommandBindPipeline&>(command);
+        recorder.BindPipeline(bind.bindPoint, bind.pipeline);
+        break;
+    }
+    case KONIDE_COMMAND_BIND_DESCRIPTOR_SETS: {
+        const KonideCommandBindDescriptorSets& bind = reinterpret_cast<const KonideCommandBindDescriptorSets&>(command);
+        const VkDescriptorSet* sets = reinterpret_cast<const VkDescriptorSet*>(data + sizeof(KonideCommandBindDescriptorSets));
+        const uint32_t* dynamicOffsets = reinterpret_cast<const uint32_t*>(sets + bind.setCount);
+        recorder.BindDescriptorSets(bind.bindPoint, bind.layout, bind.firstSet, bind.setCount, sets, bind.dynamicOffsetCount, dynamicOffsets);
+        break;
+    }
+    case KONIDE_COMMAND_BIND_VERTEX_BUFFER: {
+        const KonideCommandBindVertexBuffer& bind = reinterpret_cast<const KonideCommandBindVertexBuffer&>(command);
+        recorder.BindVertexBuffers(bind.binding, 1, &bind.buffer, &bind.offset);
+        break;
+    }
+    case KONIDE_COMMAND_BIND_INDEX_BUFFER: {
+        const KonideCommandBindIndexBuffer& bind = reinterpret_cast<const KonideCommandBindIndexBuffer&>(command);
+        recorder.BindIndexBuffer(bind.buffer, bind.offset, bind.indexType);
+        break;
+    }
+    case KONIDE_COMMAND_PUSH_CONSTANTS: {
+        const KonideCommandPushConstants& push = reinterpret_cast<const KonideCommandPushConstants&>(command);
+        recorder.PushConstants(push.layout, push.stageFlags, push.offset, push.size, data + sizeof(KonideCommandPushConstants));
+        break;
+    }
+    case KONIDE_COMMAND_SET_VIEWPORT:
+        recorder.SetViewport(0, 1, &reinterpret_cast<const KonideCommandSetViewport&>(command).viewport);
+        break;
+    case KONIDE_COMMAND_SET_SCISSOR:
+        recorder.SetScissor(0, 1, &reinterpret_cast<const KonideCommandSetScissor&>(command).scissor);
+        break;
+    case KONIDE_COMMAND_DRAW: {
+        const KonideCommandDraw& draw = reinterpret_cast<const KonideCommandDraw&>(command);
+        recorder.Draw(draw.vertexCount, draw.instanceCount, draw.firstVertex, draw.firstInstance);
+        break;
+    }
+    case KONIDE_COMMAND_DRAW_INDEXED: {
+        const KonideCommandDrawIndexed& draw = reinterpret_cast<const KonideCommandDrawIndexed&>(command);
+        recorder.DrawIndexed(draw.indexCount, draw.instanceCount, draw.firstIndex, draw.vertexOffset, draw.firstInstance);
+        break;
+    }
+    case KONIDE_COMMAND_DISPATCH: {
+        const KonideCommandDispatch& dispatch = reinterpret_cast<const KonideCommandDispatch&>(command);
+        recorder.Dispatch(dispatch.groupCountX, dispatch.groupCountY, dispatch.groupCountZ);
+        break;
+    }
+    case KONIDE_COMMAND_COPY_BUFFER: {
+        const KonideCommandCopyBuffer& copy = reinterpret_cast<const KonideCommandCopyBuffer&>(command);
+        recorder.CopyBuffer(copy.srcBuffer, copy.dstBuffer, 1, &copy.region);
+        break;
+    }
+    case KONIDE_COMMAND_COPY_BUFFER_TO_IMAGE: {
+        const KonideCommandCopyBufferToImage& copy = reinterpret_cast<const KonideCommandCopyBufferToImage&>(command);
+        recorder.CopyBufferToImage(copy.srcBuffer, copy.dstImage, copy.dstImageLayout, 1, &copy.region);
+        break;
+    }
+    case KONIDE_COMMAND_BEGIN_DRAW:
+        // Only a marker for sorting
+        break;
+    }
+}
@@ -0,0 +1,338 @@
+#include <konide/commandrecorder.h>
+
+#include <algorithm>
+#include <cstring>
+
+KonideCommandRecorderStats& KonideCommandRecorderStats::operator+=(const KonideCommandRecorderStats& other)
+{
+    issuedCalls += other.issuedCalls;
+    elidedCalls += other.elidedCalls;
+    elidedPipelineBinds += other.elidedPipelineBinds;
+    elidedDescriptorBinds += other.elidedDescriptorBinds;
+    elidedBufferBinds += other.elidedBufferBinds;
+    elidedDynamicState += other.elidedDynamicState;
+    elidedPushConstants += other.elidedPushConstants;
+    return *this;
+}
+
+void KonideCommandRecorder::Begin(VkCommandBuffer newCommandBuffer, const KonideDeviceTable& newDeviceTable)
+{
+    commandBuffer = newCommandBuffer;
+    deviceTable = &newDeviceTable;
+    Invalidate();
+}
+
+void KonideCommandRecorder::Invalidate()
+{
+    for (BindPointState& bindPoint : bindPoints) {
+        bindPoint = BindPointState();
+    }
+
+    for (uint32_t i = 0; i < KONIDE_RECORDER_MAX_VERTEX_BINDINGS; i++) {
+        vertexBuffers[i] = VK_NULL_HANDLE;
+    }
+    indexBuffer = VK_NULL_HANDLE;
+
+    validDynamicState = 0;
+    viewportCount = 0;
+    scissorCount = 0;
+    stencilFaces = 0;
+
+    pushConstantLayout = VK_NULL_HANDLE;
+    pushConstantBegin = 0;
+    pushConstantEnd = 0;
+}
+
+KonideCommandRecorder::BindPointState* KonideCommandRecorder::GetBindPoint(VkPipelineBindPoint bindPoint)
+{
+    switch (bindPoint) {
+    case VK_PIPELINE_BIND_POINT_GRAPHICS: return &bindPoints[0];
+    case VK_PIPELINE_BIND_POINT_COMPUTE: return &bindPoints[1];
+    default: return nullptr;
+    }
+}
+
+void KonideCommandRecorder::CountElided(uint64_t& counter)
+{
+    counter++;
+    stats.elidedCalls++;
+}
+
+void KonideCommandRecorder::BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline, uint32_t dynamicStateMask)
+{
+    BindPointState* state = GetBindPoint(bindPoint);
+    if (bElide && state && state->pipeline == pipeline) {
+        CountElided(stats.elidedPipelineBinds);
+        return;
+    }
+
+    deviceTable->vkCmdBindPipeline(commandBuffer, bindPoint, pipeline);
+    stats.issuedCalls++;
+
+    if (state) {
+        state->pipeline = pipeline;
+    }
+
+    // Static state of the new pipeline overwrites whatever was set dynamically
+    if (bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS) {
+        validDynamicState &= dynamicStateMask;
+        if (!(dynamicStateMask & KONIDE_RECORDER_DYNAMIC_VIEWPORT)) {
+            viewportCount = 0;
+        }
+        if (!(dynamicStateMask & KONIDE_RECORDER_DYNAMIC_SCISSOR)) {
+            scissorCount = 0;
+        }
+        if (!(dynamicStateMask & KONIDE_RECORDER_DYNAMIC_STENCIL_REFERENCE)) {
+            stencilFaces = 0;
+        }
+    }
+}
+
+void KonideCommandRecorder::BindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t setCount,
+    const VkDescriptorSet* sets, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets)
+{
+    BindPointState* state = GetBindPoint(bindPoint);
+    bool bCached = state && firstSet + setCount <= KONIDE_RECORDER_MAX_DESCRIPTOR_SETS;
+
+    // Dynamic offsets aren't cached, binds using them always go through
+    if (bElide && bCached && dynamicOffsetCount == 0) {
+        bool bSame = true;
+        for (uint32_t i = 0; i < setCount && bSame; i++) {
+            const DescriptorSetState& bound = state->sets[firstSet + i];
+            bSame = bound.set == sets[i] && bound.layout == layout;
+        }
+        if (bSame) {
+            CountElided(stats.elidedDescriptorBinds);
+            return;
+        }
+    }
+
+    deviceTable->vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, firstSet, setCount, sets, dynamicOffsetCount, dynamicOffsets);
+    stats.issuedCalls++;
+
+    if (!state) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < KONIDE_RECORDER_MAX_DESCRIPTOR_SETS; i++) {
+        DescriptorSetState& bound = state->sets[i];
+        if (i >= firstSet && i < firstSet + setCount) {
+            bound.set = dynamicOffsetCount == 0 ? sets[i - firstSet] : VK_NULL_HANDLE;
+            bound.layout = layout;
+        } else if (bound.layout != layout) {
+            // Sets bound through another layout may be disturbed, the recorder can't tell whether the layouts are compatible
+            bound = DescriptorSetState();
+        }
+    }
+}
+
+void KonideCommandRecorder::BindVertexBuffers(uint32_t firstBinding, uint32_t bindingCount, const VkBuffer* buffers, const VkDeviceSize* offsets)
+{
+    bool bCached = firstBinding + bindingCount <= KONIDE_RECORDER_MAX_VERTEX_BINDINGS;
+
+    if (bElide && bCached) {
+        bool bSame = true;
+        for (uint32_t i = 0; i < bindingCount && bSame; i++) {
+            bSame = buffers[i] != VK_NULL_HANDLE && vertexBuffers[firstBinding + i] == buffers[i] && vertexOffsets[firstBinding + i] == offsets[i];
+        }
+        if (bSame) {
+            CountElided(stats.elidedBufferBinds);
+            return;
+        }
+    }
+
+    deviceTable->vkCmdBindVertexBuffers(commandBuffer, firstBinding, bindingCount, buffers, offsets);
+    stats.issuedCalls++;
+
+    if (bCached) {
+        for (uint32_t i = 0; i < bindingCount; i++) {
+            vertexBuffers[firstBinding + i] = buffers[i];
+            vertexOffsets[firstBinding + i] = offsets[i];
+        }
+    }
+}
+
+void KonideCommandRecorder::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type)
+{
+    if (bElide && buffer != VK_NULL_HANDLE && indexBuffer == buffer && indexOffset == offset && indexType == type) {
+        CountElided(stats.elidedBufferBinds);
+        return;
+    }
+
+    deviceTable->vkCmdBindIndexBuffer(commandBuffer, buffer, offset, type);
+    stats.issuedCalls++;
+
+    indexBuffer = buffer;
+    indexOffset = offset;
+    indexType = type;
+}
+
+void KonideCommandRecorder::PushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    bool bCached = offset + size <= KONIDE_RECORDER_MAX_PUSH_CONSTANTS;
+    bool bSameRange = layout == pushConstantLayout && stageFlags == pushConstantStages;
+
+    if (bElide && bCached && bSameRange && offset >= pushConstantBegin && offset + size <= pushConstantEnd &&
+        memcmp(pushConstants + offset, values, size) == 0) {
+        CountElided(stats.elidedPushConstants);
+        return;
+    }
+
+    deviceTable->vkCmdPushConstants(commandBuffer, layout, stageFlags, offset, size, values);
+    stats.issuedCalls++;
+
+    if (!bCached) {
+        pushConstantLayout = VK_NULL_HANDLE;
+        pushConstantEnd = pushConstantBegin = 0;
+        return;
+    }
+
+    // Keep one contiguous known range, a disjoint push replaces it
+    if (bSameRange && offset <= pushConstantEnd && offset + size >= pushConstantBegin && pushConstantEnd > pushConstantBegin) {
+        pushConstantBegin = std::min(pushConstantBegin, offset);
+        pushConstantEnd = std::max(pushConstantEnd, offset + size);
+    } else {
+        pushConstantBegin = offset;
+        pushConstantEnd = offset + size;
+    }
+    pushConstantLayout = layout;
+    pushConstantStages = stageFlags;
+    memcpy(pushConstants + offset, values, size);
+}
+
+void KonideCommandRecorder::SetViewport(uint32_t firstViewport, uint32_t count, const VkViewport* newViewports)
+{
+    // Viewports are only cached as a prefix starting at 0
+    bool bCached = firstViewport <= viewportCount && firstViewport + count <= KONIDE_RECORDER_MAX_VIEWPORTS;
+
+    if (bElide && bCached && firstViewport + count <= viewportCount &&
+        memcmp(&viewports[firstViewport], newViewports, count * sizeof(VkViewport)) == 0) {
+        CountElided(stats.elidedDynamicState);
+        return;
+    }
+
+    deviceTable->vkCmdSetViewport(commandBuffer, firstViewport, count, newViewports);
+    stats.issuedCalls++;
+
+    if (bCached) {
+        memcpy(&viewports[firstViewport], newViewports, count * sizeof(VkViewport));
+        viewportCount = std::max(viewportCount, firstViewport + count);
+    }
+}
+
+void KonideCommandRecorder::SetScissor(uint32_t firstScissor, uint32_t count, const VkRect2D* newScissors)
+{
+    bool bCached = firstScissor <= scissorCount && firstScissor + count <= KONIDE_RECORDER_MAX_VIEWPORTS;
+
+    if (bElide && bCached && firstScissor + count <= scissorCount &&
+        memcmp(&scissors[firstScissor], newScissors, count * sizeof(VkRect2D)) == 0) {
+        CountElided(stats.elidedDynamicState);
+        return;
+    }
+
+    deviceTable->vkCmdSetScissor(commandBuffer, firstScissor, count, newScissors);
+    stats.issuedCalls++;
+
+    if (bCached) {
+        memcpy(&scissors[firstScissor], newScissors, count * sizeof(VkRect2D));
+        scissorCount = std::max(scissorCount, firstScissor + count);
+    }
+}
+
+void KonideCommandRecorder::SetLineWidth(float newLineWidth)
+{
+    if (bElide && (validDynamicState & KONIDE_RECORDER_DYNAMIC_LINE_WIDTH) && lineWidth == newLineWidth) {
+        CountElided(stats.elidedDynamicState);
+        return;
+    }
+
+    deviceTable->vkCmdSetLineWidth(commandBuffer, newLineWidth);
+    stats.issuedCalls++;
+
+    lineWidth = newLineWidth;
+    validDynamicState |= KONIDE_RECORDER_DYNAMIC_LINE_WIDTH;
+}
+
+void KonideCommandRecorder::SetDepthBias(float constantFactor, float clamp, float slopeFactor)
+{
+    if (bElide && (validDynamicState & KONIDE_RECORDER_DYNAMIC_DEPTH_BIAS) && depthBias[0] == constantFactor && depthBias[1] == clamp &&
+        depthBias[2] == slopeFactor) {
+        CountElided(stats.elidedDynamicState);
+        return;
+    }
+
+    deviceTable->vkCmdSetDepthBias(commandBuffer, constantFactor, clamp, slopeFactor);
+    stats.issuedCalls++;
+
+    depthBias[0] = constantFactor;
+    depthBias[1] = clamp;
+    depthBias[2] = slopeFactor;
+    validDynamicState |= KONIDE_RECORDER_DYNAMIC_DEPTH_BIAS;
+}
+
+void KonideCommandRecorder::SetBlendConstants(const float newBlendConstants[4])
+{
+    if (bElide && (validDynamicState & KONIDE_RECORDER_DYNAMIC_BLEND_CONSTANTS) && memcmp(blendConstants, newBlendConstants, sizeof(blendConstants)) == 0) {
+        CountElided(stats.elidedDynamicState);
+        return;
+    }
+
+    deviceTable->vkCmdSetBlendConstants(commandBuffer, newBlendConstants);
+    stats.issuedCalls++;
+
+    memcpy(blendConstants, newBlendConstants, sizeof(blendConstants));
+    validDynamicState |= KONIDE_RECORDER_DYNAMIC_BLEND_CONSTANTS;
+}
+
+void KonideCommandRecorder::SetStencilReference(VkStencilFaceFlags faceMask, uint32_t reference)
+{
+    uint32_t faces = faceMask & (VK_STENCIL_FACE_FRONT_BIT | VK_STENCIL_FACE_BACK_BIT);
+    bool bSame = (stencilFaces & faces) == faces;
+    if (faces & VK_STENCIL_FACE_FRONT_BIT) {
+        bSame = bSame && stencilReference[0] == reference;
+    }
+    if (faces & VK_STENCIL_FACE_BACK_BIT) {
+        bSame = bSame && stencilReference[1] == reference;
+    }
+
+    if (bElide && bSame) {
+        CountElided(stats.elidedDynamicState);
+        return;
+    }
+
+    deviceTable->vkCmdSetStencilReference(commandBuffer, faceMask, reference);
+    stats.issuedCalls++;
+
+    if (faces & VK_STENCIL_FACE_FRONT_BIT) {
+        stencilReference[0] = reference;
+    }
+    if (faces & VK_STENCIL_FACE_BACK_BIT) {
+        stencilReference[1] = reference;
+    }
+    stencilFaces |= faces;
+}
+
+void KonideCommandRecorder::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    deviceTable->vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+void KonideCommandRecorder::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    deviceTable->vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+void KonideCommandRecorder::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    deviceTable->vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+void KonideCommandRecorder::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy* regions)
+{
+    deviceTable->vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, regionCount, regions);
+}
+
+void KonideCommandRecorder::CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkBufferImageCopy* regions)
+{
+    deviceTable->vkCmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, regions);
+}
@@ -1,12 +1,21 @@
 #include <konide/composition.h>
 
+#include <algorithm>
+
 KonideComposition::KonideComposition(VkSurfaceKHR surface)
 {
-
+    // The swapchain is built by the renderer once the composition has a size
+    swapchain.surface = surface;
 }
 
 uint32_t KonideComposition::AddLayer(KonideLayer* proxy) {
-    return 0;
+    Layers.push_back(proxy);
+    return Layers.size()-1;
+}
+
+void KonideComposition::RemoveLayer(KonideLayer* layer)
+{
+    Layers.erase(std::remove(Layers.begin(), Layers.end(), layer), Layers.end());
 }
 
 void KonideComposition::Render(VkCommandBuffer commandBuffer, VkDevice device)
@@ -0,0 +1,68 @@
+#include <konide/drawsort.h>
+
+#include <cstring>
+
+// Below this an insertion sort beats setting up the histograms
+#define KONIDE_RADIX_SORT_THRESHOLD 64
+
+void KonideRadixSorter::Sort(KonideDrawSortItem* items, uint32_t count)
+{
+    stats.sorts++;
+    stats.keysSorted += count;
+
+    if (count <= KONIDE_RADIX_SORT_THRESHOLD) {
+        for (uint32_t i = 1; i < count; i++) {
+            KonideDrawSortItem item = items[i];
+            uint32_t j = i;
+            for (; j > 0 && items[j - 1].key > item.key; j--) {
+                items[j] = items[j - 1];
+            }
+            items[j] = item;
+        }
+        return;
+    }
+
+    if (scratch.size() < count) {
+        scratch.resize(count);
+    }
+
+    uint32_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t key = items[i].key;
+        for (uint32_t byte = 0; byte < 8; byte++) {
+            histograms[byte][(key >> (byte * 8)) & 0xff]++;
+        }
+    }
+
+    KonideDrawSortItem* src = items;
+    KonideDrawSortItem* dst = scratch.data();
+
+    for (uint32_t byte = 0; byte < 8; byte++) {
+        uint32_t shift = byte * 8;
+        uint32_t* histogram = histograms[byte];
+
+        if (histogram[(items[0].key >> shift) & 0xff] == count) {
+            stats.skippedPasses++;
+            continue;
+        }
+        stats.passes++;
+
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < 256; digit++) {
+            uint32_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            dst[histogram[(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+
+        std::swap(src, dst);
+    }
+
+    if (src != items) {
+        memcpy(items, src, count * sizeof(KonideDrawSortItem));
+    }
+}
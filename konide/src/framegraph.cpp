@@ -0,0 +1,789 @@
+#include <konide/framegraph.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+// Accesses that make a pass a producer of what it touches
+static constexpr VkAccessFlags2 WriteAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT |
+    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+static const char* InternalLayoutName(VkImageLayout layout)
+{
+    switch (layout) {
+    case VK_IMAGE_LAYOUT_UNDEFINED: return "UNDEFINED";
+    case VK_IMAGE_LAYOUT_GENERAL: return "GENERAL";
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "COLOR_ATTACHMENT";
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "DEPTH_STENCIL_ATTACHMENT";
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "SHADER_READ_ONLY";
+    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "TRANSFER_SRC";
+    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "TRANSFER_DST";
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "PRESENT_SRC";
+    default: return "OTHER";
+    }
+}
+
+static double InternalMilliseconds(double seconds)
+{
+    return seconds * 1000.0;
+}
+
+void KonideFrameGraphPassBuilder::AddAccess(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkImageLayout layout, bool bWrite,
+    const VkImageSubresourceRange* range)
+{
+    if (resource >= graph.resources.size()) {
+        throw std::runtime_error("frame graph pass uses an unknown resource.");
+    }
+
+    KonideFrameGraphPass& pass = graph.passes[passIdx];
+
+    VkImageSubresourceRange accessRange = {};
+    if (range) {
+        accessRange = *range;
+    }
+
+    for (KonideFrameGraphAccess& access : pass.accesses) {
+        if (access.resource != resource) {
+            continue;
+        }
+
+        // Different subresources of one image are separate accesses
+        if (access.range.baseMipLevel != accessRange.baseMipLevel || access.range.levelCount != accessRange.levelCount ||
+            access.range.baseArrayLayer != accessRange.baseArrayLayer || access.range.layerCount != accessRange.layerCount) {
+            continue;
+        }
+
+        // One image can only be in one layout for the whole pass
+        if (layout != VK_IMAGE_LAYOUT_UNDEFINED && access.layout != VK_IMAGE_LAYOUT_UNDEFINED && access.layout != layout) {
+            access.layout = VK_IMAGE_LAYOUT_GENERAL;
+        } else if (layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+            access.layout = layout;
+        }
+
+        access.stageMask |= stageMask;
+        access.accessMask |= accessMask;
+        access.bWrite = access.bWrite || bWrite;
+        return;
+    }
+
+    KonideFrameGraphAccess access;
+    access.resource = resource;
+    access.stageMask = stageMask;
+    access.accessMask = accessMask;
+    access.layout = layout;
+    access.bWrite = bWrite;
+    access.range = accessRange;
+    pass.accesses.push_back(access);
+}
+
+KonideFrameGraphResource KonideFrameGraphPassBuilder::CreateImage(const std::string& name, const KonideFrameGraphImageDesc& desc)
+{
+    KonideFrameGraphResourceNode node;
+    node.name = name;
+    node.type = KONIDE_FRAME_GRAPH_IMAGE;
+    node.imageDesc = desc;
+    node.range.aspectMask = desc.aspect;
+    node.range.levelCount = desc.mipLevels;
+    node.range.layerCount = desc.arrayLayers;
+
+    graph.resources.push_back(node);
+    return (KonideFrameGraphResource)graph.resources.size() - 1;
+}
+
+KonideFrameGraphResource KonideFrameGraphPassBuilder::CreateBuffer(const std::string& name, const KonideFrameGraphBufferDesc& desc)
+{
+    KonideFrameGraphResourceNode node;
+    node.name = name;
+    node.type = KONIDE_FRAME_GRAPH_BUFFER;
+    node.bufferDesc = desc;
+
+    graph.resources.push_back(node);
+    return (KonideFrameGraphResource)graph.resources.size() - 1;
+}
+
+void KonideFrameGraphPassBuilder::Read(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkImageLayout layout,
+    const VkImageSubresourceRange* range)
+{
+    AddAccess(resource, stageMask, accessMask, layout, false, range);
+}
+
+void KonideFrameGraphPassBuilder::Write(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, VkImageLayout layout,
+    const VkImageSubresourceRange* range)
+{
+    AddAccess(resource, stageMask, accessMask, layout, true, range);
+}
+
+void KonideFrameGraphPassBuilder::ColorAttachment(KonideFrameGraphResource resource)
+{
+    AddAccess(resource, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true, nullptr);
+}
+
+void KonideFrameGraphPassBuilder::SampledImage(KonideFrameGraphResource resource, VkPipelineStageFlags2 stageMask)
+{
+    AddAccess(resource, stageMask, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false, nullptr);
+}
+
+void KonideFrameGraphPassBuilder::TransferDst(KonideFrameGraphResource resource)
+{
+    AddAccess(resource, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true, nullptr);
+}
+
+void KonideFrameGraphPassBuilder::SetSideEffects()
+{
+    graph.passes[passIdx].bSideEffects = true;
+}
+
+KonideFrameGraph::~KonideFrameGraph()
+{
+    Shutdown();
+}
+
+void KonideFrameGraph::Initialize(VkDevice newDevice, const KonideDeviceTable& newDeviceTable, const VkPhysicalDeviceMemoryProperties& newMemoryProperties, std::function<void(std::function<void()>)> newDeferDestruction)
+{
+    device = newDevice;
+    deviceTable = &newDeviceTable;
+    deferDestruction = std::move(newDeferDestruction);
+    memoryProperties = newMemoryProperties;
+}
+
+void KonideFrameGraph::Shutdown()
+{
+    if (!device) {
+        return;
+    }
+
+    // Nothing is in flight anymore, skip the deferral
+    deferDestruction = nullptr;
+    ReleaseTransients();
+    device = VK_NULL_HANDLE;
+}
+
+void KonideFrameGraph::Reset()
+{
+    resources.clear();
+    passes.clear();
+    finalImageBarriers.clear();
+    finalBufferBarriers.clear();
+    bCompiled = false;
+}
+
+KonideFrameGraphResource KonideFrameGraph::ImportImage(const std::string& name, VkImage image, VkImageView imageView, const VkImageSubresourceRange& range,
+    VkImageLayout initialLayout, VkPipelineStageFlags2 initialStageMask, VkImageLayout finalLayout)
+{
+    KonideFrameGraphResourceNode node;
+    node.name = name;
+    node.type = KONIDE_FRAME_GRAPH_IMAGE;
+    node.bImported = true;
+    node.initialLayout = initialLayout;
+    node.initialStageMask = initialStageMask;
+    node.finalLayout = finalLayout;
+    node.image = image;
+    node.imageView = imageView;
+    node.range = range;
+
+    resources.push_back(node);
+    return (KonideFrameGraphResource)resources.size() - 1;
+}
+
+KonideFrameGraphResource KonideFrameGraph::ImportBuffer(const std::string& name, VkBuffer buffer, VkDeviceSize size,
+    VkPipelineStageFlags2 initialStageMask, VkAccessFlags2 initialAccessMask)
+{
+    KonideFrameGraphResourceNode node;
+    node.name = name;
+    node.type = KONIDE_FRAME_GRAPH_BUFFER;
+    node.bImported = true;
+    node.initialStageMask = initialStageMask;
+    node.initialAccessMask = initialAccessMask;
+    node.buffer = buffer;
+    node.bufferDesc.size = size;
+
+    resources.push_back(node);
+    return (KonideFrameGraphResource)resources.size() - 1;
+}
+
+uint32_t KonideFrameGraph::AddPass(const std::string& name, const std::function<void(KonideFrameGraphPassBuilder&)>& setup, std::function<void(VkCommandBuffer)> execute)
+{
+    KonideFrameGraphPass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    passes.push_back(std::move(pass));
+
+    uint32_t passIdx = (uint32_t)passes.size() - 1;
+
+    KonideFrameGraphPassBuilder builder(*this, passIdx);
+    if (setup) {
+        setup(builder);
+    }
+
+    return passIdx;
+}
+
+void KonideFrameGraph::CullPasses()
+{
+    // Walk backwards keeping passes that have side effects, write an imported resource or write
+    // something a later live pass reads. Reads of a live pass make their writers live in turn.
+    std::vector<bool> needed(resources.size(), false);
+
+    for (uint32_t passIdx = (uint32_t)passes.size(); passIdx-- > 0;) {
+        KonideFrameGraphPass& pass = passes[passIdx];
+
+        bool bLive = pass.bSideEffects;
+        for (const KonideFrameGraphAccess& access : pass.accesses) {
+            if (access.bWrite && (resources[access.resource].bImported || needed[access.resource])) {
+                bLive = true;
+            }
+        }
+
+        pass.bCulled = !bLive;
+        if (!bLive) {
+            stats.culledPasses++;
+            continue;
+        }
+
+        // A pass that only writes a resource fully produces it, earlier writers are dead unless it also reads
+        for (const KonideFrameGraphAccess& access : pass.accesses) {
+            if (access.bWrite) {
+                needed[access.resource] = false;
+            }
+        }
+        for (const KonideFrameGraphAccess& access : pass.accesses) {
+            if (!access.bWrite || (access.accessMask & ~WriteAccessMask)) {
+                needed[access.resource] = true;
+            }
+        }
+    }
+}
+
+void KonideFrameGraph::ComputeLifetimes()
+{
+    for (uint32_t passIdx = 0; passIdx < passes.size(); passIdx++) {
+        if (passes[passIdx].bCulled) {
+            continue;
+        }
+
+        for (const KonideFrameGraphAccess& access : passes[passIdx].accesses) {
+            KonideFrameGraphResourceNode& node = resources[access.resource];
+            node.firstPass = std::min(node.firstPass, passIdx);
+            node.lastPass = std::max(node.lastPass, passIdx);
+        }
+    }
+}
+
+std::string KonideFrameGraph::BuildTransientSignature() const
+{
+    std::string signature;
+    char entry[160];
+
+    for (size_t i = 0; i < resources.size(); i++) {
+        const KonideFrameGraphResourceNode& node = resources[i];
+        if (node.bImported || node.firstPass == UINT32_MAX) {
+            continue;
+        }
+
+        if (node.type == KONIDE_FRAME_GRAPH_IMAGE) {
+            snprintf(entry, sizeof(entry), "i%zu:%d:%ux%u:%ux%u:%x:%x:%u-%u;", i, (int)node.imageDesc.format, node.imageDesc.extent.width,
+                node.imageDesc.extent.height, node.imageDesc.mipLevels, node.imageDesc.arrayLayers, node.imageDesc.usage, node.imageDesc.aspect,
+                node.firstPass, node.lastPass);
+        } else {
+            snprintf(entry, sizeof(entry), "b%zu:%llu:%x:%u-%u;", i, (unsigned long long)node.bufferDesc.size, node.bufferDesc.usage,
+                node.firstPass, node.lastPass);
+        }
+        signature += entry;
+    }
+
+    return signature;
+}
+
+uint32_t KonideFrameGraph::FindMemoryType(uint32_t typeBits) const
+{
+    // Prefer device local memory, any allowed type beats failing
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+            return i;
+        }
+    }
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if (typeBits & (1u << i)) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("no memory type fits frame graph transient resources.");
+}
+
+void KonideFrameGraph::ReleaseTransients()
+{
+    if (transients.empty() && memoryBlocks.empty()) {
+        return;
+    }
+
+    std::vector<KonideFrameGraphTransient> retiredTransients;
+    retiredTransients.swap(transients);
+
+    std::vector<VkDeviceMemory> retiredMemory;
+    for (KonideFrameGraphMemoryBlock& block : memoryBlocks) {
+        retiredMemory.push_back(block.memory);
+    }
+    memoryBlocks.clear();
+    transientSignature.clear();
+
+    VkDevice destroyDevice = device;
+    const KonideDeviceTable* destroyTable = deviceTable;
+    auto destroy = [destroyDevice, destroyTable, retiredTransients, retiredMemory]() {
+        for (const KonideFrameGraphTransient& transient : retiredTransients) {
+            if (transient.imageView) destroyTable->vkDestroyImageView(destroyDevice, transient.imageView, nullptr);
+            if (transient.image) destroyTable->vkDestroyImage(destroyDevice, transient.image, nullptr);
+            if (transient.buffer) destroyTable->vkDestroyBuffer(destroyDevice, transient.buffer, nullptr);
+        }
+        for (VkDeviceMemory memory : retiredMemory) {
+            destroyTable->vkFreeMemory(destroyDevice, memory, nullptr);
+        }
+    };
+
+    // Frames in flight may still use the old objects
+    if (deferDestruction) {
+        deferDestruction(destroy);
+    } else {
+        destroy();
+    }
+}
+
+void KonideFrameGraph::AllocateTransients()
+{
+    std::string signature = BuildTransientSignature();
+
+    // Same shape as last frame, the objects and their placement still fit
+    if (signature != transientSignature || signature.empty()) {
+        ReleaseTransients();
+        transientSignature = signature;
+
+        for (size_t i = 0; i < resources.size(); i++) {
+            const KonideFrameGraphResourceNode& node = resources[i];
+            if (node.bImported || node.firstPass == UINT32_MAX) {
+                continue;
+            }
+
+            KonideFrameGraphTransient transient;
+            transient.resource = (KonideFrameGraphResource)i;
+
+            if (node.type == KONIDE_FRAME_GRAPH_IMAGE) {
+                VkImageCreateInfo imageInfo{};
+                imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+                imageInfo.imageType = VK_IMAGE_TYPE_2D;
+                imageInfo.format = node.imageDesc.format;
+                imageInfo.extent = { node.imageDesc.extent.width, node.imageDesc.extent.height, 1 };
+                imageInfo.mipLevels = node.imageDesc.mipLevels;
+                imageInfo.arrayLayers = node.imageDesc.arrayLayers;
+                imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+                imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+                imageInfo.usage = node.imageDesc.usage;
+                imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+                if (deviceTable->vkCreateImage(device, &imageInfo, nullptr, &transient.image) != VK_SUCCESS) {
+                    throw std::runtime_error("failed to create frame graph image.");
+                }
+                deviceTable->vkGetImageMemoryRequirements(device, transient.image, &transient.memoryRequirements);
+            } else {
+                VkBufferCreateInfo bufferInfo{};
+                bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferInfo.size = node.bufferDesc.size;
+                bufferInfo.usage = node.bufferDesc.usage;
+                bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+                if (deviceTable->vkCreateBuffer(device, &bufferInfo, nullptr, &transient.buffer) != VK_SUCCESS) {
+                    throw std::runtime_error("failed to create frame graph buffer.");
+                }
+                deviceTable->vkGetBufferMemoryRequirements(device, transient.buffer, &transient.memoryRequirements);
+            }
+
+            transients.push_back(transient);
+        }
+
+        // Biggest first, so smaller resources fill blocks that are already large enough
+        std::vector<size_t> order(transients.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return transients[a].memoryRequirements.size > transients[b].memoryRequirements.size;
+        });
+
+        for (size_t transientIdx : order) {
+            KonideFrameGraphTransient& transient = transients[transientIdx];
+            const KonideFrameGraphResourceNode& node = resources[transient.resource];
+
+            int32_t bestBlock = -1;
+            for (size_t blockIdx = 0; blockIdx < memoryBlocks.size(); blockIdx++) {
+                KonideFrameGraphMemoryBlock& block = memoryBlocks[blockIdx];
+                if (!(block.memoryTypeBits & transient.memoryRequirements.memoryTypeBits)) {
+                    continue;
+                }
+
+                bool bOverlaps = false;
+                for (KonideFrameGraphResource occupant : block.occupants) {
+                    const KonideFrameGraphResourceNode& other = resources[occupant];
+                    if (other.firstPass <= node.lastPass && node.firstPass <= other.lastPass) {
+                        bOverlaps = true;
+                        break;
+                    }
+                }
+                if (bOverlaps) {
+                    continue;
+                }
+
+                // Best fit: the block that grows least, or the smallest one that is already big enough
+                if (bestBlock < 0 || block.size < memoryBlocks[bestBlock].size) {
+                    bestBlock = (int32_t)blockIdx;
+                }
+            }
+
+            if (bestBlock < 0) {
+                memoryBlocks.push_back(KonideFrameGraphMemoryBlock());
+                bestBlock = (int32_t)memoryBlocks.size() - 1;
+            }
+
+            KonideFrameGraphMemoryBlock& block = memoryBlocks[bestBlock];
+            block.size = std::max(block.size, transient.memoryRequirements.size);
+            block.memoryTypeBits &= transient.memoryRequirements.memoryTypeBits;
+            block.occupants.push_back(transient.resource);
+            transient.memoryBlock = bestBlock;
+        }
+
+        // Every occupant starts at offset 0, only one of them is alive at any point of the frame
+        for (KonideFrameGraphMemoryBlock& block : memoryBlocks) {
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = block.size;
+            allocInfo.memoryTypeIndex = FindMemoryType(block.memoryTypeBits);
+
+            if (deviceTable->vkAllocateMemory(device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) {
+                throw std::runtime_error("failed to allocate frame graph memory.");
+            }
+
+            // Nothing ran in the new memory yet
+            block.lastStageMask = VK_PIPELINE_STAGE_2_NONE;
+            block.lastAccessMask = VK_ACCESS_2_NONE;
+        }
+
+        for (KonideFrameGraphTransient& transient : transients) {
+            const KonideFrameGraphResourceNode& node = resources[transient.resource];
+            VkDeviceMemory memory = memoryBlocks[transient.memoryBlock].memory;
+
+            if (transient.image) {
+                deviceTable->vkBindImageMemory(device, transient.image, memory, 0);
+
+                VkImageViewCreateInfo viewInfo{};
+                viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                viewInfo.image = transient.image;
+                viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.format = node.imageDesc.format;
+                viewInfo.subresourceRange = node.range;
+
+                if (deviceTable->vkCreateImageView(device, &viewInfo, nullptr, &transient.imageView) != VK_SUCCESS) {
+                    throw std::runtime_error("failed to create frame graph image view.");
+                }
+            } else {
+                deviceTable->vkBindBufferMemory(device, transient.buffer, memory, 0);
+            }
+        }
+
+        stats.transientMemory = 0;
+        stats.unaliasedMemory = 0;
+        for (const KonideFrameGraphMemoryBlock& block : memoryBlocks) {
+            stats.transientMemory += block.size;
+        }
+        for (const KonideFrameGraphTransient& transient : transients) {
+            stats.unaliasedMemory += transient.memoryRequirements.size;
+        }
+    }
+
+    for (const KonideFrameGraphTransient& transient : transients) {
+        KonideFrameGraphResourceNode& node = resources[transient.resource];
+        node.image = transient.image;
+        node.imageView = transient.imageView;
+        node.buffer = transient.buffer;
+        node.memoryBlock = transient.memoryBlock;
+    }
+}
+
+void KonideFrameGraph::BuildBarriers()
+{
+    // Last frame's images may be gone or reused, every resource starts over
+    tracker.Clear();
+    tracker.ResetStats();
+
+    for (const KonideFrameGraphResourceNode& node : resources) {
+        if (!node.bImported) {
+            continue;
+        }
+
+        if (node.type == KONIDE_FRAME_GRAPH_IMAGE) {
+            tracker.RegisterImage(node.image, node.range.aspectMask, node.range.baseMipLevel + node.range.levelCount,
+                node.range.baseArrayLayer + node.range.layerCount, node.initialLayout, node.initialStageMask, node.initialAccessMask);
+        } else {
+            tracker.RegisterBuffer(node.buffer, node.initialStageMask, node.initialAccessMask);
+        }
+    }
+
+    for (uint32_t passIdx = 0; passIdx < passes.size(); passIdx++) {
+        KonideFrameGraphPass& pass = passes[passIdx];
+        pass.imageBarriers.clear();
+        pass.bufferBarriers.clear();
+
+        if (pass.bCulled) {
+            continue;
+        }
+
+        for (KonideFrameGraphAccess& access : pass.accesses) {
+            const KonideFrameGraphResourceNode& node = resources[access.resource];
+            bool bImage = node.type == KONIDE_FRAME_GRAPH_IMAGE;
+
+            // Transients start where the previous occupant of their memory left off, contents are discarded
+            if (!node.bImported && node.firstPass == passIdx && !(bImage ? tracker.IsTracked(node.image) : tracker.IsTracked(node.buffer))) {
+                const KonideFrameGraphMemoryBlock& block = memoryBlocks[node.memoryBlock];
+                if (bImage) {
+                    tracker.RegisterImage(node.image, node.range.aspectMask, node.imageDesc.mipLevels, node.imageDesc.arrayLayers,
+                        VK_IMAGE_LAYOUT_UNDEFINED, block.lastStageMask, block.lastAccessMask);
+                } else {
+                    tracker.RegisterBuffer(node.buffer, block.lastStageMask, block.lastAccessMask);
+                }
+            }
+
+            if (bImage) {
+                const VkImageSubresourceRange& range = access.range.levelCount ? access.range : node.range;
+                access.bContentsDefined = tracker.GetLayout(node.image, range.baseMipLevel, range.baseArrayLayer) != VK_IMAGE_LAYOUT_UNDEFINED;
+
+                VkImageLayout layout = access.layout != VK_IMAGE_LAYOUT_UNDEFINED ? access.layout : VK_IMAGE_LAYOUT_GENERAL;
+                tracker.RequestImage(node.image, range, layout, access.stageMask, access.accessMask, access.bWrite);
+            } else {
+                access.bContentsDefined = true;
+                tracker.RequestBuffer(node.buffer, access.stageMask, access.accessMask, access.bWrite);
+            }
+            access.bContentsUsed = node.bImported || node.lastPass > passIdx;
+        }
+
+        // Accesses of one pass never overlap, so everything fits one batch
+        tracker.TakeBatch(pass.imageBarriers, pass.bufferBarriers);
+
+        // Hand the memory over to the next occupant
+        for (const KonideFrameGraphAccess& access : pass.accesses) {
+            const KonideFrameGraphResourceNode& node = resources[access.resource];
+            if (!node.bImported && node.lastPass == passIdx) {
+                KonideFrameGraphMemoryBlock& block = memoryBlocks[node.memoryBlock];
+                if (node.type == KONIDE_FRAME_GRAPH_IMAGE) {
+                    tracker.GetLastUse(node.image, block.lastStageMask, block.lastAccessMask);
+                } else {
+                    tracker.GetLastUse(node.buffer, block.lastStageMask, block.lastAccessMask);
+                }
+            }
+        }
+    }
+
+    // Imported images leave the graph in the layout their owner expects, e.g. PRESENT_SRC.
+    // Whatever consumes them next synchronizes through its own semaphore or barrier.
+    finalImageBarriers.clear();
+    finalBufferBarriers.clear();
+    for (const KonideFrameGraphResourceNode& node : resources) {
+        if (node.bImported && node.type == KONIDE_FRAME_GRAPH_IMAGE && node.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
+            tracker.RequestImage(node.image, node.range, node.finalLayout, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, false);
+        }
+    }
+    tracker.TakeBatch(finalImageBarriers, finalBufferBarriers);
+
+    const KonideLayoutTrackerStats& trackerStats = tracker.GetStats();
+    stats.barrierBatches = (uint32_t)trackerStats.barrierBatches;
+    stats.imageBarriers = (uint32_t)trackerStats.imageBarriers;
+    stats.bufferBarriers = (uint32_t)trackerStats.bufferBarriers;
+    stats.layoutTransitions = (uint32_t)trackerStats.layoutTransitions;
+}
+
+void KonideFrameGraph::Compile()
+{
+    std::chrono::steady_clock::time_point compileStart = std::chrono::steady_clock::now();
+
+    // Memory totals belong to the allocation, which may be reused as is
+    VkDeviceSize transientMemory = stats.transientMemory;
+    VkDeviceSize unaliasedMemory = stats.unaliasedMemory;
+    stats = KonideFrameGraphStats();
+    stats.transientMemory = transientMemory;
+    stats.unaliasedMemory = unaliasedMemory;
+    stats.passes = (uint32_t)passes.size();
+
+    CullPasses();
+    ComputeLifetimes();
+    AllocateTransients();
+    BuildBarriers();
+
+    bCompiled = true;
+    stats.compileTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - compileStart).count();
+}
+
+void KonideFrameGraph::Execute(VkCommandBuffer commandBuffer)
+{
+    if (!bCompiled) {
+        Compile();
+    }
+
+    std::chrono::steady_clock::time_point executeStart = std::chrono::steady_clock::now();
+
+    for (uint32_t passIdx = 0; passIdx < passes.size(); passIdx++) {
+        KonideFrameGraphPass& pass = passes[passIdx];
+        if (pass.bCulled) {
+            pass.recordTime = 0.0;
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point passStart = std::chrono::steady_clock::now();
+
+        // Everything the pass needs goes into a single barrier call
+        if (!pass.imageBarriers.empty() || !pass.bufferBarriers.empty()) {
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.imageMemoryBarrierCount = (uint32_t)pass.imageBarriers.size();
+            dependencyInfo.pImageMemoryBarriers = pass.imageBarriers.data();
+            dependencyInfo.bufferMemoryBarrierCount = (uint32_t)pass.bufferBarriers.size();
+            dependencyInfo.pBufferMemoryBarriers = pass.bufferBarriers.data();
+            deviceTable->vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+        }
+
+        if (pass.execute) {
+            executingPass = passIdx;
+            pass.execute(commandBuffer);
+            executingPass = UINT32_MAX;
+        }
+
+        pass.recordTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - passStart).count();
+    }
+
+    if (!finalImageBarriers.empty() || !finalBufferBarriers.empty()) {
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.imageMemoryBarrierCount = (uint32_t)finalImageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = finalImageBarriers.data();
+        dependencyInfo.bufferMemoryBarrierCount = (uint32_t)finalBufferBarriers.size();
+        dependencyInfo.pBufferMemoryBarriers = finalBufferBarriers.data();
+        deviceTable->vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    }
+
+    stats.executeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - executeStart).count();
+}
+
+VkAttachmentLoadOp KonideFrameGraph::GetAttachmentLoadOp(KonideFrameGraphResource resource, VkAttachmentLoadOp requested) const
+{
+    if (executingPass == UINT32_MAX) {
+        throw std::runtime_error("attachment ops are only known while a pass executes.");
+    }
+
+    for (const KonideFrameGraphAccess& access : passes[executingPass].accesses) {
+        if (access.resource == resource) {
+            return requested == VK_ATTACHMENT_LOAD_OP_LOAD && !access.bContentsDefined ? VK_ATTACHMENT_LOAD_OP_DONT_CARE : requested;
+        }
+    }
+
+    throw std::runtime_error("attachment isn't used by the executing pass.");
+}
+
+VkAttachmentStoreOp KonideFrameGraph::GetAttachmentStoreOp(KonideFrameGraphResource resource) const
+{
+    if (executingPass == UINT32_MAX) {
+        throw std::runtime_error("attachment ops are only known while a pass executes.");
+    }
+
+    for (const KonideFrameGraphAccess& access : passes[executingPass].accesses) {
+        if (access.resource == resource) {
+            return access.bContentsUsed ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        }
+    }
+
+    throw std::runtime_error("attachment isn't used by the executing pass.");
+}
+
+std::string KonideFrameGraph::Dump() const
+{
+    std::string dump;
+    char line[512];
+
+    auto resourceName = [this](VkImage image, VkBuffer buffer) -> const char* {
+        for (const KonideFrameGraphResourceNode& node : resources) {
+            if ((image && node.image == image) || (buffer && node.buffer == buffer)) {
+                return node.name.c_str();
+            }
+        }
+        return "?";
+    };
+
+    auto dumpImageBarrier = [&](const VkImageMemoryBarrier2& barrier) {
+        snprintf(line, sizeof(line), "    barrier image \"%s\" %s -> %s, stages 0x%llx -> 0x%llx, access 0x%llx -> 0x%llx\n",
+            resourceName(barrier.image, VK_NULL_HANDLE), InternalLayoutName(barrier.oldLayout), InternalLayoutName(barrier.newLayout),
+            (unsigned long long)barrier.srcStageMask, (unsigned long long)barrier.dstStageMask,
+            (unsigned long long)barrier.srcAccessMask, (unsigned long long)barrier.dstAccessMask);
+        dump += line;
+    };
+
+    snprintf(line, sizeof(line), "frame graph: %u passes, %u culled, %u barrier batches (%u image, %u buffer barriers, %u layout transitions)\n",
+        stats.passes, stats.culledPasses, stats.barrierBatches, stats.imageBarriers, stats.bufferBarriers, stats.layoutTransitions);
+    dump += line;
+    snprintf(line, sizeof(line), "transient memory: %llu bytes in %zu blocks, %llu bytes without aliasing\n",
+        (unsigned long long)stats.transientMemory, memoryBlocks.size(), (unsigned long long)stats.unaliasedMemory);
+    dump += line;
+    snprintf(line, sizeof(line), "cpu time: compile %.3f ms, execute %.3f ms\n", InternalMilliseconds(stats.compileTime), InternalMilliseconds(stats.executeTime));
+    dump += line;
+
+    for (size_t passIdx = 0; passIdx < passes.size(); passIdx++) {
+        const KonideFrameGraphPass& pass = passes[passIdx];
+
+        if (pass.bCulled) {
+            snprintf(line, sizeof(line), "pass %zu \"%s\": culled\n", passIdx, pass.name.c_str());
+        } else {
+            snprintf(line, sizeof(line), "pass %zu \"%s\": %.3f ms%s\n", passIdx, pass.name.c_str(), InternalMilliseconds(pass.recordTime),
+                pass.bSideEffects ? ", side effects" : "");
+        }
+        dump += line;
+
+        for (const KonideFrameGraphAccess& access : pass.accesses) {
+            const KonideFrameGraphResourceNode& node = resources[access.resource];
+            snprintf(line, sizeof(line), "    %s \"%s\"%s%s, stages 0x%llx, access 0x%llx\n", access.bWrite ? "write" : "read ", node.name.c_str(),
+                node.type == KONIDE_FRAME_GRAPH_IMAGE ? " as " : "", node.type == KONIDE_FRAME_GRAPH_IMAGE ? InternalLayoutName(access.layout) : "",
+                (unsigned long long)access.stageMask, (unsigned long long)access.accessMask);
+            dump += line;
+        }
+
+        for (const VkImageMemoryBarrier2& barrier : pass.imageBarriers) {
+            dumpImageBarrier(barrier);
+        }
+        for (const VkBufferMemoryBarrier2& barrier : pass.bufferBarriers) {
+            snprintf(line, sizeof(line), "    barrier buffer \"%s\", stages 0x%llx -> 0x%llx, access 0x%llx -> 0x%llx\n",
+                resourceName(VK_NULL_HANDLE, barrier.buffer), (unsigned long long)barrier.srcStageMask, (unsigned long long)barrier.dstStageMask,
+                (unsigned long long)barrier.srcAccessMask, (unsigned long long)barrier.dstAccessMask);
+            dump += line;
+        }
+    }
+
+    if (!finalImageBarriers.empty()) {
+        dump += "final\n";
+        for (const VkImageMemoryBarrier2& barrier : finalImageBarriers) {
+            dumpImageBarrier(barrier);
+        }
+    }
+
+    for (size_t i = 0; i < resources.size(); i++) {
+        const KonideFrameGraphResourceNode& node = resources[i];
+        const char* type = node.type == KONIDE_FRAME_GRAPH_IMAGE ? "image" : "buffer";
+
+        if (node.bImported) {
+            snprintf(line, sizeof(line), "resource %zu \"%s\": imported %s\n", i, node.name.c_str(), type);
+        } else if (node.firstPass == UINT32_MAX) {
+            snprintf(line, sizeof(line), "resource %zu \"%s\": transient %s, unused\n", i, node.name.c_str(), type);
+        } else {
+            snprintf(line, sizeof(line), "resource %zu \"%s\": transient %s, passes %u-%u, block %d\n", i, node.name.c_str(), type,
+                node.firstPass, node.lastPass, node.memoryBlock);
+        }
+        dump += line;
+    }
+
+    return dump;
+}
@@ -0,0 +1,169 @@
+#include <konide/framestats.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static uint64_t InternalSecondsToNanoseconds(double seconds)
+{
+    return seconds > 0.0 ? (uint64_t)(seconds * 1e9) : 0;
+}
+
+static double InternalNanosecondsToSeconds(uint64_t nanoseconds)
+{
+    return (double)nanoseconds * 1e-9;
+}
+
+const char* KonideFramePhaseName(EKonideFramePhase phase)
+{
+    switch (phase) {
+    case KONIDE_FRAME_PHASE_FRAME_WAIT: return "frame wait";
+    case KONIDE_FRAME_PHASE_ACQUIRE_WAIT: return "acquire wait";
+    case KONIDE_FRAME_PHASE_RECORD: return "record";
+    case KONIDE_FRAME_PHASE_SUBMIT: return "submit";
+    case KONIDE_FRAME_PHASE_PRESENT: return "present";
+    case KONIDE_FRAME_PHASE_TOTAL: return "total";
+    default: return "unknown";
+    }
+}
+
+std::string KonideFrameHistogram::ToCSV() const
+{
+    std::string csv = "lower_ms,upper_ms,count\n";
+    char line[96];
+
+    for (size_t i = 0; i < buckets.size(); i++) {
+        snprintf(line, sizeof(line), "%.3f,%.3f,%llu\n",
+            i * bucketWidth * 1000.0, (i + 1) * bucketWidth * 1000.0, (unsigned long long)buckets[i]);
+        csv += line;
+    }
+
+    snprintf(line, sizeof(line), "%.3f,,%llu\n", buckets.size() * bucketWidth * 1000.0, (unsigned long long)overflow);
+    csv += line;
+
+    return csv;
+}
+
+void KonideFrameStats::Record(const KonideFrameTiming& timing)
+{
+    uint64_t index = writeCount.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % KONIDE_FRAME_STATS_CAPACITY];
+
+    // Readers that see an odd or changed sequence drop the slot
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.frame.store(timing.frame, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < KONIDE_FRAME_PHASE_COUNT; i++) {
+        slot.phases[i].store(InternalSecondsToNanoseconds(timing.phases[i]), std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    writeCount.store(index + 1, std::memory_order_release);
+}
+
+bool KonideFrameStats::ReadSlot(uint64_t index, KonideFrameTiming& timing) const
+{
+    const Slot& slot = slots[index % KONIDE_FRAME_STATS_CAPACITY];
+
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2) {
+        return false;
+    }
+
+    timing.frame = slot.frame.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < KONIDE_FRAME_PHASE_COUNT; i++) {
+        timing.phases[i] = InternalNanosecondsToSeconds(slot.phases[i].load(std::memory_order_relaxed));
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+void KonideFrameStats::Snapshot(std::vector<KonideFrameTiming>& timings) const
+{
+    timings.clear();
+
+    uint64_t end = writeCount.load(std::memory_order_acquire);
+    uint64_t begin = end > KONIDE_FRAME_STATS_CAPACITY ? end - KONIDE_FRAME_STATS_CAPACITY : 0;
+    begin = std::max(begin, firstSample.load(std::memory_order_relaxed));
+
+    timings.reserve(end - begin);
+    for (uint64_t index = begin; index < end; index++) {
+        KonideFrameTiming timing;
+        if (ReadSlot(index, timing)) {
+            timings.push_back(timing);
+        }
+    }
+}
+
+void KonideFrameStats::GetPercentiles(EKonideFramePhase phase, const double* percentiles, double* results, uint32_t count) const
+{
+    std::vector<KonideFrameTiming> timings;
+    Snapshot(timings);
+
+    std::vector<double> values;
+    values.reserve(timings.size());
+    for (const KonideFrameTiming& timing : timings) {
+        values.push_back(timing.phases[phase]);
+    }
+    std::sort(values.begin(), values.end());
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (values.empty()) {
+            results[i] = 0.0;
+            continue;
+        }
+
+        double rank = std::ceil(std::clamp(percentiles[i], 0.0, 100.0) / 100.0 * values.size());
+        size_t idx = rank > 0.0 ? (size_t)rank - 1 : 0;
+        results[i] = values[std::min(idx, values.size() - 1)];
+    }
+}
+
+double KonideFrameStats::GetPercentile(EKonideFramePhase phase, double percentile) const
+{
+    double result = 0.0;
+    GetPercentiles(phase, &percentile, &result, 1);
+    return result;
+}
+
+KonideFrameHistogram KonideFrameStats::GetHistogram(EKonideFramePhase phase, double bucketWidth, uint32_t bucketCount) const
+{
+    KonideFrameHistogram histogram;
+    histogram.phase = phase;
+    histogram.bucketWidth = bucketWidth;
+    histogram.buckets.resize(bucketCount, 0);
+
+    if (bucketWidth <= 0.0) {
+        return histogram;
+    }
+
+    std::vector<KonideFrameTiming> timings;
+    Snapshot(timings);
+
+    for (const KonideFrameTiming& timing : timings) {
+        double bucket = timing.phases[phase] / bucketWidth;
+        if (bucket < bucketCount) {
+            histogram.buckets[(size_t)bucket]++;
+        } else {
+            histogram.overflow++;
+        }
+    }
+    histogram.sampleCount = timings.size();
+
+    return histogram;
+}
+
+uint64_t KonideFrameStats::GetSampleCount() const
+{
+    uint64_t end = writeCount.load(std::memory_order_acquire);
+    uint64_t begin = end > KONIDE_FRAME_STATS_CAPACITY ? end - KONIDE_FRAME_STATS_CAPACITY : 0;
+    return end - std::max(begin, std::min(end, firstSample.load(std::memory_order_relaxed)));
+}
+
+void KonideFrameStats::Reset()
+{
+    // The writer keeps its position, older samples just fall out of every query
+    firstSample.store(writeCount.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
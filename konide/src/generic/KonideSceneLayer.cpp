@@ -1,5 +1,4 @@
 #include <konide/generic/KonideSceneLayer.h>
-#include <konide/vulkan/vkloader_symbols.h>
 
 void KonideSceneLayer::Render(VkCommandBuffer cmd, VkDevice device) 
 {
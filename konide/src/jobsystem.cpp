@@ -0,0 +1,315 @@
+#include <konide/jobsystem.h>
+
+#include <algorithm>
+
+static_assert((KONIDE_JOB_DEQUE_CAPACITY & (KONIDE_JOB_DEQUE_CAPACITY - 1)) == 0, "job deque capacity must be a power of two");
+
+static constexpr int64_t JobDequeMask = KONIDE_JOB_DEQUE_CAPACITY - 1;
+// Rounds an idle worker looks for work before going to sleep
+static constexpr uint32_t IdleSpinCount = 64;
+
+// Lets a thread find its worker without a lookup, tagged with the owning job system
+static thread_local const KonideJobSystem* CurrentJobSystem = nullptr;
+static thread_local int32_t CurrentWorkerIdx = -1;
+
+bool KonideJobDeque::Push(KonideJob* job)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= KONIDE_JOB_DEQUE_CAPACITY) {
+        return false;
+    }
+
+    jobs[b & JobDequeMask].store(job, std::memory_order_relaxed);
+    // Publishes the job to thieves that read bottom with acquire
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+KonideJob* KonideJobDeque::Pop()
+{
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    KonideJob* job = jobs[b & JobDequeMask].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last job, race the thieves for it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+KonideJob* KonideJobDeque::Steal()
+{
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return nullptr;
+    }
+
+    KonideJob* job = jobs[t & JobDequeMask].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+KonideJobSystem::~KonideJobSystem()
+{
+    Stop();
+}
+
+void KonideJobSystem::Start(uint32_t workerCount)
+{
+    Stop();
+
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    }
+
+    bExit = false;
+
+    for (uint32_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    // Threads start only once the worker list is final, stealing walks it without locks
+    for (uint32_t i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread(&KonideJobSystem::WorkerMain, this, (int32_t)i);
+    }
+}
+
+void KonideJobSystem::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        bExit = true;
+    }
+    sleepCondition.notify_all();
+
+    for (std::unique_ptr<Worker>& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // Workers drain their own deques before leaving, only the shared queue can still hold jobs
+    while (KonideJob* job = FindJob(-1)) {
+        Execute(job, -1);
+    }
+
+    workers.clear();
+}
+
+int32_t KonideJobSystem::GetCurrentWorkerIndex() const
+{
+    return CurrentJobSystem == this ? CurrentWorkerIdx : -1;
+}
+
+void KonideJobSystem::Push(KonideJob* job)
+{
+    int32_t workerIdx = GetCurrentWorkerIndex();
+
+    if (workerIdx < 0 || !workers[workerIdx]->deque.Push(job)) {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        sharedJobs.push_back(job);
+    }
+
+    queuedJobs.fetch_add(1);
+
+    // Pairs with the sleepingWorkers increment in WorkerMain, one of the two always sees the other
+    if (sleepingWorkers.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        sleepCondition.notify_one();
+    }
+}
+
+KonideJob* KonideJobSystem::FindJob(int32_t workerIdx)
+{
+    KonideJob* job = nullptr;
+
+    if (workerIdx >= 0) {
+        job = workers[workerIdx]->deque.Pop();
+    }
+
+    if (!job) {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        if (!sharedJobs.empty()) {
+            job = sharedJobs.front();
+            sharedJobs.pop_front();
+        }
+    }
+
+    if (!job && !workers.empty()) {
+        // Start with the next worker over so thieves spread across victims
+        uint32_t workerCount = (uint32_t)workers.size();
+        uint32_t first = workerIdx >= 0 ? (uint32_t)workerIdx + 1 : 0;
+
+        for (uint32_t i = 0; i < workerCount && !job; i++) {
+            uint32_t victim = (first + i) % workerCount;
+            if ((int32_t)victim == workerIdx) {
+                continue;
+            }
+
+            job = workers[victim]->deque.Steal();
+            if (job && workerIdx >= 0) {
+                workers[workerIdx]->jobsStolen.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (job) {
+        queuedJobs.fetch_sub(1);
+    }
+    return job;
+}
+
+void KonideJobSystem::Execute(KonideJob* job, int32_t workerIdx)
+{
+    job->function();
+
+    if (workerIdx >= 0) {
+        workers[workerIdx]->jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        externalJobsExecuted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    KonideJobCounter* counter = job->counter;
+    delete job;
+
+    if (counter) {
+        FinishJob(counter);
+    }
+}
+
+void KonideJobSystem::FinishJob(KonideJobCounter* counter)
+{
+    counter->finishing.fetch_add(1);
+
+    std::vector<KonideJob*> ready;
+    if (counter->pending.fetch_sub(1) == 1) {
+        // Last job of the group, release everything that depended on it
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        ready.swap(counter->continuations);
+    }
+
+    // Last access, a waiter may destroy the counter right after
+    counter->finishing.fetch_sub(1);
+
+    for (KonideJob* job : ready) {
+        Push(job);
+    }
+}
+
+void KonideJobSystem::Schedule(std::function<void()> function, KonideJobCounter* counter, KonideJobCounter* dependency)
+{
+    KonideJob* job = new KonideJob();
+    job->function = std::move(function);
+    job->counter = counter;
+
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (dependency->pending.load() != 0) {
+            dependency->continuations.push_back(job);
+            return;
+        }
+    }
+
+    Push(job);
+}
+
+void KonideJobSystem::Wait(KonideJobCounter& counter)
+{
+    int32_t workerIdx = GetCurrentWorkerIndex();
+
+    while (!counter.IsDone()) {
+        if (KonideJob* job = FindJob(workerIdx)) {
+            Execute(job, workerIdx);
+        } else {
+            // Remaining jobs are running elsewhere or waiting on a dependency
+            std::this_thread::yield();
+        }
+    }
+}
+
+void KonideJobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& function)
+{
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max(1u, grainSize);
+
+    KonideJobCounter counter;
+
+    // The calling thread takes the first range itself, it would only wait otherwise
+    for (uint32_t begin = grainSize; begin < count; begin += grainSize) {
+        uint32_t end = std::min(count, begin + grainSize);
+        Schedule([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+
+    function(0, std::min(count, grainSize));
+
+    Wait(counter);
+}
+
+void KonideJobSystem::WorkerMain(int32_t workerIdx)
+{
+    CurrentJobSystem = this;
+    CurrentWorkerIdx = workerIdx;
+
+    uint32_t idleRounds = 0;
+
+    while (true) {
+        if (KonideJob* job = FindJob(workerIdx)) {
+            Execute(job, workerIdx);
+            idleRounds = 0;
+            continue;
+        }
+
+        if (bExit.load()) {
+            break;
+        }
+
+        if (++idleRounds < IdleSpinCount) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1);
+        sleepCondition.wait(lock, [this]() { return bExit.load() || queuedJobs.load() > 0; });
+        sleepingWorkers.fetch_sub(1);
+        idleRounds = 0;
+    }
+
+    CurrentJobSystem = nullptr;
+    CurrentWorkerIdx = -1;
+}
+
+KonideJobSystemStats KonideJobSystem::GetStats() const
+{
+    KonideJobSystemStats stats;
+    stats.jobsExecuted = externalJobsExecuted.load(std::memory_order_relaxed);
+
+    for (const std::unique_ptr<Worker>& worker : workers) {
+        stats.jobsExecuted += worker->jobsExecuted.load(std::memory_order_relaxed);
+        stats.jobsStolen += worker->jobsStolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
@@ -1,6 +1,31 @@
 #include <konide/layer.h>
 
+#include <stdexcept>
+
 uint32_t KonideLayer::AddProxy(KonideProxy* proxy)
 {
     return 0;
+}
+
+void KonideLayer::EncodeCommands(KonideFrameArena& arena)
+{
+    // Layers encode on any job system thread, each thread sorts with its own scratch memory
+    static thread_local KonideRadixSorter sorter;
+
+    commandList.Begin(arena);
+    Encode(commandList);
+    commandList.SortDraws(sorter);
+}
+
+void KonideLayer::Render(VkCommandBuffer commandBuffer, VkDevice device)
+{
+    // A list from an earlier frame points into memory the arena has handed out again
+    if (commandList.IsCurrent()) {
+        // Set when a renderer adopts the layer, see KonideRenderer::AddLayer
+        if (!DeviceTable) {
+            throw std::runtime_error("layer rendered before it was added to a renderer.");
+        }
+        recorder.Begin(commandBuffer, *DeviceTable);
+        commandList.Translate(recorder);
+    }
 }
\ No newline at end of file
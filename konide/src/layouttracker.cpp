@@ -0,0 +1,357 @@
+#include <konide/layouttracker.h>
+
+#include <stdexcept>
+
+// Accesses that make a barrier necessary for whoever comes next
+static constexpr VkAccessFlags2 WriteAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT |
+    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+void KonideLayoutTracker::RegisterImage(VkImage image, VkImageAspectFlags aspectMask, uint32_t mipLevels, uint32_t arrayLayers, VkImageLayout initialLayout,
+    VkPipelineStageFlags2 initialStageMask, VkAccessFlags2 initialAccessMask)
+{
+    ImageState& imageState = images[image];
+    imageState.aspectMask = aspectMask;
+    imageState.mipLevels = mipLevels;
+    imageState.arrayLayers = arrayLayers;
+
+    KonideTrackedState state;
+    state.layout = initialLayout;
+    state.writeStageMask = initialStageMask;
+    state.writeAccessMask = initialAccessMask;
+    imageState.subresources.assign((size_t)mipLevels * arrayLayers, state);
+}
+
+void KonideLayoutTracker::RegisterBuffer(VkBuffer buffer, VkPipelineStageFlags2 initialStageMask, VkAccessFlags2 initialAccessMask)
+{
+    KonideTrackedState state;
+    state.writeStageMask = initialStageMask;
+    state.writeAccessMask = initialAccessMask;
+    buffers[buffer] = state;
+}
+
+void KonideLayoutTracker::Unregister(VkImage image)
+{
+    images.erase(image);
+}
+
+void KonideLayoutTracker::Unregister(VkBuffer buffer)
+{
+    buffers.erase(buffer);
+}
+
+void KonideLayoutTracker::Clear()
+{
+    images.clear();
+    buffers.clear();
+
+    for (uint32_t i = 0; i < pendingBatches; i++) {
+        batches[i].imageBarriers.clear();
+        batches[i].bufferBarriers.clear();
+    }
+    pendingBatches = 0;
+    batchId++;
+}
+
+VkImageLayout KonideLayoutTracker::GetLayout(VkImage image, uint32_t mipLevel, uint32_t arrayLayer) const
+{
+    auto it = images.find(image);
+    if (it == images.end()) {
+        return VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+    return it->second.subresources[(size_t)mipLevel * it->second.arrayLayers + arrayLayer].layout;
+}
+
+void KonideLayoutTracker::GetLastUse(VkImage image, VkPipelineStageFlags2& stageMask, VkAccessFlags2& accessMask) const
+{
+    stageMask = VK_PIPELINE_STAGE_2_NONE;
+    accessMask = VK_ACCESS_2_NONE;
+
+    auto it = images.find(image);
+    if (it == images.end()) {
+        return;
+    }
+
+    for (const KonideTrackedState& state : it->second.subresources) {
+        stageMask |= state.writeStageMask | state.readStageMask;
+        accessMask |= state.writeAccessMask;
+    }
+}
+
+void KonideLayoutTracker::GetLastUse(VkBuffer buffer, VkPipelineStageFlags2& stageMask, VkAccessFlags2& accessMask) const
+{
+    stageMask = VK_PIPELINE_STAGE_2_NONE;
+    accessMask = VK_ACCESS_2_NONE;
+
+    auto it = buffers.find(buffer);
+    if (it != buffers.end()) {
+        stageMask = it->second.writeStageMask | it->second.readStageMask;
+        accessMask = it->second.writeAccessMask;
+    }
+}
+
+KonideBarrierBatch& KonideLayoutTracker::CurrentBatch(bool bConflict)
+{
+    if (pendingBatches == 0 || bConflict) {
+        if (pendingBatches > 0) {
+            batchId++;
+        }
+
+        if (batches.size() == pendingBatches) {
+            batches.push_back(KonideBarrierBatch());
+        }
+        pendingBatches++;
+    }
+
+    return batches[pendingBatches - 1];
+}
+
+bool KonideLayoutTracker::ResolveAccess(KonideTrackedState& state, bool bImage, VkImageLayout layout, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask,
+    bool bWrite, VkPipelineStageFlags2& srcStageMask, VkAccessFlags2& srcAccessMask, VkImageLayout& oldLayout)
+{
+    bool bTransition = bImage && layout != state.layout;
+    bool bBarrier = false;
+
+    srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    srcAccessMask = VK_ACCESS_2_NONE;
+    oldLayout = state.layout;
+
+    if (bTransition || bWrite) {
+        // Write after write and write after read, transitions count as writes
+        srcStageMask = state.writeStageMask | state.readStageMask;
+        srcAccessMask = state.writeAccessMask;
+        bBarrier = bTransition || srcStageMask != VK_PIPELINE_STAGE_2_NONE;
+    } else if (state.writeStageMask != VK_PIPELINE_STAGE_2_NONE || state.writeAccessMask != VK_ACCESS_2_NONE) {
+        // Read after write, readers an earlier barrier already covered don't need another
+        srcStageMask = state.writeStageMask;
+        srcAccessMask = state.writeAccessMask;
+        bBarrier = (stageMask & ~state.readStageMask) || (accessMask & ~state.readAccessMask);
+    }
+
+    if (bTransition || bWrite) {
+        if (bImage) {
+            state.layout = layout;
+        }
+        state.writeStageMask = stageMask;
+        state.writeAccessMask = accessMask & WriteAccessMask;
+        state.readStageMask = bWrite ? VK_PIPELINE_STAGE_2_NONE : stageMask;
+        state.readAccessMask = bWrite ? VK_ACCESS_2_NONE : accessMask;
+    } else {
+        state.readStageMask |= stageMask;
+        state.readAccessMask |= accessMask;
+    }
+
+    return bBarrier;
+}
+
+void KonideLayoutTracker::RequestImage(VkImage image, const VkImageSubresourceRange& range, VkImageLayout layout, VkPipelineStageFlags2 stageMask,
+    VkAccessFlags2 accessMask, bool bWrite)
+{
+    auto it = images.find(image);
+    if (it == images.end()) {
+        throw std::runtime_error("layout tracker doesn't know the requested image.");
+    }
+    ImageState& imageState = it->second;
+
+    uint32_t levelCount = range.levelCount == VK_REMAINING_MIP_LEVELS ? imageState.mipLevels - range.baseMipLevel : range.levelCount;
+    uint32_t layerCount = range.layerCount == VK_REMAINING_ARRAY_LAYERS ? imageState.arrayLayers - range.baseArrayLayer : range.layerCount;
+    if (range.baseMipLevel + levelCount > imageState.mipLevels || range.baseArrayLayer + layerCount > imageState.arrayLayers) {
+        throw std::runtime_error("layout tracker request exceeds the image's subresources.");
+    }
+
+    bool bConflict = false;
+    for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + levelCount; mip++) {
+        for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + layerCount; layer++) {
+            bConflict = bConflict || imageState.subresources[(size_t)mip * imageState.arrayLayers + layer].pendingBatch == batchId;
+        }
+    }
+
+    KonideBarrierBatch* batch = nullptr;
+    bool bAnyBarrier = false;
+    size_t requestStart = 0;
+
+    for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + levelCount; mip++) {
+        for (uint32_t layer = range.baseArrayLayer; layer < range.baseArrayLayer + layerCount; layer++) {
+            KonideTrackedState& state = imageState.subresources[(size_t)mip * imageState.arrayLayers + layer];
+
+            VkPipelineStageFlags2 srcStageMask;
+            VkAccessFlags2 srcAccessMask;
+            VkImageLayout oldLayout;
+            VkImageLayout newLayout = layout != VK_IMAGE_LAYOUT_UNDEFINED ? layout : state.layout;
+            if (!ResolveAccess(state, true, newLayout, stageMask, accessMask, bWrite, srcStageMask, srcAccessMask, oldLayout)) {
+                continue;
+            }
+
+            if (!batch) {
+                batch = &CurrentBatch(bConflict);
+                requestStart = batch->imageBarriers.size();
+            }
+            state.pendingBatch = batchId;
+            bAnyBarrier = true;
+
+            // Neighbouring subresources with the same transition share one barrier: first along the
+            // layers of a mip, then across mips covering the same layers
+            bool bMerged = false;
+            for (size_t i = batch->imageBarriers.size(); i-- > requestStart;) {
+                VkImageMemoryBarrier2& barrier = batch->imageBarriers[i];
+                if (barrier.srcStageMask != srcStageMask || barrier.srcAccessMask != srcAccessMask || barrier.oldLayout != oldLayout) {
+                    continue;
+                }
+
+                VkImageSubresourceRange& merged = barrier.subresourceRange;
+                if (merged.baseMipLevel == mip && merged.levelCount == 1 && merged.baseArrayLayer + merged.layerCount == layer) {
+                    merged.layerCount++;
+                    bMerged = true;
+                    break;
+                }
+            }
+
+            if (!bMerged) {
+                VkImageMemoryBarrier2 barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+                barrier.srcStageMask = srcStageMask;
+                barrier.srcAccessMask = srcAccessMask;
+                barrier.dstStageMask = stageMask;
+                barrier.dstAccessMask = accessMask;
+                barrier.oldLayout = oldLayout;
+                barrier.newLayout = newLayout;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image = image;
+                barrier.subresourceRange.aspectMask = imageState.aspectMask;
+                barrier.subresourceRange.baseMipLevel = mip;
+                barrier.subresourceRange.levelCount = 1;
+                barrier.subresourceRange.baseArrayLayer = layer;
+                barrier.subresourceRange.layerCount = 1;
+                batch->imageBarriers.push_back(barrier);
+            }
+        }
+
+        // Fold this mip's barriers into the previous mip's when they cover the same layers the same way
+        if (batch && batch->imageBarriers.size() > requestStart) {
+            for (size_t i = batch->imageBarriers.size(); i-- > requestStart;) {
+                VkImageMemoryBarrier2& current = batch->imageBarriers[i];
+                if (current.subresourceRange.baseMipLevel != mip) {
+                    break;
+                }
+
+                for (size_t j = requestStart; j < i; j++) {
+                    VkImageMemoryBarrier2& previous = batch->imageBarriers[j];
+                    if (previous.subresourceRange.baseMipLevel + previous.subresourceRange.levelCount == mip &&
+                        previous.subresourceRange.baseArrayLayer == current.subresourceRange.baseArrayLayer &&
+                        previous.subresourceRange.layerCount == current.subresourceRange.layerCount &&
+                        previous.srcStageMask == current.srcStageMask && previous.srcAccessMask == current.srcAccessMask &&
+                        previous.oldLayout == current.oldLayout) {
+                        previous.subresourceRange.levelCount++;
+                        batch->imageBarriers.erase(batch->imageBarriers.begin() + i);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!bAnyBarrier) {
+        stats.elidedRequests++;
+    }
+}
+
+void KonideLayoutTracker::RequestBuffer(VkBuffer buffer, VkPipelineStageFlags2 stageMask, VkAccessFlags2 accessMask, bool bWrite)
+{
+    auto it = buffers.find(buffer);
+    if (it == buffers.end()) {
+        throw std::runtime_error("layout tracker doesn't know the requested buffer.");
+    }
+    KonideTrackedState& state = it->second;
+    bool bConflict = state.pendingBatch == batchId;
+
+    VkPipelineStageFlags2 srcStageMask;
+    VkAccessFlags2 srcAccessMask;
+    VkImageLayout oldLayout;
+    if (!ResolveAccess(state, false, VK_IMAGE_LAYOUT_UNDEFINED, stageMask, accessMask, bWrite, srcStageMask, srcAccessMask, oldLayout)) {
+        stats.elidedRequests++;
+        return;
+    }
+
+    KonideBarrierBatch& batch = CurrentBatch(bConflict);
+    state.pendingBatch = batchId;
+
+    VkBufferMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+    barrier.srcStageMask = srcStageMask;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstStageMask = stageMask;
+    barrier.dstAccessMask = accessMask;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    batch.bufferBarriers.push_back(barrier);
+}
+
+void KonideLayoutTracker::CountBatch(const KonideBarrierBatch& batch)
+{
+    stats.barrierBatches++;
+    stats.imageBarriers += batch.imageBarriers.size();
+    stats.bufferBarriers += batch.bufferBarriers.size();
+
+    for (const VkImageMemoryBarrier2& barrier : batch.imageBarriers) {
+        if (barrier.oldLayout != barrier.newLayout) {
+            stats.layoutTransitions++;
+        }
+    }
+}
+
+uint32_t KonideLayoutTracker::Flush(VkCommandBuffer commandBuffer, const KonideDeviceTable& deviceTable)
+{
+    uint32_t calls = 0;
+
+    for (uint32_t i = 0; i < pendingBatches; i++) {
+        KonideBarrierBatch& batch = batches[i];
+        if (batch.imageBarriers.empty() && batch.bufferBarriers.empty()) {
+            continue;
+        }
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.imageMemoryBarrierCount = (uint32_t)batch.imageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = batch.imageBarriers.data();
+        dependencyInfo.bufferMemoryBarrierCount = (uint32_t)batch.bufferBarriers.size();
+        dependencyInfo.pBufferMemoryBarriers = batch.bufferBarriers.data();
+        deviceTable.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+        CountBatch(batch);
+        calls++;
+
+        batch.imageBarriers.clear();
+        batch.bufferBarriers.clear();
+    }
+
+    pendingBatches = 0;
+    batchId++;
+    return calls;
+}
+
+bool KonideLayoutTracker::TakeBatch(std::vector<VkImageMemoryBarrier2>& imageBarriers, std::vector<VkBufferMemoryBarrier2>& bufferBarriers)
+{
+    if (pendingBatches == 0) {
+        return false;
+    }
+    if (pendingBatches > 1) {
+        throw std::runtime_error("pending barriers span more than one batch.");
+    }
+
+    KonideBarrierBatch& batch = batches[0];
+    CountBatch(batch);
+
+    imageBarriers.insert(imageBarriers.end(), batch.imageBarriers.begin(), batch.imageBarriers.end());
+    bufferBarriers.insert(bufferBarriers.end(), batch.bufferBarriers.begin(), batch.bufferBarriers.end());
+    batch.imageBarriers.clear();
+    batch.bufferBarriers.clear();
+
+    pendingBatches = 0;
+    batchId++;
+    return true;
+}
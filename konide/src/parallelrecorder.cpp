@@ -0,0 +1,158 @@
+#include <konide/parallelrecorder.h>
+#include <konide/jobsystem.h>
+#include <konide/layer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+KonideParallelRecorder::~KonideParallelRecorder()
+{
+    Destroy();
+}
+
+void KonideParallelRecorder::Initialize(VkDevice newDevice, const KonideDeviceTable& newDeviceTable, uint32_t newQueueFamily, KonideJobSystem& newJobSystem)
+{
+    device = newDevice;
+    deviceTable = &newDeviceTable;
+    queueFamily = newQueueFamily;
+    jobSystem = &newJobSystem;
+
+    // Pools are created on a context's first use, workers that never record don't get any
+    contexts.clear();
+    for (uint32_t i = 0; i <= jobSystem->GetWorkerCount(); i++) {
+        contexts.push_back(std::make_unique<Context>());
+    }
+}
+
+void KonideParallelRecorder::Destroy()
+{
+    // Destroying a pool frees its command buffers
+    for (std::unique_ptr<Context>& context : contexts) {
+        for (uint32_t slot = 0; slot < KONIDE_RECORDER_MAX_FRAME_SLOTS; slot++) {
+            if (context->pools[slot]) {
+                deviceTable->vkDestroyCommandPool(device, context->pools[slot], nullptr);
+            }
+        }
+    }
+    contexts.clear();
+}
+
+KonideParallelRecorder::Context& KonideParallelRecorder::GetContext()
+{
+    int32_t workerIdx = jobSystem->GetCurrentWorkerIndex();
+    if (workerIdx < 0 || (size_t)workerIdx + 1 >= contexts.size()) {
+        return *contexts.back();
+    }
+    return *contexts[workerIdx];
+}
+
+void KonideParallelRecorder::CreateContextPools(Context& context)
+{
+    // Transient pools, each is reset as a whole when its frame slot comes around again
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+
+    for (VkCommandPool& pool : context.pools) {
+        if (deviceTable->vkCreateCommandPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create recorder command pool.");
+        }
+    }
+}
+
+void KonideParallelRecorder::RecordLayers(const std::vector<KonideLayer*>& layers, const std::vector<VkFormat>& formats, uint32_t frameSlot,
+    uint64_t job, uint32_t begin, uint32_t end, VkCommandBuffer* buffers)
+{
+    Context& context = GetContext();
+    std::lock_guard<std::recursive_mutex> lock(context.mutex);
+
+    if (!context.pools[0]) {
+        CreateContextPools(context);
+    }
+
+    VkCommandPool pool = context.pools[frameSlot];
+    std::vector<VkCommandBuffer>& poolBuffers = context.buffers[frameSlot];
+
+    // First range this context records for the job, this slot's previous frame is complete and every buffer from it can be reused
+    if (context.lastJob != job) {
+        deviceTable->vkResetCommandPool(device, pool, 0);
+        context.usedBuffers = 0;
+        context.allocations = 0;
+        context.lastJob = job;
+    }
+
+    // Layers draw inside the dynamic rendering instance the primary begins
+    VkCommandBufferInheritanceRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = &renderingInfo;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    for (uint32_t layerIdx = begin; layerIdx < end; layerIdx++) {
+        if (context.usedBuffers == poolBuffers.size()) {
+            VkCommandBufferAllocateInfo allocInfo = {};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
+            allocInfo.commandPool = pool;
+
+            VkCommandBuffer buffer;
+            if (deviceTable->vkAllocateCommandBuffers(device, &allocInfo, &buffer) != VK_SUCCESS) {
+                throw std::runtime_error("failed to allocate secondary command buffer.");
+            }
+            poolBuffers.push_back(buffer);
+            context.allocations++;
+        }
+
+        VkCommandBuffer buffer = poolBuffers[context.usedBuffers++];
+
+        renderingInfo.pColorAttachmentFormats = &formats[layerIdx];
+        deviceTable->vkBeginCommandBuffer(buffer, &beginInfo);
+        layers[layerIdx]->Render(buffer, device);
+        deviceTable->vkEndCommandBuffer(buffer);
+
+        buffers[layerIdx] = buffer;
+    }
+}
+
+uint32_t KonideParallelRecorder::Record(const std::vector<KonideLayer*>& layers, const std::vector<VkFormat>& formats, uint32_t frameSlot, uint32_t maxRanges, std::vector<VkCommandBuffer>& buffers)
+{
+    if (contexts.empty()) {
+        throw std::runtime_error("parallel recorder isn't initialized.");
+    }
+    if (frameSlot >= KONIDE_RECORDER_MAX_FRAME_SLOTS) {
+        throw std::runtime_error("parallel recorder frame slot out of range.");
+    }
+    if (formats.size() != layers.size()) {
+        throw std::runtime_error("parallel recorder needs one attachment format per layer.");
+    }
+
+    buffers.resize(layers.size());
+
+    uint64_t job = ++jobCount;
+    uint32_t layerCount = (uint32_t)layers.size();
+    uint32_t grainSize = (layerCount + std::max(1u, maxRanges) - 1) / std::max(1u, maxRanges);
+
+    // The calling thread records the first range, the rest go to whichever workers are free
+    VkCommandBuffer* outBuffers = buffers.data();
+    jobSystem->ParallelFor(layerCount, grainSize, [&](uint32_t begin, uint32_t end) {
+        RecordLayers(layers, formats, frameSlot, job, begin, end, outBuffers);
+    });
+
+    uint32_t allocations = 0;
+    for (const std::unique_ptr<Context>& context : contexts) {
+        if (context->lastJob == job) {
+            allocations += context->allocations;
+        }
+    }
+    return allocations;
+}
@@ -5,10 +5,18 @@
 #include <string>
 #include <stdexcept>
 #include <set>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+
+// Upper bound for a single present wait before falling back to the frame timeline
+static constexpr uint64_t PresentWaitTimeout = 100000000ull;
 
 KonideRenderer::KonideRenderer(uint32_t RenderFeatures)
 {
     RenderFeatureFlags = RenderFeatures;
+
+    jobSystem.Start();
 }
 
 KonideQueueFamilyIndices KonideRenderer::InternalFindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface)
@@ -16,10 +24,10 @@ KonideQueueFamilyIndices KonideRenderer::InternalFindQueueFamilies(VkPhysicalDev
     KonideQueueFamilyIndices indices;
     
     uint32_t queueFamilyCount = 0;
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+    instanceTable.vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
 
     std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
+    instanceTable.vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
     VkBool32 presentSupport = false;
     uint32_t i = 0;
@@ -30,7 +38,7 @@ KonideQueueFamilyIndices KonideRenderer::InternalFindQueueFamilies(VkPhysicalDev
 
         if(surface != 0)
         {
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+            instanceTable.vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
             if (presentSupport) {
                 indices.presentFamily = i;
             }
@@ -46,6 +54,23 @@ KonideQueueFamilyIndices KonideRenderer::InternalFindQueueFamilies(VkPhysicalDev
     return indices;
 }
 
+bool KonideRenderer::InternalIsDeviceExtensionSupported(VkPhysicalDevice device, const char* name)
+{
+    uint32_t extensionCount = 0;
+    instanceTable.vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    instanceTable.vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensions.data());
+
+    for (const VkExtensionProperties& extension : extensions) {
+        if (strcmp(extension.extensionName, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 VkPhysicalDevice KonideRenderer::InternalPickPhysDevice(std::vector<VkPhysicalDevice> &PhysicalDevices)
 {
     for(int i = 0; i < PhysicalDevices.size(); i++)
@@ -97,7 +122,11 @@ bool KonideRenderer::Initialize(std::vector<const char*> extensions, std::vector
     instanceInfo.enabledLayerCount = layrs.size();
     instanceInfo.ppEnabledLayerNames = layrs.data();
 
-    result = vkloader::vkCreateInstance(&instanceInfo, nullptr, &instance);
+    vkloader::LoadOptions loadOptions;
+    loadOptions.bLoadAll = (RenderFeatureFlags & KONIDE_RENDER_FEATURE_LOAD_ALL_ENTRYPOINTS) != 0;
+    loadOptions.stats = &loaderStats;
+
+    result = vkloader::vkCreateInstance(&instanceInfo, nullptr, &instance, instanceTable, loadOptions);
     if(result != VK_SUCCESS)
     {
         throw std::runtime_error("Could not create VkInstance");
@@ -107,34 +136,118 @@ bool KonideRenderer::Initialize(std::vector<const char*> extensions, std::vector
     // Pick Physical Device
     uint32_t deviceCount = 0;
 
-    vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+    instanceTable.vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
     if (deviceCount == 0) {
         throw std::runtime_error("failed to find GPUs with Vulkan support!");
     }
 
     std::vector<VkPhysicalDevice> devices(deviceCount);
-    vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+    instanceTable.vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
-    physDevice = DelegatePickPhysDevice(devices);
+    physDevice = DelegatePickPhysDevice ? DelegatePickPhysDevice(devices) : InternalPickPhysDevice(devices);
 
     return true;
 }
 
-uint32_t KonideRenderer::CreateComposition(VkSurfaceKHR surface)
+std::optional<uint32_t> KonideRenderer::InternalFindPresentFamily(VkPhysicalDevice device, const std::vector<VkSurfaceKHR>& surfaces, std::optional<uint32_t> preferred)
+{
+    uint32_t queueFamilyCount = 0;
+    instanceTable.vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+
+    auto presentsToAll = [&](uint32_t family) {
+        for (VkSurfaceKHR surface : surfaces) {
+            VkBool32 presentSupport = VK_FALSE;
+            instanceTable.vkGetPhysicalDeviceSurfaceSupportKHR(device, family, surface, &presentSupport);
+            if (!presentSupport) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (preferred.has_value() && presentsToAll(preferred.value())) {
+        return preferred;
+    }
+
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        if (presentsToAll(i)) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+uint32_t KonideRenderer::CreateComposition(VkSurfaceKHR surface, uint32_t width, uint32_t height)
 {
+    // Every swapchain is presented from the same queue, compositions made before CreateDevice take part in picking it
+    if (device) {
+        if (!queueFamilyIndices.presentFamily.has_value()) {
+            throw std::runtime_error("device was created without a present queue.");
+        }
+
+        VkBool32 presentSupport = VK_FALSE;
+        instanceTable.vkGetPhysicalDeviceSurfaceSupportKHR(physDevice, queueFamilyIndices.presentFamily.value(), surface, &presentSupport);
+        if (!presentSupport) {
+            throw std::runtime_error("present queue can't present to the composition surface.");
+        }
+    }
+
     KonideComposition* composition = new KonideComposition(surface);
 
+    // Built by the next FlushRender
+    KonideSwapchain& compositionSwapchain = composition->GetSwapchain();
+    compositionSwapchain.requestedWidth = width;
+    compositionSwapchain.requestedHeight = height;
+    compositionSwapchain.bOutOfDate = true;
+
     Compositions.push_back(composition);
     return Compositions.size()-1;
 }
 
+void KonideRenderer::ResizeComposition(uint32_t index, uint32_t width, uint32_t height)
+{
+    if (IsOffRenderThread()) {
+        EnqueueFrameUpdate(nullptr, nullptr, [this, index, width, height]() { ResizeComposition(index, width, height); });
+        return;
+    }
+
+    KonideSwapchain& compositionSwapchain = Compositions[index]->GetSwapchain();
+    compositionSwapchain.requestedWidth = width;
+    compositionSwapchain.requestedHeight = height;
+    compositionSwapchain.bOutOfDate = true;
+}
+
 void KonideRenderer::CreateDevice(std::vector<const char*> devExtensions, std::vector<const char*> devLayers)
 {
     // Create Device Queue
-    queueFamilyIndices = InternalFindQueueFamilies(physDevice, swapchain.surface);
+    queueFamilyIndices = InternalFindQueueFamilies(physDevice);
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = { queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value() };
+    if (!queueFamilyIndices.graphicsFamily.has_value()) {
+        throw std::runtime_error("no graphics queue family.");
+    }
+
+    // One queue presents every output, the renderer's own surface and compositions created so far
+    std::vector<VkSurfaceKHR> surfaces;
+    if (swapchain.surface) {
+        surfaces.push_back(swapchain.surface);
+    }
+    for (KonideComposition* composition : Compositions) {
+        surfaces.push_back(composition->GetSwapchainInfo().surface);
+    }
+
+    if (!surfaces.empty()) {
+        queueFamilyIndices.presentFamily = InternalFindPresentFamily(physDevice, surfaces, queueFamilyIndices.graphicsFamily);
+        if (!queueFamilyIndices.presentFamily.has_value()) {
+            throw std::runtime_error("no queue family can present to every surface.");
+        }
+    }
+
+    // Without a surface the device is headless and only gets the graphics queue
+    std::set<uint32_t> uniqueQueueFamilies = { queueFamilyIndices.graphicsFamily.value() };
+    if (queueFamilyIndices.presentFamily.has_value()) {
+        uniqueQueueFamilies.insert(queueFamilyIndices.presentFamily.value());
+    }
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -150,8 +263,19 @@ void KonideRenderer::CreateDevice(std::vector<const char*> devExtensions, std::v
     // Create Device
     VkPhysicalDeviceFeatures deviceFeatures{};
 
+    VkPhysicalDeviceVulkan13Features vulkan13Features{};
+    vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    vulkan13Features.synchronization2 = VK_TRUE;
+    vulkan13Features.dynamicRendering = VK_TRUE;
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.pNext = &vulkan13Features;
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+
     VkDeviceCreateInfo deviceCreateInfo{};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext = &vulkan12Features;
     deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
     deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 
@@ -159,6 +283,32 @@ void KonideRenderer::CreateDevice(std::vector<const char*> devExtensions, std::v
 
     std::vector<const char*> extensions = InternalAssembleDeviceExtensions();
     extensions.insert(extensions.end(), devExtensions.begin(), devExtensions.end());
+
+    // Present id/wait are optional, the low latency mode falls back to timeline estimates without them
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    presentIdFeatures.pNext = &presentWaitFeatures;
+
+    if ((RenderFeatureFlags & KONIDE_RENDER_FEATURE_SWAPCHAIN) &&
+        InternalIsDeviceExtensionSupported(physDevice, VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+        InternalIsDeviceExtensionSupported(physDevice, VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &presentIdFeatures;
+        instanceTable.vkGetPhysicalDeviceFeatures2(physDevice, &features2);
+
+        bPresentWaitSupported = presentIdFeatures.presentId && presentWaitFeatures.presentWait;
+    }
+
+    if (bPresentWaitSupported) {
+        extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+        vulkan13Features.pNext = &presentIdFeatures;
+    }
+
     deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     deviceCreateInfo.ppEnabledExtensionNames = extensions.data();
 
@@ -167,15 +317,43 @@ void KonideRenderer::CreateDevice(std::vector<const char*> devExtensions, std::v
     deviceCreateInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
     deviceCreateInfo.ppEnabledLayerNames = layers.data();
 
-    if (vkloader::vkCreateDevice(physDevice, &deviceCreateInfo, nullptr, &device) != VK_SUCCESS) {
+    vkloader::LoadOptions loadOptions;
+    loadOptions.bLoadAll = (RenderFeatureFlags & KONIDE_RENDER_FEATURE_LOAD_ALL_ENTRYPOINTS) != 0;
+    loadOptions.stats = &loaderStats;
+
+    if (vkloader::vkCreateDevice(instanceTable, physDevice, &deviceCreateInfo, nullptr, &device, deviceTable, loadOptions) != VK_SUCCESS) {
         throw std::runtime_error("failed to create logical device.");
     }
 
-    vkGetDeviceQueue(device, queueFamilyIndices.graphicsFamily.value(), 0, &graphicsQueue);
+    deviceTable.vkGetDeviceQueue(device, queueFamilyIndices.graphicsFamily.value(), 0, &graphicsQueue);
     if(queueFamilyIndices.presentFamily.has_value()) 
     {   
-        vkGetDeviceQueue(device, queueFamilyIndices.presentFamily.value(), 0, &presentQueue);
+        deviceTable.vkGetDeviceQueue(device, queueFamilyIndices.presentFamily.value(), 0, &presentQueue);
+    }
+
+    // Frame clock shared by every submission
+    VkSemaphoreTypeCreateInfo timelineCreateInfo{};
+    timelineCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineCreateInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo timelineSemaphoreInfo{};
+    timelineSemaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    timelineSemaphoreInfo.pNext = &timelineCreateInfo;
+
+    if (deviceTable.vkCreateSemaphore(device, &timelineSemaphoreInfo, nullptr, &frameTimeline) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create frame timeline semaphore.");
     }
+
+    // Frame slots outlive swapchain recreation
+    CreateFrameSlots();
+
+    layerRecorder.Initialize(device, deviceTable, queueFamilyIndices.graphicsFamily.value(), jobSystem);
+
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    instanceTable.vkGetPhysicalDeviceMemoryProperties(physDevice, &memoryProperties);
+
+    frameGraph.Initialize(device, deviceTable, memoryProperties, [this](std::function<void()> destroy) { DeferDestruction(std::move(destroy)); });
 }
 
 std::vector<const char*> KonideRenderer::InternalAssembleLayers()
@@ -220,55 +398,118 @@ void KonideRenderer::CreateDebugMessenger(PFN_vkDebugUtilsMessengerCallbackEXT c
     createInfo.pfnUserCallback = callback;
     createInfo.pUserData = userData;
 
-    vkCreateDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger);
+    instanceTable.vkCreateDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger);
 }
 
-void KonideRenderer::CreateSwapchain(uint32_t width, uint32_t height)
+VkPresentModeKHR KonideRenderer::InternalChoosePresentMode(const std::vector<VkPresentModeKHR>& available, VkPresentModeKHR requested)
 {
-    // ToDo: swapchain support info
+    std::vector<VkPresentModeKHR> preference;
+    switch (requested) {
+    case VK_PRESENT_MODE_MAILBOX_KHR:
+        // Low latency without tearing, uncapped tearing is the next best thing
+        preference = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR };
+        break;
+    case VK_PRESENT_MODE_IMMEDIATE_KHR:
+        preference = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR };
+        break;
+    case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+        preference = { VK_PRESENT_MODE_FIFO_RELAXED_KHR };
+        break;
+    default:
+        break;
+    }
 
-    swapchain.swapChainImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+    for (VkPresentModeKHR mode : preference) {
+        if (std::find(available.begin(), available.end(), mode) != available.end()) {
+            return mode;
+        }
+    }
+
+    // FIFO support is required by the spec
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+bool KonideRenderer::BuildSwapchain(KonideSwapchain& target, uint32_t width, uint32_t height)
+{
+    VkSurfaceCapabilitiesKHR capabilities;
+    if (instanceTable.vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physDevice, target.surface, &capabilities) != VK_SUCCESS) {
+        throw std::runtime_error("failed to query surface capabilities.");
+    }
 
     std::vector<VkSurfaceFormatKHR> availableFormats;
     uint32_t formatCount;
-    vkGetPhysicalDeviceSurfaceFormatsKHR(physDevice, swapchain.surface, &formatCount, nullptr);
+    instanceTable.vkGetPhysicalDeviceSurfaceFormatsKHR(physDevice, target.surface, &formatCount, nullptr);
 
     if (formatCount == 0) {
         throw std::runtime_error("No surface formats available");
     }
 
     availableFormats.resize(formatCount);
-    vkGetPhysicalDeviceSurfaceFormatsKHR(physDevice, swapchain.surface, &formatCount, availableFormats.data());
+    instanceTable.vkGetPhysicalDeviceSurfaceFormatsKHR(physDevice, target.surface, &formatCount, availableFormats.data());
 
-    VkSurfaceFormatKHR resultFormat;
+    VkSurfaceFormatKHR resultFormat = availableFormats[0];
     for (const auto& availableFormat : availableFormats) {
         if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
             resultFormat = availableFormat;
         }
     }
 
+    std::vector<VkPresentModeKHR> availablePresentModes;
+    uint32_t presentModeCount;
+    instanceTable.vkGetPhysicalDeviceSurfacePresentModesKHR(physDevice, target.surface, &presentModeCount, nullptr);
+    availablePresentModes.resize(presentModeCount);
+    instanceTable.vkGetPhysicalDeviceSurfacePresentModesKHR(physDevice, target.surface, &presentModeCount, availablePresentModes.data());
+
     VkSurfaceFormatKHR surfaceFormat = resultFormat;
-    VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
-    VkExtent2D extent = {
-        static_cast<uint32_t>(width),
-        static_cast<uint32_t>(height)
-    };
+    VkPresentModeKHR presentMode = InternalChoosePresentMode(availablePresentModes, requestedPresentMode);
+
+    // A current extent of UINT32_MAX means the surface size follows the swapchain
+    VkExtent2D extent = capabilities.currentExtent;
+    if (extent.width == UINT32_MAX) {
+        extent.width = std::clamp(width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+        extent.height = std::clamp(height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+    }
+
+    uint32_t imageCount = requestedImageCount ? requestedImageCount : capabilities.minImageCount + 1;
+    imageCount = std::max(imageCount, capabilities.minImageCount);
+    if (capabilities.maxImageCount > 0) {
+        imageCount = std::min(imageCount, capabilities.maxImageCount);
+    }
 
-    swapchain.swapChainExtent = extent;
+    target.requestedWidth = width;
+    target.requestedHeight = height;
+
+    // Minimized windows report a zero extent, keep the current swapchain until it becomes usable again
+    if (extent.width == 0 || extent.height == 0) {
+        target.bOutOfDate = true;
+        return false;
+    }
+
+    KonideSwapchain retired = target;
+
+    target.swapChainImageFormat = surfaceFormat.format;
+    target.swapChainExtent = extent;
+    target.presentMode = presentMode;
 
     // Create swapchain
     VkSwapchainCreateInfoKHR createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
     createInfo.pNext = nullptr;
     createInfo.flags = 0;
-    createInfo.surface = swapchain.surface;
+    createInfo.surface = target.surface;
 
-    createInfo.minImageCount = 2;
+    createInfo.minImageCount = imageCount;
     createInfo.imageFormat = surfaceFormat.format;
     createInfo.imageColorSpace = surfaceFormat.colorSpace;
     createInfo.imageExtent = extent;
     createInfo.imageArrayLayers = 1;
+    // Outputs are only ever rendered to, clears happen through the attachment load op
     createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    target.imageUsage = createInfo.imageUsage;
+
+    if (!queueFamilyIndices.presentFamily.has_value()) {
+        throw std::runtime_error("device was created without a present queue.");
+    }
 
     uint32_t indices[] = {queueFamilyIndices.graphicsFamily.value(), queueFamilyIndices.presentFamily.value()};
 
@@ -282,32 +523,31 @@ void KonideRenderer::CreateSwapchain(uint32_t width, uint32_t height)
         createInfo.pQueueFamilyIndices = nullptr;
     }
 
-    createInfo.preTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    createInfo.preTransform = capabilities.currentTransform;
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = presentMode;
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    createInfo.oldSwapchain = retired.swapchain;
 
-    if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &(swapchain.swapchain)) != VK_SUCCESS) {
+    if (deviceTable.vkCreateSwapchainKHR(device, &createInfo, nullptr, &(target.swapchain)) != VK_SUCCESS) {
         throw std::runtime_error("failed to create swap chain!");
     }
 
-    // Fetch images
-    uint32_t imageCount;
-    vkGetSwapchainImagesKHR(device, swapchain.swapchain, &imageCount, nullptr);
-    swapchain.images.resize(imageCount);
-    vkGetSwapchainImagesKHR(device, swapchain.swapchain, &imageCount, swapchain.images.data());
+    // Fetch images, the implementation may create more than requested
+    deviceTable.vkGetSwapchainImagesKHR(device, target.swapchain, &imageCount, nullptr);
+    target.images.resize(imageCount);
+    deviceTable.vkGetSwapchainImagesKHR(device, target.swapchain, &imageCount, target.images.data());
 
     // Create image views
-    swapchain.imageViews.resize(imageCount);
+    target.imageViews.resize(imageCount);
 
-    for (size_t i = 0; i < swapchain.images.size(); i++) {
+    for (size_t i = 0; i < target.images.size(); i++) {
         VkImageViewCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        createInfo.image = swapchain.images[i];
+        createInfo.image = target.images[i];
 
         createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        createInfo.format = swapchain.swapChainImageFormat;
+        createInfo.format = target.swapChainImageFormat;
 
         createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
         createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -320,106 +560,1013 @@ void KonideRenderer::CreateSwapchain(uint32_t width, uint32_t height)
         createInfo.subresourceRange.baseArrayLayer = 0;
         createInfo.subresourceRange.layerCount = 1;
 
-        if (vkCreateImageView(device, &createInfo, nullptr, &swapchain.imageViews[i]) != VK_SUCCESS) {
+        if (deviceTable.vkCreateImageView(device, &createInfo, nullptr, &target.imageViews[i]) != VK_SUCCESS) {
             throw std::runtime_error("failed to create image views.");
         }
     }
 
-    // Create synchronization objects
+    CreatePresentSemaphores(target);
+
+    // Frames in flight may still reference the old images, retire them instead of idling the device
+    if (retired.swapchain) {
+        EvictLayerCache(nullptr, &target);
+        DeferDestruction([this, retired]() {
+            for (VkImageView imageView : retired.imageViews) {
+                deviceTable.vkDestroyImageView(device, imageView, nullptr);
+            }
+            for (VkSemaphore semaphore : retired.presentSemaphores) {
+                deviceTable.vkDestroySemaphore(device, semaphore, nullptr);
+            }
+            deviceTable.vkDestroySwapchainKHR(device, retired.swapchain, nullptr);
+        });
+    }
+
+    target.bOutOfDate = false;
+    target.generation++;
+    return true;
+}
+
+void KonideRenderer::CreateSwapchain(uint32_t width, uint32_t height)
+{
+    if (BuildSwapchain(swapchain, width, height)) {
+        // Present ids from the old swapchain can't be waited on through the new one
+        swapchainFirstPresentId = 0;
+    }
+}
+
+void KonideRenderer::CreatePresentSemaphores(KonideSwapchain& target)
+{
+    VkSemaphoreCreateInfo semaphoreCreateInfo{};
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    // One per image: a binary semaphore is only safe to re-signal once its image is acquired again
+    target.presentSemaphores.resize(target.images.size());
+    for (VkSemaphore& semaphore : target.presentSemaphores) {
+        if (deviceTable.vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create present semaphores.");
+        }
+    }
+}
+
+void KonideRenderer::RecreateSwapchain(uint32_t width, uint32_t height)
+{
+    // The render thread owns the swapchain while it runs, hand the resize over with the next packet
+    if (IsOffRenderThread()) {
+        EnqueueFrameUpdate(nullptr, nullptr, [this, width, height]() { CreateSwapchain(width, height); });
+        return;
+    }
+
+    CreateSwapchain(width, height);
+}
+
+void KonideRenderer::DestroySwapchain(KonideSwapchain& target)
+{
+    EvictLayerCache(nullptr, &target);
+
+    for (auto imageView : target.imageViews) {
+        deviceTable.vkDestroyImageView(device, imageView, nullptr);
+    }
+    target.imageViews.clear();
+    target.images.clear();
+
+    for (VkSemaphore semaphore : target.presentSemaphores) {
+        deviceTable.vkDestroySemaphore(device, semaphore, nullptr);
+    }
+    target.presentSemaphores.clear();
+
+    if (target.swapchain) deviceTable.vkDestroySwapchainKHR(device, target.swapchain, nullptr);
+    target.swapchain = VK_NULL_HANDLE;
+}
+
+void KonideRenderer::DeferDestruction(std::function<void()> destroy)
+{
+    deferredDeletions.push_back({ frameNumber, std::move(destroy) });
+}
+
+uint64_t KonideRenderer::GetCompletedFrameValue()
+{
+    uint64_t value = 0;
+    deviceTable.vkGetSemaphoreCounterValue(device, frameTimeline, &value);
+    completedFrames = std::max(completedFrames, value);
+    return completedFrames;
+}
+
+void KonideRenderer::WaitForFrame(uint64_t value, uint64_t timeout)
+{
+    if (value <= completedFrames) {
+        return;
+    }
+
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &frameTimeline;
+    waitInfo.pValues = &value;
+
+    if (deviceTable.vkWaitSemaphores(device, &waitInfo, timeout) == VK_SUCCESS) {
+        completedFrames = std::max(completedFrames, value);
+    }
+}
+
+void KonideRenderer::SetLowLatencyMode(bool bEnable, uint32_t maxQueued)
+{
+    bLowLatencyMode = bEnable;
+    maxQueuedFrames = std::max<uint32_t>(maxQueued, 1);
+
+    if (!bLowLatencyMode) {
+        pendingLatencyFrames.clear();
+    }
+}
+
+void KonideRenderer::WaitForFrameLatency()
+{
+    // Pacing belongs to whichever thread records frames
+    if (bFrameStarted || IsOffRenderThread()) {
+        return;
+    }
+
+    if (bLowLatencyMode && frameNumber > maxQueuedFrames) {
+        uint64_t target = frameNumber - maxQueuedFrames;
+
+        bool bPresented = false;
+        if (bPresentWaitSupported && swapchainFirstPresentId != 0 && target >= swapchainFirstPresentId) {
+            bPresented = deviceTable.vkWaitForPresentKHR(device, swapchain.swapchain, target, PresentWaitTimeout) == VK_SUCCESS;
+        }
+
+        // GPU completion is the closest estimate of presentation we have without present wait
+        if (!bPresented) {
+            WaitForFrame(target);
+        }
+
+        RecordFrameLatency(target, bPresented);
+    }
+
+    frameStartTime = std::chrono::steady_clock::now();
+    bFrameStarted = true;
+}
+
+void KonideRenderer::RecordFrameLatency(uint64_t presentedFrame, bool bPresentWait)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    while (!pendingLatencyFrames.empty() && pendingLatencyFrames.front().first <= presentedFrame) {
+        KonideLatencySample sample;
+        sample.frame = pendingLatencyFrames.front().first;
+        sample.latency = std::chrono::duration<double>(now - pendingLatencyFrames.front().second).count();
+        sample.bPresentWait = bPresentWait;
+
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            latencySamples.push_back(sample);
+            if (latencySamples.size() > KONIDE_MAX_LATENCY_SAMPLES) {
+                latencySamples.pop_front();
+            }
+        }
+
+        pendingLatencyFrames.pop_front();
+    }
+}
+
+void KonideRenderer::ProcessDeferredDeletions()
+{
+    // Entries are queued in frame order
+    while (!deferredDeletions.empty() && deferredDeletions.front().frame <= completedFrames) {
+        deferredDeletions.front().destroy();
+        deferredDeletions.pop_front();
+    }
+}
+
+void KonideRenderer::CreateFrameSlots()
+{
     VkSemaphoreCreateInfo semaphoreCreateInfo;
     semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
     semaphoreCreateInfo.flags = 0;
     semaphoreCreateInfo.pNext = nullptr;
 
-    vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &aquireSemaphore);
-    vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &submitSemaphore);
-
-    // Create command pool
+    // Each slot owns a transient pool that is reset as a whole once its frame has completed
     VkCommandPoolCreateInfo poolInfo = {};
     poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
     poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
-    
-    vkCreateCommandPool(device, &poolInfo, nullptr, &cmdPool);
+
+    frames.resize(framesInFlight);
+    for (KonideFrameSlot& frame : frames) {
+        if (deviceTable.vkCreateCommandPool(device, &poolInfo, nullptr, &frame.cmdPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create frame command pool.");
+        }
+
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        allocInfo.commandPool = frame.cmdPool;
+        if (deviceTable.vkAllocateCommandBuffers(device, &allocInfo, &frame.cmdBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate frame command buffer.");
+        }
+        commandStats.commandBufferAllocations++;
+
+        // Cached layer recordings outlive a frame, their pool is never reset as a whole
+        VkCommandPoolCreateInfo cachePoolInfo = {};
+        cachePoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        cachePoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        cachePoolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+        if (deviceTable.vkCreateCommandPool(device, &cachePoolInfo, nullptr, &frame.cachePool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create layer cache command pool.");
+        }
+
+        // One acquire semaphore per output, GatherFrameOutputs adds more when compositions show up
+        frame.aquireSemaphores.resize(1 + Compositions.size());
+        for (VkSemaphore& semaphore : frame.aquireSemaphores) {
+            if (deviceTable.vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphore) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create frame synchronization objects.");
+            }
+        }
+    }
+
+    currentFrame = 0;
+}
+
+void KonideRenderer::DestroyFrameSlots()
+{
+    for (KonideFrameSlot& frame : frames) {
+        // Destroying the pool releases the slot's command buffer with it
+        deviceTable.vkDestroyCommandPool(device, frame.cmdPool, nullptr);
+        deviceTable.vkDestroyCommandPool(device, frame.cachePool, nullptr);
+        for (VkSemaphore semaphore : frame.aquireSemaphores) {
+            deviceTable.vkDestroySemaphore(device, semaphore, nullptr);
+        }
+    }
+
+    frames.clear();
 }
 
-void KonideRenderer::FlushRender()
+void KonideRenderer::SetFramesInFlight(uint32_t count)
 {
-    uint32_t imgIdx;
-    vkAcquireNextImageKHR(device, swapchain.swapchain, 0, aquireSemaphore, 0, &imgIdx);
+    count = std::clamp<uint32_t>(count, 1, KONIDE_MAX_FRAMES_IN_FLIGHT);
+    if (count == framesInFlight) {
+        return;
+    }
+
+    framesInFlight = count;
+
+    // Slots already exist, rebuild them once nothing references the old ones
+    if (!frames.empty()) {
+        deviceTable.vkDeviceWaitIdle(device);
+        completedFrames = frameNumber;
+        ProcessDeferredDeletions();
+
+        DestroyFrameSlots();
+        CreateFrameSlots();
+    }
+}
+
+void KonideRenderer::SetRecordingThreads(uint32_t count)
+{
+    // Read by the thread running FlushRender
+    if (IsOffRenderThread()) {
+        EnqueueFrameUpdate(nullptr, nullptr, [this, count]() { SetRecordingThreads(count); });
+        return;
+    }
+
+    recordingThreads = count;
+}
+
+void KonideRenderer::SetAcquirePolicy(EKonideAcquirePolicy policy, uint64_t timeout)
+{
+    acquirePolicy = policy;
+
+    switch (policy) {
+    case KONIDE_ACQUIRE_BOUNDED_WAIT:
+        acquireTimeout = timeout;
+        break;
+    case KONIDE_ACQUIRE_SKIP_FRAME:
+        acquireTimeout = 0;
+        break;
+    default:
+        acquireTimeout = UINT64_MAX;
+        break;
+    }
+}
+
+VkCommandBuffer KonideRenderer::GetCachedLayerBuffer(KonideFrameSlot& frame, KonideLayer* layer, KonideSwapchain& target)
+{
+    KonideLayerCacheEntry& entry = frame.layerCache[{ layer, &target }];
+
+    if (entry.commandBuffer && entry.revision == layer->GetRevision() && entry.swapchainGeneration == target.generation) {
+        commandStats.layerCacheHits++;
+        return entry.commandBuffer;
+    }
+
+    if (!entry.commandBuffer) {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+        allocInfo.commandPool = frame.cachePool;
+        if (deviceTable.vkAllocateCommandBuffers(device, &allocInfo, &entry.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate layer cache command buffer.");
+        }
+        commandStats.commandBufferAllocations++;
+    }
+
+    // The slot's previous frame is complete, so its buffer is idle and may be re-recorded
+    VkCommandBufferInheritanceRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachmentFormats = &target.swapChainImageFormat;
+    renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
-    VkCommandBufferAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandBufferCount = 1;
-    allocInfo.commandPool = cmdPool;
-    vkAllocateCommandBuffers(device, &allocInfo, &cmdBuffer);
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = &renderingInfo;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    deviceTable.vkBeginCommandBuffer(entry.commandBuffer, &beginInfo);
+    layer->EncodeCommands(commandArena);
+    commandStats.encodedCommands += layer->GetCommandList().GetCommandCount();
+    commandStats.lastFrameEncodedBytes += layer->GetCommandList().GetSize();
+    commandStats.sortedDraws += layer->GetCommandList().GetDrawCount();
+    layer->Render(entry.commandBuffer, device);
+    deviceTable.vkEndCommandBuffer(entry.commandBuffer);
+
+    entry.revision = layer->GetRevision();
+    entry.swapchainGeneration = target.generation;
+    commandStats.layerCacheRecords++;
+
+    return entry.commandBuffer;
+}
+
+void KonideRenderer::EvictLayerCache(const KonideLayer* layer, const KonideSwapchain* target)
+{
+    for (KonideFrameSlot& frame : frames) {
+        std::vector<VkCommandBuffer> evicted;
+        for (auto entry = frame.layerCache.begin(); entry != frame.layerCache.end();) {
+            bool bMatch = (!layer || entry->first.first == layer) && (!target || entry->first.second == target);
+            if (!bMatch) {
+                ++entry;
+                continue;
+            }
+
+            if (entry->second.commandBuffer) {
+                evicted.push_back(entry->second.commandBuffer);
+            }
+            entry = frame.layerCache.erase(entry);
+        }
+
+        if (evicted.empty()) {
+            continue;
+        }
+
+        // The slot's last frame may still be executing them
+        VkCommandPool pool = frame.cachePool;
+        DeferDestruction([this, pool, evicted]() {
+            deviceTable.vkFreeCommandBuffers(device, pool, static_cast<uint32_t>(evicted.size()), evicted.data());
+        });
+    }
+}
+
+void KonideRenderer::RenderOutputLayers(VkCommandBuffer commandBuffer, KonideFrameSlot& frame, const KonideFrameOutput& output, uint32_t firstRecorded, KonideFrameGraphResource target)
+{
+    KonideSwapchain& swapchainTarget = *output.swapchain;
+
+    // Cleared on load, so tilers never read the old contents back in
+    VkRenderingAttachmentInfo colorAttachment = {};
+    colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+    colorAttachment.imageView = frameGraph.GetImageView(target);
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = frameGraph.GetAttachmentLoadOp(target, VK_ATTACHMENT_LOAD_OP_CLEAR);
+    colorAttachment.storeOp = frameGraph.GetAttachmentStoreOp(target);
+    colorAttachment.clearValue.color = { { 1, 1, 0, 1 } };
+
+    VkRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.renderArea.extent = swapchainTarget.swapChainExtent;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+
+    const std::vector<KonideLayer*>& layers = *output.layers;
+
+    if (recordingThreads > 0) {
+        // Layer order is kept across cached and freshly recorded buffers
+        uint32_t layerBufferIdx = firstRecorded;
+        outputBuffers.clear();
+        for (KonideLayer* layer : layers) {
+            outputBuffers.push_back(layer->IsCacheable() ? GetCachedLayerBuffer(frame, layer, swapchainTarget) : layerBuffers[layerBufferIdx++]);
+        }
+
+        renderingInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+        deviceTable.vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        if (!outputBuffers.empty()) {
+            deviceTable.vkCmdExecuteCommands(commandBuffer, (uint32_t)outputBuffers.size(), outputBuffers.data());
+        }
+        deviceTable.vkCmdEndRendering(commandBuffer);
+        return;
+    }
+
+    // A rendering instance holds either inline commands or secondaries, so runs of each get their own
+    // instance, suspended and resumed so the attachment is loaded and stored only once
+    size_t runStart = 0;
+    do {
+        size_t runEnd = runStart;
+        bool bCachedRun = runStart < layers.size() && layers[runStart]->IsCacheable();
+        while (runEnd < layers.size() && layers[runEnd]->IsCacheable() == bCachedRun) {
+            runEnd++;
+        }
+
+        renderingInfo.flags = bCachedRun ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
+        if (runStart > 0) {
+            renderingInfo.flags |= VK_RENDERING_RESUMING_BIT;
+        }
+        if (runEnd < layers.size()) {
+            renderingInfo.flags |= VK_RENDERING_SUSPENDING_BIT;
+        }
+
+        if (bCachedRun) {
+            // Stale recordings are redone before the instance begins
+            outputBuffers.clear();
+            for (size_t i = runStart; i < runEnd; i++) {
+                outputBuffers.push_back(GetCachedLayerBuffer(frame, layers[i], swapchainTarget));
+            }
+        }
+
+        deviceTable.vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        if (bCachedRun) {
+            deviceTable.vkCmdExecuteCommands(commandBuffer, (uint32_t)outputBuffers.size(), outputBuffers.data());
+        } else {
+            for (size_t i = runStart; i < runEnd; i++) {
+                layers[i]->Render(commandBuffer, device);
+            }
+        }
+        deviceTable.vkCmdEndRendering(commandBuffer);
+
+        runStart = runEnd;
+    } while (runStart < layers.size());
+}
+
+uint32_t KonideRenderer::AddLayer(KonideLayer* layer)
+{
+    layer->SetJobSystem(&jobSystem);
+    layer->SetDeviceTable(&deviceTable);
+    Composition.push_back(layer);
+    return Composition.size()-1;
+}
+
+void KonideRenderer::RemoveLayer(KonideLayer* layer)
+{
+    // Layers are walked by the thread running FlushRender
+    if (IsOffRenderThread()) {
+        EnqueueFrameUpdate(layer, nullptr, [this, layer]() { RemoveLayer(layer); });
+        return;
+    }
+
+    Composition.erase(std::remove(Composition.begin(), Composition.end(), layer), Composition.end());
+    for (KonideComposition* composition : Compositions) {
+        composition->RemoveLayer(layer);
+    }
+
+    // Another layer allocated at the same address must not find these recordings
+    EvictLayerCache(layer, nullptr);
+}
+
+KonideLayer* KonideRenderer::GetLayer(uint32_t id)
+{
+    return Composition[id];
+}
+
+void KonideRenderer::GatherFrameOutputs()
+{
+    frameOutputs.clear();
+
+    if (swapchain.surface) {
+        KonideFrameOutput output;
+        output.swapchain = &swapchain;
+        output.layers = &Composition;
+        frameOutputs.push_back(output);
+    }
+
+    for (KonideComposition* composition : Compositions) {
+        KonideFrameOutput output;
+        output.swapchain = &composition->GetSwapchain();
+        output.composition = composition;
+        output.layers = &composition->GetLayers();
+        frameOutputs.push_back(output);
+
+        // Layers reach compositions without the renderer, they record through its tables like its own
+        for (KonideLayer* layer : composition->GetLayers()) {
+            layer->SetJobSystem(&jobSystem);
+            layer->SetDeviceTable(&deviceTable);
+        }
+    }
+
+    // Compositions created after the slot grow its acquire semaphores here
+    KonideFrameSlot& frame = frames[currentFrame];
+    while (frame.aquireSemaphores.size() < frameOutputs.size()) {
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        VkSemaphore semaphore;
+        if (deviceTable.vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create frame synchronization objects.");
+        }
+        frame.aquireSemaphores.push_back(semaphore);
+    }
+
+    for (size_t i = 0; i < frameOutputs.size(); i++) {
+        frameOutputs[i].acquireSemaphore = frame.aquireSemaphores[i];
+    }
+}
+
+bool KonideRenderer::FlushRender()
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Low latency mode paces here, before any frame work, unless the application already did
+    WaitForFrameLatency();
+
+    // Resets requested since the last frame take effect from this one on
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if (bResetPacingStats) {
+            pacingStats = KonideFramePacingStats();
+            bResetPacingStats = false;
+        }
+        if (bResetCommandStats) {
+            commandStats = KonideCommandStats();
+            bResetCommandStats = false;
+        }
+    }
+
+    Clock::time_point frameStart = Clock::now();
+
+    KonideFrameSlot& frame = frames[currentFrame];
+
+    // Only block on the frame that last used this slot, later frames keep running on the GPU
+    WaitForFrame(frame.submittedFrames);
+    Clock::time_point waitEnd = Clock::now();
+
+    GetCompletedFrameValue();
+    ProcessDeferredDeletions();
+
+    GatherFrameOutputs();
+
+    for (KonideFrameOutput& output : frameOutputs) {
+        if (!output.swapchain->bOutOfDate) {
+            continue;
+        }
+
+        if (output.swapchain == &swapchain) {
+            CreateSwapchain(swapchain.requestedWidth, swapchain.requestedHeight);
+        } else {
+            BuildSwapchain(*output.swapchain, output.swapchain->requestedWidth, output.swapchain->requestedHeight);
+        }
+    }
+
+    // Acquire every output up front, before any recording, so a frame that can't be presented costs nothing.
+    // Outputs without an image this time are left out of the frame, nothing was signaled for them.
+    Clock::time_point acquireStart = Clock::now();
+    uint32_t acquiredCount = 0;
+    for (KonideFrameOutput& output : frameOutputs) {
+        KonideSwapchain& target = *output.swapchain;
+        if (!target.swapchain || target.bOutOfDate) {
+            continue;
+        }
+
+        VkResult acquireResult = deviceTable.vkAcquireNextImageKHR(device, target.swapchain, acquireTimeout, output.acquireSemaphore, 0, &output.imageIndex);
+        if (acquireResult == VK_NOT_READY || acquireResult == VK_TIMEOUT) {
+            continue;
+        }
+        if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR) {
+            target.bOutOfDate = true;
+            continue;
+        }
+        if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
+            throw std::runtime_error("failed to acquire swapchain image.");
+        }
+
+        // Still presentable, rebuild once this image is back
+        if (acquireResult == VK_SUBOPTIMAL_KHR) {
+            target.bOutOfDate = true;
+        }
+
+        output.bAcquired = true;
+        acquiredCount++;
+    }
+    Clock::time_point acquireEnd = Clock::now();
+
+    if (acquiredCount == 0) {
+        pacingStats.skippedFrames++;
+        // A skipped frame still reports its own calls, they don't carry over into the next one
+        CollectVulkanCalls();
+        PublishFrameStats();
+        return false;
+    }
+
+    // The slot's previous submission is complete, recycle its command memory in one go
+    deviceTable.vkResetCommandPool(device, frame.cmdPool, 0);
+    commandStats.commandPoolResets++;
+
+    VkCommandBuffer cmdBuffer = frame.cmdBuffer;
 
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmdBuffer, &beginInfo);
+    deviceTable.vkBeginCommandBuffer(cmdBuffer, &beginInfo);
 
     // Rendering Commands
     {
-        VkClearColorValue color = { 1, 1, 0, 1 };
-        VkImageSubresourceRange range = {};
-        range.layerCount = 1;
-        range.levelCount = 1;
-        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        // Layers encode their lists in parallel before anything is recorded, lists from the previous frame are dropped
+        commandArena.Reset();
+        encodeLayers.clear();
+        for (KonideFrameOutput& output : frameOutputs) {
+            if (!output.bAcquired) {
+                continue;
+            }
 
-        vkCmdClearColorImage(cmdBuffer, swapchain.images[imgIdx], VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, &color, 1, &range);
+            for (KonideLayer* layer : *output.layers) {
+                if (!layer->IsCacheable()) {
+                    encodeLayers.push_back(layer);
+                }
+            }
+        }
 
-        for(KonideComposition* composition : Compositions)
-        {
-            composition->Render(cmdBuffer, device);
+        jobSystem.ParallelFor((uint32_t)encodeLayers.size(), 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                encodeLayers[i]->EncodeCommands(commandArena);
+            }
+        });
+
+        commandStats.lastFrameEncodedBytes = 0;
+        for (KonideLayer* layer : encodeLayers) {
+            commandStats.encodedCommands += layer->GetCommandList().GetCommandCount();
+            commandStats.lastFrameEncodedBytes += layer->GetCommandList().GetSize();
+            commandStats.sortedDraws += layer->GetCommandList().GetDrawCount();
+        }
+
+        if (recordingThreads > 0) {
+            // One flat list so every output's layers record in parallel: renderer layers first, then each composition's.
+            // Cacheable layers replay their cached buffers instead.
+            recordLayers.clear();
+            recordFormats.clear();
+            for (KonideFrameOutput& output : frameOutputs) {
+                if (!output.bAcquired) {
+                    continue;
+                }
+
+                for (KonideLayer* layer : *output.layers) {
+                    if (!layer->IsCacheable()) {
+                        recordLayers.push_back(layer);
+                        recordFormats.push_back(output.swapchain->swapChainImageFormat);
+                    }
+                }
+            }
+
+            commandStats.commandBufferAllocations += layerRecorder.Record(recordLayers, recordFormats, currentFrame, recordingThreads, layerBuffers);
+        }
+
+        frameGraph.Reset();
+
+        uint32_t recordedIdx = 0;
+        for (KonideFrameOutput& output : frameOutputs) {
+            if (!output.bAcquired) {
+                continue;
+            }
+
+            KonideSwapchain& target = *output.swapchain;
+            VkImage image = target.images[output.imageIndex];
+
+            VkImageSubresourceRange range = {};
+            range.layerCount = 1;
+            range.levelCount = 1;
+            range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+            // The acquire semaphore is waited on at color attachment output, so the first transition waits there too
+            KonideFrameGraphResource backbuffer = frameGraph.ImportImage(output.composition ? "composition" : "swapchain", image,
+                target.imageViews[output.imageIndex], range, VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+            for (KonideLayer* layer : *output.layers) {
+                layer->SetupPasses(frameGraph, backbuffer);
+            }
+
+            uint32_t firstRecorded = recordedIdx;
+            if (recordingThreads > 0) {
+                for (KonideLayer* layer : *output.layers) {
+                    recordedIdx += layer->IsCacheable() ? 0 : 1;
+                }
+            }
+
+            const KonideFrameOutput* layerOutput = &output;
+            frameGraph.AddPass("layers", [backbuffer](KonideFrameGraphPassBuilder& builder) {
+                builder.ColorAttachment(backbuffer);
+            }, [this, &frame, layerOutput, firstRecorded, backbuffer](VkCommandBuffer commandBuffer) {
+                RenderOutputLayers(commandBuffer, frame, *layerOutput, firstRecorded, backbuffer);
+            });
         }
+
+        frameGraph.Compile();
+        frameGraph.Execute(cmdBuffer);
+
+        // Recording is done on every thread by now
+        commandStats.lastFrameElidedStateCalls = 0;
+        for (KonideFrameOutput& output : frameOutputs) {
+            if (!output.bAcquired) {
+                continue;
+            }
+
+            for (KonideLayer* layer : *output.layers) {
+                const KonideCommandRecorderStats& recorderStats = layer->GetRecorderStats();
+                commandStats.issuedStateCalls += recorderStats.issuedCalls;
+                commandStats.elidedStateCalls += recorderStats.elidedCalls;
+                commandStats.lastFrameElidedStateCalls += recorderStats.elidedCalls;
+                layer->ResetRecorderStats();
+            }
+        }
+
+        const KonideFrameGraphStats& graphStats = frameGraph.GetStats();
+        commandStats.barrierBatches += graphStats.barrierBatches;
+        commandStats.imageBarriers += graphStats.imageBarriers;
+        commandStats.bufferBarriers += graphStats.bufferBarriers;
+        commandStats.layoutTransitions += graphStats.layoutTransitions;
+        commandStats.lastFrameBarrierBatches = graphStats.barrierBatches;
+        commandStats.lastFrameBarriers = graphStats.imageBarriers + graphStats.bufferBarriers;
     }
 
-    vkEndCommandBuffer(cmdBuffer);
+    deviceTable.vkEndCommandBuffer(cmdBuffer);
+    Clock::time_point recordEnd = Clock::now();
 
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    uint64_t frameValue = frameNumber + 1;
 
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pWaitDstStageMask = &waitStage;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmdBuffer;
-    submitInfo.pSignalSemaphores = &submitSemaphore;
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = &aquireSemaphore;
-    submitInfo.waitSemaphoreCount = 1;
+    presentSwapchains.clear();
+    presentImageIndices.clear();
+    presentWaitSemaphores.clear();
+    presentIds.clear();
 
-    vkQueueSubmit(graphicsQueue, 1, &submitInfo, 0);
-    
+    // Anything queued on the batcher before this point rides along in the same submit call
+    for (KonideFrameOutput& output : frameOutputs) {
+        if (output.bAcquired) {
+            submitBatcher.AddWait(graphicsQueue, output.acquireSemaphore, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+        }
+    }
+    submitBatcher.AddCommandBuffer(graphicsQueue, cmdBuffer);
+    for (KonideFrameOutput& output : frameOutputs) {
+        if (!output.bAcquired) {
+            continue;
+        }
+
+        VkSemaphore presentSemaphore = output.swapchain->presentSemaphores[output.imageIndex];
+        submitBatcher.AddSignal(graphicsQueue, presentSemaphore, 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+        presentSwapchains.push_back(output.swapchain->swapchain);
+        presentImageIndices.push_back(output.imageIndex);
+        presentWaitSemaphores.push_back(presentSemaphore);
+        presentIds.push_back(frameValue);
+    }
+    submitBatcher.AddSignal(graphicsQueue, frameTimeline, frameValue, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+
+    uint32_t submitCount = submitBatcher.Flush(deviceTable);
+    commandStats.queueSubmits += submitCount;
+    commandStats.lastFrameQueueSubmits = submitCount;
+    Clock::time_point submitEnd = Clock::now();
+
+    frameNumber = frameValue;
+    frame.submittedFrames = frameValue;
+
+    if (bLowLatencyMode) {
+        pendingLatencyFrames.push_back({ frameValue, frameStartTime });
+    }
+    bFrameStarted = false;
+
+    presentResults.assign(presentSwapchains.size(), VK_SUCCESS);
+
+    // Every acquired output goes out in a single present call
     VkPresentInfoKHR presentInfo = {};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.pSwapchains = &swapchain.swapchain;
-    presentInfo.swapchainCount = 1;
-    presentInfo.pImageIndices = &imgIdx;
-    presentInfo.pWaitSemaphores = &submitSemaphore;
-    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pSwapchains = presentSwapchains.data();
+    presentInfo.swapchainCount = (uint32_t)presentSwapchains.size();
+    presentInfo.pImageIndices = presentImageIndices.data();
+    presentInfo.pWaitSemaphores = presentWaitSemaphores.data();
+    presentInfo.waitSemaphoreCount = (uint32_t)presentWaitSemaphores.size();
+    presentInfo.pResults = presentResults.data();
+
+    // Tag the present with its frame value so present wait can track it
+    VkPresentIdKHR presentId = {};
+    presentId.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+    presentId.swapchainCount = (uint32_t)presentIds.size();
+    presentId.pPresentIds = presentIds.data();
+
+    if (bPresentWaitSupported) {
+        presentInfo.pNext = &presentId;
+        if (swapchainFirstPresentId == 0 && frameOutputs[0].swapchain == &swapchain && frameOutputs[0].bAcquired) {
+            swapchainFirstPresentId = frameValue;
+        }
+    }
 
-    vkQueuePresentKHR(presentQueue, &presentInfo);
+    deviceTable.vkQueuePresentKHR(presentQueue, &presentInfo);
+    Clock::time_point presentEnd = Clock::now();
+
+    currentFrame = (currentFrame + 1) % framesInFlight;
+
+    Clock::time_point frameEnd = Clock::now();
+    double frameWait = std::chrono::duration<double>(waitEnd - frameStart).count();
+    double total = std::chrono::duration<double>(frameEnd - frameStart).count();
+    double acquireWait = std::chrono::duration<double>(acquireEnd - acquireStart).count();
+
+    pacingStats.frameCount++;
+    pacingStats.totalTime += total;
+    pacingStats.frameWaitTime += frameWait;
+    pacingStats.acquireWaitTime += acquireWait;
+    pacingStats.cpuTime += total - frameWait - acquireWait;
+
+    KonideFrameTiming timing;
+    timing.frame = frameValue;
+    timing.phases[KONIDE_FRAME_PHASE_FRAME_WAIT] = frameWait;
+    timing.phases[KONIDE_FRAME_PHASE_ACQUIRE_WAIT] = acquireWait;
+    timing.phases[KONIDE_FRAME_PHASE_RECORD] = std::chrono::duration<double>(recordEnd - acquireEnd).count();
+    timing.phases[KONIDE_FRAME_PHASE_SUBMIT] = std::chrono::duration<double>(submitEnd - recordEnd).count();
+    timing.phases[KONIDE_FRAME_PHASE_PRESENT] = std::chrono::duration<double>(presentEnd - submitEnd).count();
+    timing.phases[KONIDE_FRAME_PHASE_TOTAL] = total;
+    frameStats.Record(timing);
+
+    CollectVulkanCalls();
+    PublishFrameStats();
+
+#ifdef KONIDE_VULKAN_CAPTURE
+    if (traceWriter) {
+        traceWriter->WriteFrame(frameValue);
+    }
+#endif
 
-    vkDeviceWaitIdle(device);
+    // Outputs that went out of date are rebuilt at the start of the next frame
+    uint32_t presentIdx = 0;
+    for (KonideFrameOutput& output : frameOutputs) {
+        if (!output.bAcquired) {
+            continue;
+        }
 
-    vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
+        VkResult presentResult = presentResults[presentIdx++];
+        if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR) {
+            output.swapchain->bOutOfDate = true;
+        } else if (presentResult != VK_SUCCESS) {
+            throw std::runtime_error("failed to present swapchain image.");
+        }
+    }
+
+    return true;
+}
+
+void KonideRenderer::CollectVulkanCalls()
+{
+#ifdef KONIDE_VULKAN_INSTRUMENTATION
+    std::lock_guard<std::mutex> lock(vulkanCallMutex);
+    lastFrameVulkanCalls.clear();
+    instanceTable.callRegistry.Collect(lastFrameVulkanCalls);
+    deviceTable.callRegistry.Collect(lastFrameVulkanCalls);
+#endif
+}
+
+void KonideRenderer::PublishFrameStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
 
+    // A reset requested during this frame stays pending, the getters report zeros until the next frame publishes
+    if (!bResetPacingStats) {
+        publishedPacingStats = pacingStats;
+    }
+    if (!bResetCommandStats) {
+        publishedCommandStats = commandStats;
+    }
+}
+
+KonideFramePacingStats KonideRenderer::GetPacingStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return publishedPacingStats;
+}
+
+void KonideRenderer::ResetPacingStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    publishedPacingStats = KonideFramePacingStats();
+    bResetPacingStats = true;
+}
+
+KonideCommandStats KonideRenderer::GetCommandStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return publishedCommandStats;
+}
+
+void KonideRenderer::ResetCommandStats()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    publishedCommandStats = KonideCommandStats();
+    bResetCommandStats = true;
+}
+
+std::deque<KonideLatencySample> KonideRenderer::GetLatencySamples()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return latencySamples;
+}
+
+void KonideRenderer::ClearLatencySamples()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    latencySamples.clear();
+}
+
+std::vector<KonideVulkanCallStats> KonideRenderer::GetVulkanCallStats()
+{
+    std::lock_guard<std::mutex> lock(vulkanCallMutex);
+    return lastFrameVulkanCalls;
+}
+
+bool KonideRenderer::StartVulkanCapture(const char* path)
+{
+#ifdef KONIDE_VULKAN_CAPTURE
+    if (!traceWriter) {
+        traceWriter = std::make_unique<KonideTraceWriter>();
+    }
+
+    StopVulkanCapture();
+    if (!traceWriter->Open(path)) {
+        return false;
+    }
+
+    // Memory mapped before the capture started is written in full on the first submit
+    deviceTable.callRegistry.memory.MarkAllDirty();
+    instanceTable.callRegistry.traceWriter.store(traceWriter.get(), std::memory_order_release);
+    deviceTable.callRegistry.traceWriter.store(traceWriter.get(), std::memory_order_release);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void KonideRenderer::StopVulkanCapture()
+{
+#ifdef KONIDE_VULKAN_CAPTURE
+    instanceTable.callRegistry.traceWriter.store(nullptr, std::memory_order_release);
+    deviceTable.callRegistry.traceWriter.store(nullptr, std::memory_order_release);
+    if (traceWriter) {
+        traceWriter->Close();
+    }
+#endif
+}
+
+KonideTraceStats KonideRenderer::GetVulkanCaptureStats()
+{
+    return traceWriter ? traceWriter->GetStats() : KonideTraceStats();
 }
 
 KonideRenderer::~KonideRenderer()
 {
+    StopRenderThread();
+
+    // Jobs may still reference layers or Vulkan objects
+    jobSystem.Stop();
+
+    if (device) {
+        deviceTable.vkDeviceWaitIdle(device);
+
+        completedFrames = frameNumber;
+        ProcessDeferredDeletions();
+
+        layerRecorder.Destroy();
+        frameGraph.Shutdown();
+        DestroyFrameSlots();
+        DestroySwapchain(swapchain);
+
+        for (KonideComposition* composition : Compositions) {
+            DestroySwapchain(composition->GetSwapchain());
+        }
+
+        deviceTable.vkDestroySemaphore(device, frameTimeline, nullptr);
+    }
+
+    for (KonideComposition* composition : Compositions) {
+        VkSurfaceKHR surface = composition->GetSwapchain().surface;
+        if (surface) instanceTable.vkDestroySurfaceKHR(instance, surface, nullptr);
+        delete composition;
+    }
+    Compositions.clear();
+
     if(RenderFeatureFlags & KONIDE_RENDER_FEATURE_VALIDATION_LAYERS)
     {
-        vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
+        instanceTable.vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
     }
 
-    for (auto imageView : swapchain.imageViews) {
-        vkDestroyImageView(device, imageView, nullptr);
-    }
+    if(swapchain.surface) instanceTable.vkDestroySurfaceKHR(instance, swapchain.surface, nullptr);
 
-    if (swapchain.swapchain) vkDestroySwapchainKHR(device, swapchain.swapchain, nullptr);
-    if(swapchain.surface) vkDestroySurfaceKHR(instance, swapchain.surface, nullptr);
+    deviceTable.vkDestroyDevice(device, nullptr);
+    instanceTable.vkDestroyInstance(instance, nullptr);
 
-    vkDestroyDevice(device, nullptr);
-    vkDestroyInstance(instance, nullptr);
-}
\ No newline at end of file
+    // Teardown is part of the trace
+    StopVulkanCapture();
+}
@@ -0,0 +1,162 @@
+#include <konide/renderer.h>
+
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+static double SecondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void KonideRenderer::StartRenderThread(uint32_t maxPending)
+{
+    if (IsRenderThreadRunning()) {
+        return;
+    }
+
+    maxPendingPackets = maxPending > 0 ? maxPending : 1;
+    bRenderThreadExit = false;
+    renderThreadError = nullptr;
+
+    renderThread = std::thread(&KonideRenderer::RenderThreadMain, this);
+}
+
+void KonideRenderer::StopRenderThread()
+{
+    if (!IsRenderThreadRunning()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(packetMutex);
+        bRenderThreadExit = true;
+    }
+    packetCondition.notify_one();
+
+    renderThread.join();
+}
+
+bool KonideRenderer::IsOffRenderThread() const
+{
+    return IsRenderThreadRunning() && std::this_thread::get_id() != renderThread.get_id();
+}
+
+void KonideRenderer::EnqueueFrameUpdate(KonideLayer* layer, KonideProxy* proxy, std::function<void()> apply)
+{
+    KonideStateDelta delta;
+    delta.layer = layer;
+    delta.proxy = proxy;
+    delta.apply = std::move(apply);
+
+    buildingPacket.deltas.push_back(std::move(delta));
+}
+
+void KonideRenderer::SubmitFramePacket()
+{
+    if (!IsRenderThreadRunning()) {
+        for (KonideStateDelta& delta : buildingPacket.deltas) {
+            delta.apply();
+        }
+        buildingPacket = KonideFramePacket();
+
+        FlushRender();
+        return;
+    }
+
+    Clock::time_point handoffStart = Clock::now();
+    std::exception_ptr error;
+
+    {
+        std::unique_lock<std::mutex> lock(packetMutex);
+
+        // Render thread is behind, hold the application back until it takes a packet
+        if (!renderThreadError && pendingPackets.size() >= maxPendingPackets) {
+            renderThreadStats.packetsBlocked++;
+            packetSpaceCondition.wait(lock, [this]() { return renderThreadError || pendingPackets.size() < maxPendingPackets; });
+            renderThreadStats.appWaitTime += SecondsBetween(handoffStart, Clock::now());
+        }
+
+        if (renderThreadError) {
+            error = renderThreadError;
+            renderThreadError = nullptr;
+        } else {
+            buildingPacket.packetIndex = ++packetCounter;
+            buildingPacket.submitTime = handoffStart;
+            pendingPackets.push_back(std::move(buildingPacket));
+
+            renderThreadStats.packetsSubmitted++;
+            renderThreadStats.appHandoffTime += SecondsBetween(handoffStart, Clock::now());
+        }
+    }
+
+    buildingPacket = KonideFramePacket();
+
+    if (error) {
+        // The render thread stopped after the failure, further packets are rendered inline
+        renderThread.join();
+        std::rethrow_exception(error);
+    }
+
+    packetCondition.notify_one();
+}
+
+void KonideRenderer::RenderThreadMain()
+{
+    while (true) {
+        KonideFramePacket packet;
+
+        Clock::time_point idleStart = Clock::now();
+        {
+            std::unique_lock<std::mutex> lock(packetMutex);
+            packetCondition.wait(lock, [this]() { return bRenderThreadExit || !pendingPackets.empty(); });
+
+            // Exit only once every submitted packet has been rendered
+            if (pendingPackets.empty()) {
+                break;
+            }
+
+            packet = std::move(pendingPackets.front());
+            pendingPackets.pop_front();
+        }
+        packetSpaceCondition.notify_one();
+        Clock::time_point applyStart = Clock::now();
+        Clock::time_point flushStart;
+
+        try {
+            for (KonideStateDelta& delta : packet.deltas) {
+                delta.apply();
+            }
+            flushStart = Clock::now();
+
+            FlushRender();
+        } catch (...) {
+            // Handed to the application thread by its next SubmitFramePacket, packets queued behind this one are dropped
+            std::lock_guard<std::mutex> lock(packetMutex);
+            renderThreadError = std::current_exception();
+            pendingPackets.clear();
+            packetSpaceCondition.notify_one();
+            break;
+        }
+        Clock::time_point flushEnd = Clock::now();
+
+        std::lock_guard<std::mutex> lock(packetMutex);
+        renderThreadStats.packetsRendered++;
+        renderThreadStats.renderIdleTime += SecondsBetween(idleStart, applyStart);
+        renderThreadStats.renderApplyTime += SecondsBetween(applyStart, flushStart);
+        renderThreadStats.renderFlushTime += SecondsBetween(flushStart, flushEnd);
+        renderThreadStats.packetQueueTime += SecondsBetween(packet.submitTime, applyStart);
+    }
+}
+
+KonideRenderThreadStats KonideRenderer::GetRenderThreadStats()
+{
+    std::lock_guard<std::mutex> lock(packetMutex);
+    return renderThreadStats;
+}
+
+void KonideRenderer::ResetRenderThreadStats()
+{
+    std::lock_guard<std::mutex> lock(packetMutex);
+    renderThreadStats = KonideRenderThreadStats();
+}
@@ -0,0 +1,138 @@
+#include <konide/submitbatcher.h>
+
+#include <stdexcept>
+
+KonideQueueSubmission& KonideSubmitBatcher::GetSubmission(VkQueue queue)
+{
+    // A frame only touches a handful of queues, a linear search beats any map here
+    for (KonideQueueSubmission& submission : submissions) {
+        if (submission.queue == queue) {
+            return submission;
+        }
+    }
+
+    submissions.emplace_back();
+    submissions.back().queue = queue;
+    return submissions.back();
+}
+
+KonideSubmitBatch& KonideSubmitBatcher::OpenBatch(KonideQueueSubmission& submission)
+{
+    if (submission.batchCount == submission.batches.size()) {
+        submission.batches.emplace_back();
+    }
+
+    return submission.batches[submission.batchCount++];
+}
+
+void KonideSubmitBatcher::AddWait(VkQueue queue, VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags2 stageMask)
+{
+    KonideQueueSubmission& submission = GetSubmission(queue);
+
+    // Waits guard every command buffer of their batch, so they can't join one that already has work
+    if (submission.batchCount == 0 ||
+        !submission.batches[submission.batchCount - 1].commandBuffers.empty() ||
+        !submission.batches[submission.batchCount - 1].signals.empty()) {
+        OpenBatch(submission);
+    }
+
+    VkSemaphoreSubmitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    waitInfo.semaphore = semaphore;
+    waitInfo.value = value;
+    waitInfo.stageMask = stageMask;
+
+    submission.batches[submission.batchCount - 1].waits.push_back(waitInfo);
+}
+
+void KonideSubmitBatcher::AddCommandBuffer(VkQueue queue, VkCommandBuffer commandBuffer)
+{
+    KonideQueueSubmission& submission = GetSubmission(queue);
+
+    if (submission.batchCount == 0 || !submission.batches[submission.batchCount - 1].signals.empty()) {
+        OpenBatch(submission);
+    }
+
+    VkCommandBufferSubmitInfo commandBufferInfo = {};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = commandBuffer;
+
+    submission.batches[submission.batchCount - 1].commandBuffers.push_back(commandBufferInfo);
+}
+
+void KonideSubmitBatcher::AddSignal(VkQueue queue, VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags2 stageMask)
+{
+    KonideQueueSubmission& submission = GetSubmission(queue);
+
+    if (submission.batchCount == 0) {
+        OpenBatch(submission);
+    }
+
+    VkSemaphoreSubmitInfo signalInfo = {};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = semaphore;
+    signalInfo.value = value;
+    signalInfo.stageMask = stageMask;
+
+    submission.batches[submission.batchCount - 1].signals.push_back(signalInfo);
+}
+
+void KonideSubmitBatcher::SetFence(VkQueue queue, VkFence fence)
+{
+    GetSubmission(queue).fence = fence;
+}
+
+uint32_t KonideSubmitBatcher::Flush(const KonideDeviceTable& deviceTable)
+{
+    uint32_t submitCount = 0;
+
+    for (KonideQueueSubmission& submission : submissions) {
+        if (submission.batchCount == 0 && submission.fence == VK_NULL_HANDLE) {
+            continue;
+        }
+
+        submitInfos.clear();
+        for (uint32_t i = 0; i < submission.batchCount; i++) {
+            const KonideSubmitBatch& batch = submission.batches[i];
+            if (batch.IsEmpty()) {
+                continue;
+            }
+
+            VkSubmitInfo2 submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+            submitInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(batch.waits.size());
+            submitInfo.pWaitSemaphoreInfos = batch.waits.data();
+            submitInfo.commandBufferInfoCount = static_cast<uint32_t>(batch.commandBuffers.size());
+            submitInfo.pCommandBufferInfos = batch.commandBuffers.data();
+            submitInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(batch.signals.size());
+            submitInfo.pSignalSemaphoreInfos = batch.signals.data();
+            submitInfos.push_back(submitInfo);
+        }
+
+        if (deviceTable.vkQueueSubmit2(submission.queue, static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), submission.fence) != VK_SUCCESS) {
+            // Nothing queued so far may be submitted again by the next flush
+            Reset();
+            throw std::runtime_error("failed to submit queue batches.");
+        }
+        submitCount++;
+    }
+
+    Reset();
+
+    lastFlushSubmitCount = submitCount;
+    totalSubmitCount += submitCount;
+    return submitCount;
+}
+
+void KonideSubmitBatcher::Reset()
+{
+    for (KonideQueueSubmission& submission : submissions) {
+        for (uint32_t i = 0; i < submission.batchCount; i++) {
+            submission.batches[i].waits.clear();
+            submission.batches[i].commandBuffers.clear();
+            submission.batches[i].signals.clear();
+        }
+        submission.batchCount = 0;
+        submission.fence = VK_NULL_HANDLE;
+    }
+}
@@ -0,0 +1,206 @@
+#include <konide/trace.h>
+
+#include <atomic>
+#include <cstring>
+
+static uint32_t InternalThreadId()
+{
+    static std::atomic<uint32_t> nextThreadId{ 0 };
+    static thread_local uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+KonideTraceWriter::~KonideTraceWriter()
+{
+    Close();
+}
+
+bool KonideTraceWriter::Open(const char* path)
+{
+    Close();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    entrypoints.clear();
+    stats = KonideTraceStats();
+    start = std::chrono::steady_clock::now();
+    buffer.reserve(KONIDE_TRACE_BUFFER_SIZE);
+
+    KonideTraceFileHeader header = { KONIDE_TRACE_MAGIC, KONIDE_TRACE_VERSION, (uint32_t)sizeof(void*), 0 };
+    buffer.insert(buffer.end(), (const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+    stats.bytes += sizeof(header);
+    return true;
+}
+
+void KonideTraceWriter::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return;
+    }
+
+    Flush();
+    fclose(file);
+    file = nullptr;
+}
+
+bool KonideTraceWriter::IsOpen()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return file != nullptr;
+}
+
+uint64_t KonideTraceWriter::GetTime() const
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void KonideTraceWriter::Flush()
+{
+    if (!buffer.empty()) {
+        fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+}
+
+void KonideTraceWriter::WriteRecord(EKonideTraceRecord type, uint16_t entrypoint, uint64_t timestamp, uint64_t duration, const void* payload, uint32_t size, const void* extra, uint32_t extraSize)
+{
+    KonideTraceRecordHeader header = {};
+    header.type = (uint16_t)type;
+    header.entrypoint = entrypoint;
+    header.size = size + extraSize;
+    header.thread = InternalThreadId();
+    header.timestamp = timestamp;
+    header.duration = duration;
+
+    buffer.insert(buffer.end(), (const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+    buffer.insert(buffer.end(), (const uint8_t*)payload, (const uint8_t*)payload + size);
+    if (extraSize > 0) {
+        buffer.insert(buffer.end(), (const uint8_t*)extra, (const uint8_t*)extra + extraSize);
+    }
+    stats.bytes += sizeof(header) + size + extraSize;
+
+    if (buffer.size() >= KONIDE_TRACE_BUFFER_SIZE) {
+        Flush();
+    }
+}
+
+void KonideTraceWriter::WriteCall(const char* entrypoint, uint64_t timestamp, uint64_t duration, const std::vector<uint8_t>& payload)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return;
+    }
+
+    auto found = entrypoints.find(entrypoint);
+    if (found == entrypoints.end()) {
+        uint16_t id = (uint16_t)entrypoints.size();
+        found = entrypoints.emplace(entrypoint, id).first;
+        WriteRecord(KONIDE_TRACE_RECORD_ENTRYPOINT, id, timestamp, 0, entrypoint, (uint32_t)strlen(entrypoint));
+    }
+
+    WriteRecord(KONIDE_TRACE_RECORD_CALL, found->second, timestamp, duration, payload.data(), (uint32_t)payload.size());
+    stats.calls++;
+}
+
+void KonideTraceWriter::WriteFrame(uint64_t frame)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return;
+    }
+
+    WriteRecord(KONIDE_TRACE_RECORD_FRAME, 0, GetTime(), 0, &frame, sizeof(frame));
+    stats.frames++;
+}
+
+void KonideTraceWriter::WriteMemory(uint64_t memory, uint64_t offset, const void* data, uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) {
+        return;
+    }
+
+    KonideTraceMemoryHeader memoryHeader = { memory, offset };
+    WriteRecord(KONIDE_TRACE_RECORD_MEMORY, 0, GetTime(), 0, &memoryHeader, sizeof(memoryHeader), data, size);
+    stats.memoryBytes += size;
+}
+
+KonideTraceStats KonideTraceWriter::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+bool KonideTraceReader::Load(const char* path)
+{
+    data.clear();
+    entrypoints.clear();
+    records.clear();
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    uint8_t chunk[64 * 1024];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    fclose(file);
+
+    KonideTraceFileHeader fileHeader;
+    if (data.size() < sizeof(fileHeader)) {
+        return false;
+    }
+    memcpy(&fileHeader, data.data(), sizeof(fileHeader));
+    if (fileHeader.magic != KONIDE_TRACE_MAGIC || fileHeader.version != KONIDE_TRACE_VERSION || fileHeader.pointerSize != sizeof(void*)) {
+        return false;
+    }
+
+    size_t offset = sizeof(fileHeader);
+    while (data.size() - offset >= sizeof(KonideTraceRecordHeader)) {
+        KonideTraceRecord record;
+        memcpy(&record.header, data.data() + offset, sizeof(record.header));
+        offset += sizeof(record.header);
+        if (data.size() - offset < record.header.size) {
+            break;
+        }
+        record.payload = data.data() + offset;
+        offset += record.header.size;
+
+        switch (record.header.type) {
+        case KONIDE_TRACE_RECORD_ENTRYPOINT:
+            if (record.header.entrypoint != entrypoints.size()) {
+                return false;
+            }
+            entrypoints.emplace_back((const char*)record.payload, record.header.size);
+            break;
+        case KONIDE_TRACE_RECORD_CALL:
+            if (record.header.entrypoint >= entrypoints.size()) {
+                return false;
+            }
+            records.push_back(record);
+            break;
+        case KONIDE_TRACE_RECORD_FRAME:
+            records.push_back(record);
+            break;
+        case KONIDE_TRACE_RECORD_MEMORY:
+            if (record.header.size < sizeof(KonideTraceMemoryHeader)) {
+                return false;
+            }
+            records.push_back(record);
+            break;
+        default:
+            // Newer record kinds are skipped
+            break;
+        }
+    }
+
+    return true;
+}
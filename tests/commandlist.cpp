@@ -0,0 +1,163 @@
+#include <konide/commandlist.h>
+
+#include "konidetest.h"
+
+#include <vector>
+
+// Commands are kept in encoding order, BeginDraw markers included
+static void TestEncoding()
+{
+	KonideFrameArena arena;
+	KonideCommandList list;
+	list.Begin(arena);
+	KONIDE_CHECK(list.IsEmpty());
+	KONIDE_CHECK(list.IsCurrent());
+
+	VkBufferCopy region{};
+	region.size = 256;
+	VkDescriptorSet sets[2] = { (VkDescriptorSet)(uintptr_t)1, (VkDescriptorSet)(uintptr_t)2 };
+	uint32_t dynamicOffset = 64;
+	uint32_t constants[3] = { 1, 2, 3 };
+
+	list.CopyBuffer((VkBuffer)(uintptr_t)1, (VkBuffer)(uintptr_t)2, region);
+	list.BeginDraw(0);
+	list.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)3);
+	list.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipelineLayout)(uintptr_t)4, 0, 2, sets, 1, &dynamicOffset);
+	list.PushConstants((VkPipelineLayout)(uintptr_t)4, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), constants);
+	list.DrawIndexed(36);
+
+	const uint32_t expected[] = {
+		KONIDE_COMMAND_COPY_BUFFER, KONIDE_COMMAND_BEGIN_DRAW, KONIDE_COMMAND_BIND_PIPELINE,
+		KONIDE_COMMAND_BIND_DESCRIPTOR_SETS, KONIDE_COMMAND_PUSH_CONSTANTS, KONIDE_COMMAND_DRAW_INDEXED
+	};
+	std::vector<uint32_t> types;
+	bool bAligned = true;
+	list.ForEach([&](const KonideCommandHeader& command)
+	{
+		types.push_back(command.type);
+		bAligned &= command.size % KONIDE_COMMAND_ALIGNMENT == 0;
+
+		// Trailing data comes back as encoded
+		if (command.type == KONIDE_COMMAND_BIND_DESCRIPTOR_SETS)
+		{
+			const KonideCommandBindDescriptorSets& bind = reinterpret_cast<const KonideCommandBindDescriptorSets&>(command);
+			const VkDescriptorSet* boundSets = reinterpret_cast<const VkDescriptorSet*>(&bind + 1);
+			const uint32_t* offsets = reinterpret_cast<const uint32_t*>(boundSets + bind.setCount);
+			KONIDE_CHECK(bind.setCount == 2 && boundSets[0] == sets[0] && boundSets[1] == sets[1]);
+			KONIDE_CHECK(bind.dynamicOffsetCount == 1 && offsets[0] == dynamicOffset);
+		}
+	});
+
+	KONIDE_CHECK(types == std::vector<uint32_t>(expected, expected + sizeof(expected) / sizeof(expected[0])));
+	KONIDE_CHECK(bAligned);
+	KONIDE_CHECK(list.GetCommandCount() == 6);
+	KONIDE_CHECK(list.GetDrawCount() == 1);
+}
+
+// Sorted draws translate in key order with equal keys in encoding order, commands before the first draw
+// stay in front and binds the command buffer already has are dropped
+static void TestSortedTranslate(const KonideDeviceTable& table)
+{
+	FakeCalls.clear();
+
+	KonideFrameArena arena;
+	KonideRadixSorter sorter;
+	KonideCommandList list;
+	list.Begin(arena);
+
+	list.Dispatch(8);
+
+	const uint64_t keys[] = { 3, 1, 2, 1 };
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		list.BeginDraw(keys[i]);
+		list.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)(keys[i] * 10));
+		list.Draw(100 + i);
+	}
+
+	list.SortDraws(sorter);
+	KONIDE_CHECK(list.IsSorted());
+	KONIDE_CHECK(list.Translate(FakeCommandBuffer(), table) == list.GetCommandCount());
+
+	const char* expected[] = {
+		"vkCmdDispatch 8",
+		"vkCmdBindPipeline 10", "vkCmdDraw 101",
+		"vkCmdDraw 103",
+		"vkCmdBindPipeline 20", "vkCmdDraw 102",
+		"vkCmdBindPipeline 30", "vkCmdDraw 100"
+	};
+	KONIDE_CHECK(FakeCalls.size() == sizeof(expected) / sizeof(expected[0]));
+	for (size_t i = 0; i < FakeCalls.size() && i < sizeof(expected) / sizeof(expected[0]); i++)
+	{
+		KONIDE_CHECK(FakeCalls[i] == expected[i]);
+	}
+
+	// Drawing more unsorts the list
+	list.BeginDraw(0);
+	KONIDE_CHECK(!list.IsSorted());
+}
+
+// Enough draws to span several arena blocks, then a second frame that fits in the memory kept from the first
+static void TestArenaReuse(const KonideDeviceTable& table)
+{
+	const uint32_t drawCount = 5000;
+	uint32_t constants[16] = {};
+
+	KonideFrameArena arena;
+	KonideRadixSorter sorter;
+	KonideCommandList list;
+
+	uint64_t blockAllocations = 0;
+	for (uint32_t frame = 0; frame < 2; frame++)
+	{
+		list.Begin(arena);
+		for (uint32_t i = 0; i < drawCount; i++)
+		{
+			uint32_t key = (i * 7919) % drawCount;
+			constants[0] = key;
+			list.BeginDraw(key);
+			list.PushConstants((VkPipelineLayout)(uintptr_t)1, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), constants);
+			list.Draw(key);
+		}
+		list.SortDraws(sorter);
+
+		FakeCalls.clear();
+		list.Translate(FakeCommandBuffer(), table);
+
+		bool bInOrder = FakeCallCount("vkCmdDraw") == drawCount;
+		uint32_t nextDraw = 0;
+		for (const std::string& call : FakeCalls)
+		{
+			if (call.compare(0, 10, "vkCmdDraw ") == 0)
+			{
+				bInOrder &= call == "vkCmdDraw " + std::to_string(nextDraw++);
+			}
+		}
+		KONIDE_CHECK(bInOrder);
+
+		if (frame == 0)
+		{
+			blockAllocations = arena.GetStats().blockAllocations;
+			KONIDE_CHECK(blockAllocations > 1);
+
+			arena.Reset();
+			KONIDE_CHECK(!list.IsCurrent());
+		}
+		else
+		{
+			KONIDE_CHECK(arena.GetStats().blockAllocations == blockAllocations);
+		}
+	}
+}
+
+int main()
+{
+	KonideDeviceTable table{};
+	InitializeFakeDeviceTable(table);
+
+	TestEncoding();
+	TestSortedTranslate(table);
+	TestArenaReuse(table);
+
+	return TestResult("commandlist");
+}
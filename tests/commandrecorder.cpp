@@ -0,0 +1,157 @@
+#include <konide/commandrecorder.h>
+
+#include "konidetest.h"
+
+static VkViewport MakeViewport(float width)
+{
+	VkViewport viewport{};
+	viewport.width = width;
+	viewport.height = width;
+	viewport.maxDepth = 1.0f;
+	return viewport;
+}
+
+static VkRect2D MakeScissor(uint32_t width)
+{
+	VkRect2D scissor{};
+	scissor.extent = { width, width };
+	return scissor;
+}
+
+// Repeating a bind or state the command buffer already has reaches the driver once
+static void TestRedundantCalls(const KonideDeviceTable& table)
+{
+	FakeCalls.clear();
+
+	KonideCommandRecorder recorder;
+	recorder.Begin(FakeCommandBuffer(), table);
+
+	VkPipeline pipeline = (VkPipeline)(uintptr_t)7;
+	VkPipelineLayout layout = (VkPipelineLayout)(uintptr_t)8;
+	VkDescriptorSet set = (VkDescriptorSet)(uintptr_t)9;
+	VkBuffer buffer = (VkBuffer)(uintptr_t)10;
+	VkDeviceSize offset = 0;
+	VkViewport viewport = MakeViewport(640.0f);
+	VkRect2D scissor = MakeScissor(640);
+	uint32_t constants[4] = { 1, 2, 3, 4 };
+
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		recorder.BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &set);
+		recorder.BindVertexBuffers(0, 1, &buffer, &offset);
+		recorder.BindIndexBuffer(buffer, 0, VK_INDEX_TYPE_UINT32);
+		recorder.PushConstants(layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants), constants);
+		recorder.SetViewport(0, 1, &viewport);
+		recorder.SetScissor(0, 1, &scissor);
+		recorder.DrawIndexed(3, 1, 0, 0, 0);
+	}
+
+	KONIDE_CHECK(FakeCallCount("vkCmdBindPipeline") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdBindDescriptorSets") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdBindVertexBuffers") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdBindIndexBuffer") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdPushConstants") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetViewport") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetScissor") == 1);
+	// Draws are never dropped
+	KONIDE_CHECK(FakeCallCount("vkCmdDrawIndexed") == 3);
+
+	const KonideCommandRecorderStats& stats = recorder.GetStats();
+	KONIDE_CHECK(stats.issuedCalls == 7);
+	KONIDE_CHECK(stats.elidedCalls == 14);
+	KONIDE_CHECK(stats.elidedPipelineBinds == 2);
+	KONIDE_CHECK(stats.elidedDescriptorBinds == 2);
+	KONIDE_CHECK(stats.elidedBufferBinds == 4);
+	KONIDE_CHECK(stats.elidedPushConstants == 2);
+	KONIDE_CHECK(stats.elidedDynamicState == 4);
+
+	// A different value goes through
+	VkViewport otherViewport = MakeViewport(320.0f);
+	recorder.SetViewport(0, 1, &otherViewport);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetViewport") == 2);
+
+	// Invalidate forgets everything
+	recorder.Invalidate();
+	recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	recorder.SetViewport(0, 1, &otherViewport);
+	KONIDE_CHECK(FakeCallCount("vkCmdBindPipeline") == 2);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetViewport") == 3);
+}
+
+// Binding a pipeline resets the state it doesn't declare dynamic
+static void TestPipelineResetsState(const KonideDeviceTable& table)
+{
+	FakeCalls.clear();
+
+	KonideCommandRecorder recorder;
+	recorder.Begin(FakeCommandBuffer(), table);
+
+	VkViewport viewport = MakeViewport(640.0f);
+	recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)1, KONIDE_RECORDER_DYNAMIC_ALL);
+	recorder.SetViewport(0, 1, &viewport);
+	recorder.SetLineWidth(2.0f);
+
+	// Line width isn't dynamic in the second pipeline, the viewport is
+	recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)2);
+	recorder.SetViewport(0, 1, &viewport);
+	recorder.SetLineWidth(2.0f);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetViewport") == 1);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetLineWidth") == 2);
+
+	// Neither is in the third
+	recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)3, 0);
+	recorder.SetViewport(0, 1, &viewport);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetViewport") == 2);
+
+	// Compute binds leave graphics state alone
+	recorder.BindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, (VkPipeline)(uintptr_t)4, 0);
+	recorder.SetViewport(0, 1, &viewport);
+	recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, (VkPipeline)(uintptr_t)3);
+	KONIDE_CHECK(FakeCallCount("vkCmdSetViewport") == 2);
+	KONIDE_CHECK(FakeCallCount("vkCmdBindPipeline") == 4);
+}
+
+// Without elision every call reaches the driver, in the order it was made
+static void TestElisionOff(const KonideDeviceTable& table)
+{
+	FakeCalls.clear();
+
+	KonideCommandRecorder recorder;
+	recorder.Begin(FakeCommandBuffer(), table);
+	recorder.SetElision(false);
+
+	VkPipeline pipeline = (VkPipeline)(uintptr_t)7;
+	VkRect2D scissor = MakeScissor(64);
+	for (uint32_t i = 0; i < 2; i++)
+	{
+		recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		recorder.SetScissor(0, 1, &scissor);
+		recorder.SetStencilReference(VK_STENCIL_FACE_FRONT_BIT | VK_STENCIL_FACE_BACK_BIT, 5);
+		recorder.Draw(3, 1, 0, 0);
+	}
+
+	const char* expected[] = {
+		"vkCmdBindPipeline 7", "vkCmdSetScissor 64", "vkCmdSetStencilReference 5", "vkCmdDraw 3",
+		"vkCmdBindPipeline 7", "vkCmdSetScissor 64", "vkCmdSetStencilReference 5", "vkCmdDraw 3"
+	};
+	KONIDE_CHECK(FakeCalls.size() == sizeof(expected) / sizeof(expected[0]));
+	for (size_t i = 0; i < FakeCalls.size() && i < sizeof(expected) / sizeof(expected[0]); i++)
+	{
+		KONIDE_CHECK(FakeCalls[i] == expected[i]);
+	}
+	KONIDE_CHECK(recorder.GetStats().elidedCalls == 0);
+	KONIDE_CHECK(recorder.GetStats().issuedCalls == 6);
+}
+
+int main()
+{
+	KonideDeviceTable table{};
+	InitializeFakeDeviceTable(table);
+
+	TestRedundantCalls(table);
+	TestPipelineResetsState(table);
+	TestElisionOff(table);
+
+	return TestResult("commandrecorder");
+}
@@ -0,0 +1,84 @@
+#include <konide/drawsort.h>
+
+#include "konidetest.h"
+
+#include <algorithm>
+#include <vector>
+
+static uint32_t Seed = 12345;
+
+static uint32_t NextRandom()
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	return Seed >> 8;
+}
+
+// The radix sorter must agree with std::stable_sort on keys and on the order of equal keys
+static void TestMatchesStableSort()
+{
+	KonideRadixSorter sorter;
+
+	const uint32_t counts[] = { 0, 1, 2, 255, 256, 257, 5000 };
+	for (uint32_t count : counts)
+	{
+		std::vector<KonideDrawSortItem> items(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			// Few distinct values spread over several bytes, so most keys tie with others
+			items[i].key = (uint64_t)(NextRandom() % 4) << 60 | (uint64_t)(NextRandom() % 4) << 20 | (NextRandom() % 2);
+			items[i].index = i;
+		}
+
+		std::vector<KonideDrawSortItem> expected = items;
+		std::stable_sort(expected.begin(), expected.end(), [](const KonideDrawSortItem& a, const KonideDrawSortItem& b) { return a.key < b.key; });
+
+		sorter.Sort(items);
+
+		bool bMatches = true;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			bMatches &= items[i].key == expected[i].key && items[i].index == expected[i].index;
+		}
+		KONIDE_CHECK(bMatches);
+	}
+
+	// Keys sharing every byte need no pass at all
+	sorter.ResetStats();
+	std::vector<KonideDrawSortItem> same(100, KonideDrawSortItem{ 42, 0 });
+	sorter.Sort(same);
+	KONIDE_CHECK(sorter.GetStats().passes == 0);
+	KONIDE_CHECK(sorter.GetStats().skippedPasses == 8);
+}
+
+// Layers and passes come first, opaque draws group by state and go near first, transparent ones go far first
+static void TestKeyLayout()
+{
+	uint64_t opaque = KonideMakeDrawKey(0, KONIDE_DRAW_PASS_OPAQUE, 63, 1000, 200, 1.0f);
+	uint64_t transparent = KonideMakeTransparentDrawKey(0, KONIDE_DRAW_PASS_TRANSPARENT, 0.0f, 0, 0);
+	uint64_t nextLayer = KonideMakeDrawKey(1, KONIDE_DRAW_PASS_OPAQUE, 0, 0, 0, 0.0f);
+	KONIDE_CHECK(opaque < transparent);
+	KONIDE_CHECK(transparent < nextLayer);
+
+	uint64_t nearOpaque = KonideMakeDrawKey(0, KONIDE_DRAW_PASS_OPAQUE, 5, 7, 9, 0.1f);
+	uint64_t farOpaque = KonideMakeDrawKey(0, KONIDE_DRAW_PASS_OPAQUE, 5, 7, 9, 0.9f);
+	uint64_t otherPipeline = KonideMakeDrawKey(0, KONIDE_DRAW_PASS_OPAQUE, 6, 0, 0, 0.0f);
+	KONIDE_CHECK(nearOpaque < farOpaque);
+	KONIDE_CHECK(farOpaque < otherPipeline);
+
+	uint64_t nearTransparent = KonideMakeTransparentDrawKey(0, KONIDE_DRAW_PASS_TRANSPARENT, 0.1f, 0, 0);
+	uint64_t farTransparent = KonideMakeTransparentDrawKey(0, KONIDE_DRAW_PASS_TRANSPARENT, 0.9f, 63, 1000);
+	KONIDE_CHECK(farTransparent < nearTransparent);
+
+	// Depth is clamped, ids wider than their field are truncated
+	KONIDE_CHECK(KonideMakeDrawKey(0, 0, 0, 0, 0, -1.0f) == KonideMakeDrawKey(0, 0, 0, 0, 0, 0.0f));
+	KONIDE_CHECK(KonideMakeDrawKey(0, 0, 0, 0, 0, 2.0f) == KonideMakeDrawKey(0, 0, 0, 0, 0, 1.0f));
+	KONIDE_CHECK(KonideMakeDrawKey(0, 0, 1 << KONIDE_DRAW_KEY_PIPELINE_BITS, 0, 0, 0.0f) == KonideMakeDrawKey(0, 0, 0, 0, 0, 0.0f));
+}
+
+int main()
+{
+	TestMatchesStableSort();
+	TestKeyLayout();
+
+	return TestResult("drawsort");
+}
@@ -0,0 +1,147 @@
+#include <konide/framegraph.h>
+
+#include "konidetest.h"
+
+#include <vector>
+
+#define TEST_IMAGE_SIZE 256
+
+static KonideFrameGraphImageDesc MakeImageDesc()
+{
+	KonideFrameGraphImageDesc desc;
+	desc.format = VK_FORMAT_R8G8B8A8_UNORM;
+	desc.extent = { TEST_IMAGE_SIZE, TEST_IMAGE_SIZE };
+	desc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	return desc;
+}
+
+struct TestGraph {
+	KonideFrameGraphResource depth;
+	KonideFrameGraphResource debug;
+	KonideFrameGraphResource hdr;
+	KonideFrameGraphResource bloom;
+	KonideFrameGraphResource staging;
+	KonideFrameGraphResource backbuffer;
+};
+
+// depth -> lighting -> bloom -> tonemap into the imported backbuffer, an upload with side effects and a
+// debug pass whose output nobody reads. Lifetimes: depth 0-2, hdr 2-3, bloom 3-4, staging 5.
+static TestGraph BuildGraph(KonideFrameGraph& graph, std::vector<uint32_t>& executed)
+{
+	TestGraph resources;
+
+	VkImageSubresourceRange range{};
+	range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	range.levelCount = 1;
+	range.layerCount = 1;
+	resources.backbuffer = graph.ImportImage("backbuffer", (VkImage)(uintptr_t)0x100000, (VkImageView)(uintptr_t)0x100001, range,
+		VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+	graph.AddPass("depth", [&](KonideFrameGraphPassBuilder& builder)
+	{
+		resources.depth = builder.CreateImage("depth", MakeImageDesc());
+		builder.ColorAttachment(resources.depth);
+	}, [&executed](VkCommandBuffer) { executed.push_back(0); });
+
+	graph.AddPass("debug", [&](KonideFrameGraphPassBuilder& builder)
+	{
+		resources.debug = builder.CreateImage("debug", MakeImageDesc());
+		builder.ColorAttachment(resources.debug);
+	}, [&executed](VkCommandBuffer) { executed.push_back(1); });
+
+	graph.AddPass("lighting", [&](KonideFrameGraphPassBuilder& builder)
+	{
+		builder.SampledImage(resources.depth);
+		resources.hdr = builder.CreateImage("hdr", MakeImageDesc());
+		builder.ColorAttachment(resources.hdr);
+	}, [&executed](VkCommandBuffer) { executed.push_back(2); });
+
+	graph.AddPass("bloom", [&](KonideFrameGraphPassBuilder& builder)
+	{
+		builder.SampledImage(resources.hdr);
+		resources.bloom = builder.CreateImage("bloom", MakeImageDesc());
+		builder.ColorAttachment(resources.bloom);
+	}, [&executed](VkCommandBuffer) { executed.push_back(3); });
+
+	graph.AddPass("tonemap", [&](KonideFrameGraphPassBuilder& builder)
+	{
+		builder.SampledImage(resources.bloom);
+		builder.ColorAttachment(resources.backbuffer);
+	}, [&executed](VkCommandBuffer) { executed.push_back(4); });
+
+	graph.AddPass("upload", [&](KonideFrameGraphPassBuilder& builder)
+	{
+		KonideFrameGraphBufferDesc desc;
+		desc.size = 1024;
+		desc.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		resources.staging = builder.CreateBuffer("staging", desc);
+		builder.Write(resources.staging, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+		builder.SetSideEffects();
+	}, [&executed](VkCommandBuffer) { executed.push_back(5); });
+
+	return resources;
+}
+
+int main()
+{
+	KonideDeviceTable table{};
+	InitializeFakeDeviceTable(table);
+
+	VkPhysicalDeviceMemoryProperties memoryProperties{};
+	memoryProperties.memoryTypeCount = 1;
+	memoryProperties.memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	memoryProperties.memoryHeapCount = 1;
+
+	KonideFrameGraph graph;
+	graph.Initialize((VkDevice)(uintptr_t)1, table, memoryProperties, [](std::function<void()> destroy) { destroy(); });
+
+	uint64_t handlesAfterFirstFrame = 0;
+	for (uint32_t frame = 0; frame < 2; frame++)
+	{
+		std::vector<uint32_t> executed;
+		graph.Reset();
+		TestGraph resources = BuildGraph(graph, executed);
+		graph.Compile();
+		graph.Execute(FakeCommandBuffer());
+
+		// Only the debug pass is culled, its image never gets memory
+		const KonideFrameGraphStats& stats = graph.GetStats();
+		KONIDE_CHECK(stats.passes == 6);
+		KONIDE_CHECK(stats.culledPasses == 1);
+		KONIDE_CHECK(executed == std::vector<uint32_t>({ 0, 2, 3, 4, 5 }));
+		KONIDE_CHECK(graph.GetResource(resources.debug).firstPass == UINT32_MAX);
+		KONIDE_CHECK(graph.GetResource(resources.debug).memoryBlock == -1);
+		KONIDE_CHECK(graph.GetImage(resources.debug) == VK_NULL_HANDLE);
+
+		// depth and bloom never live at the same time and share memory, hdr overlaps both
+		int32_t depthBlock = graph.GetResource(resources.depth).memoryBlock;
+		int32_t hdrBlock = graph.GetResource(resources.hdr).memoryBlock;
+		int32_t bloomBlock = graph.GetResource(resources.bloom).memoryBlock;
+		KONIDE_CHECK(depthBlock >= 0 && hdrBlock >= 0);
+		KONIDE_CHECK(depthBlock == bloomBlock);
+		KONIDE_CHECK(depthBlock != hdrBlock);
+		KONIDE_CHECK(graph.GetResource(resources.staging).memoryBlock >= 0);
+
+		VkDeviceSize imageSize = TEST_IMAGE_SIZE * TEST_IMAGE_SIZE * 4;
+		KONIDE_CHECK(stats.transientMemory == 2 * imageSize);
+		KONIDE_CHECK(stats.unaliasedMemory == 3 * imageSize + 1024);
+		KONIDE_CHECK(FakeCallCount("vkCmdPipelineBarrier2") == (frame + 1) * stats.barrierBatches);
+
+		// The same graph next frame keeps its transient objects
+		if (frame == 0)
+		{
+			handlesAfterFirstFrame = FakeNextHandle;
+		}
+		else
+		{
+			KONIDE_CHECK(FakeNextHandle == handlesAfterFirstFrame);
+		}
+	}
+
+	// Everything the graph created is gone after Shutdown
+	KONIDE_CHECK(FakeLiveObjects > 0);
+	graph.Shutdown();
+	KONIDE_CHECK(FakeLiveObjects == 0);
+
+	return TestResult("framegraph");
+}
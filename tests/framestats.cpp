@@ -0,0 +1,103 @@
+#include <konide/framestats.h>
+
+#include "konidetest.h"
+
+#include <cmath>
+#include <vector>
+
+// Times are kept in whole nanoseconds
+static bool NearlyEqual(double a, double b)
+{
+	return std::fabs(a - b) < 1e-6;
+}
+
+static KonideFrameTiming MakeTiming(uint64_t frame, double total)
+{
+	KonideFrameTiming timing;
+	timing.frame = frame;
+	timing.phases[KONIDE_FRAME_PHASE_TOTAL] = total;
+	timing.phases[KONIDE_FRAME_PHASE_RECORD] = total * 0.5;
+	return timing;
+}
+
+// 100 frames of 0.5 to 99.5 ms recorded out of order, percentiles use the nearest rank
+static void TestPercentiles()
+{
+	KonideFrameStats stats;
+	KONIDE_CHECK(stats.GetSampleCount() == 0);
+	KONIDE_CHECK(stats.GetPercentile(KONIDE_FRAME_PHASE_TOTAL, 50.0) == 0.0);
+
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		uint32_t ms = (i * 37) % 100;
+		stats.Record(MakeTiming(i, (ms + 0.5) * 0.001));
+	}
+	KONIDE_CHECK(stats.GetSampleCount() == 100);
+
+	const double percentiles[] = { 0.0, 50.0, 95.0, 99.0, 100.0 };
+	const double expected[] = { 0.0005, 0.0495, 0.0945, 0.0985, 0.0995 };
+	double results[5];
+	stats.GetPercentiles(KONIDE_FRAME_PHASE_TOTAL, percentiles, results, 5);
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		KONIDE_CHECK(NearlyEqual(results[i], expected[i]));
+	}
+
+	KONIDE_CHECK(NearlyEqual(stats.GetPercentile(KONIDE_FRAME_PHASE_TOTAL, 50.0), 0.0495));
+	KONIDE_CHECK(NearlyEqual(stats.GetPercentile(KONIDE_FRAME_PHASE_RECORD, 50.0), 0.02475));
+	KONIDE_CHECK(stats.GetPercentile(KONIDE_FRAME_PHASE_PRESENT, 99.0) == 0.0);
+
+	KonideFrameHistogram histogram = stats.GetHistogram(KONIDE_FRAME_PHASE_TOTAL, 0.010, 5);
+	KONIDE_CHECK(histogram.sampleCount == 100);
+	KONIDE_CHECK(histogram.buckets.size() == 5);
+	for (uint64_t bucket : histogram.buckets)
+	{
+		KONIDE_CHECK(bucket == 10);
+	}
+	KONIDE_CHECK(histogram.overflow == 50);
+	KONIDE_CHECK(histogram.ToCSV().compare(0, 24, "lower_ms,upper_ms,count\n") == 0);
+
+	// Reset drops everything recorded so far, later samples count again
+	stats.Reset();
+	KONIDE_CHECK(stats.GetSampleCount() == 0);
+	KONIDE_CHECK(stats.GetPercentile(KONIDE_FRAME_PHASE_TOTAL, 100.0) == 0.0);
+	KONIDE_CHECK(stats.GetHistogram(KONIDE_FRAME_PHASE_TOTAL, 0.010, 5).sampleCount == 0);
+
+	stats.Record(MakeTiming(100, 0.004));
+	KONIDE_CHECK(stats.GetSampleCount() == 1);
+	KONIDE_CHECK(NearlyEqual(stats.GetPercentile(KONIDE_FRAME_PHASE_TOTAL, 50.0), 0.004));
+}
+
+// Past capacity the ring keeps the newest frames, oldest first
+static void TestRingWrap()
+{
+	KonideFrameStats stats;
+
+	const uint64_t frameCount = KONIDE_FRAME_STATS_CAPACITY * 2 + 100;
+	for (uint64_t frame = 0; frame < frameCount; frame++)
+	{
+		// Old frames are slow, only the retained ones are fast
+		double total = frame < frameCount - KONIDE_FRAME_STATS_CAPACITY ? 1.0 : 0.001;
+		stats.Record(MakeTiming(frame, total));
+	}
+	KONIDE_CHECK(stats.GetSampleCount() == KONIDE_FRAME_STATS_CAPACITY);
+
+	std::vector<KonideFrameTiming> timings;
+	stats.Snapshot(timings);
+	KONIDE_CHECK(timings.size() == KONIDE_FRAME_STATS_CAPACITY);
+	if (!timings.empty())
+	{
+		KONIDE_CHECK(timings.front().frame == frameCount - KONIDE_FRAME_STATS_CAPACITY);
+		KONIDE_CHECK(timings.back().frame == frameCount - 1);
+	}
+
+	KONIDE_CHECK(NearlyEqual(stats.GetPercentile(KONIDE_FRAME_PHASE_TOTAL, 100.0), 0.001));
+}
+
+int main()
+{
+	TestPercentiles();
+	TestRingWrap();
+
+	return TestResult("framestats");
+}
@@ -0,0 +1,134 @@
+#include <konide/jobsystem.h>
+
+#include "konidetest.h"
+
+#include <atomic>
+#include <vector>
+
+// Start(0) picks a worker count from the hardware, no Start at all leaves every job to waiting threads
+static void StartWorkers(KonideJobSystem& jobSystem, uint32_t workerCount)
+{
+	if (workerCount > 0)
+	{
+		jobSystem.Start(workerCount);
+	}
+}
+
+// Every index is visited exactly once, with and without workers
+static void TestParallelFor(uint32_t workerCount)
+{
+	KonideJobSystem jobSystem;
+	StartWorkers(jobSystem, workerCount);
+
+	const uint32_t count = 10007;
+	std::vector<std::atomic<uint32_t>> visits(count);
+	for (std::atomic<uint32_t>& visit : visits)
+	{
+		visit = 0;
+	}
+
+	jobSystem.ParallelFor(count, 64, [&visits](uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			visits[i]++;
+		}
+	});
+
+	bool bAllOnce = true;
+	for (std::atomic<uint32_t>& visit : visits)
+	{
+		bAllOnce &= visit.load() == 1;
+	}
+	KONIDE_CHECK(bAllOnce);
+
+	// Empty ranges don't call the function
+	uint32_t calls = 0;
+	jobSystem.ParallelFor(0, 64, [&calls](uint32_t, uint32_t) { calls++; });
+	KONIDE_CHECK(calls == 0);
+
+	jobSystem.Stop();
+}
+
+// Jobs depending on a counter start only once every job of that counter finished
+static void TestDependencies(uint32_t workerCount)
+{
+	KonideJobSystem jobSystem;
+	StartWorkers(jobSystem, workerCount);
+
+	const uint32_t stages = 16;
+	const uint32_t jobsPerStage = 8;
+	std::vector<KonideJobCounter> counters(stages);
+	std::atomic<uint32_t> finished[stages];
+	std::atomic<uint32_t> outOfOrder{ 0 };
+
+	for (uint32_t stage = 0; stage < stages; stage++)
+	{
+		finished[stage] = 0;
+		for (uint32_t job = 0; job < jobsPerStage; job++)
+		{
+			jobSystem.Schedule([&, stage]()
+			{
+				if (stage > 0 && finished[stage - 1].load() != jobsPerStage)
+				{
+					outOfOrder++;
+				}
+				finished[stage]++;
+			}, &counters[stage], stage > 0 ? &counters[stage - 1] : nullptr);
+		}
+	}
+
+	jobSystem.Wait(counters[stages - 1]);
+	KONIDE_CHECK(outOfOrder.load() == 0);
+	KONIDE_CHECK(finished[stages - 1].load() == jobsPerStage);
+
+	for (KonideJobCounter& counter : counters)
+	{
+		jobSystem.Wait(counter);
+		KONIDE_CHECK(counter.IsDone());
+	}
+
+	jobSystem.Stop();
+}
+
+// Jobs scheduling more jobs, the waiting thread runs jobs itself when there are no workers
+static void TestNestedJobs(uint32_t workerCount)
+{
+	KonideJobSystem jobSystem;
+	StartWorkers(jobSystem, workerCount);
+
+	KonideJobCounter outer;
+	KonideJobCounter inner;
+	std::atomic<uint32_t> innerJobs{ 0 };
+
+	for (uint32_t i = 0; i < 32; i++)
+	{
+		jobSystem.Schedule([&]()
+		{
+			for (uint32_t j = 0; j < 32; j++)
+			{
+				jobSystem.Schedule([&innerJobs]() { innerJobs++; }, &inner);
+			}
+		}, &outer);
+	}
+
+	jobSystem.Wait(outer);
+	jobSystem.Wait(inner);
+	KONIDE_CHECK(innerJobs.load() == 32 * 32);
+	KONIDE_CHECK(jobSystem.GetStats().jobsExecuted == 32 + 32 * 32);
+
+	jobSystem.Stop();
+}
+
+int main()
+{
+	const uint32_t workerCounts[] = { 0, 1, 4 };
+	for (uint32_t workerCount : workerCounts)
+	{
+		TestParallelFor(workerCount);
+		TestDependencies(workerCount);
+		TestNestedJobs(workerCount);
+	}
+
+	return TestResult("jobsystem");
+}
@@ -0,0 +1,192 @@
+#ifndef _KONIDE_TEST_H
+#define _KONIDE_TEST_H
+
+#ifndef VK_NO_PROTOTYPES
+#	define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+#include <konide/vulkan/vkloader_tables.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// Every test binary is one main() running checks, a failed check is printed and fails the binary
+
+static int TestFailures = 0;
+
+#define KONIDE_CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			TestFailures++; \
+		} \
+	} while (0)
+
+inline int TestResult(const char* name)
+{
+	if (TestFailures)
+	{
+		printf("%s: %d checks failed\n", name, TestFailures);
+		return 1;
+	}
+
+	printf("%s: passed\n", name);
+	return 0;
+}
+
+// Fake device: commands are logged by name with their first meaningful argument, objects are plain counters
+// and memory requirements are the size the object asked for, 256 byte aligned, in the only memory type
+
+static std::vector<std::string> FakeCalls;
+static uint64_t FakeNextHandle = 0;
+static std::map<uint64_t, VkDeviceSize> FakeObjectSizes;
+static uint32_t FakeLiveObjects = 0;
+
+template<typename T>
+inline uint64_t FakeHandleKey(T handle)
+{
+	return (uint64_t)(uintptr_t)handle;
+}
+
+template<typename T>
+inline T FakeCreateHandle(VkDeviceSize size = 0)
+{
+	T handle = (T)(uintptr_t)++FakeNextHandle;
+	FakeObjectSizes[FakeHandleKey(handle)] = size;
+	FakeLiveObjects++;
+	return handle;
+}
+
+template<typename T>
+inline void FakeDestroyHandle(T handle)
+{
+	if (FakeObjectSizes.erase(FakeHandleKey(handle)))
+	{
+		FakeLiveObjects--;
+	}
+}
+
+inline void FakeLog(const char* name, uint64_t value)
+{
+	char line[96];
+	snprintf(line, sizeof(line), "%s %llu", name, (unsigned long long)value);
+	FakeCalls.push_back(line);
+}
+
+inline uint32_t FakeCallCount(const std::string& name)
+{
+	uint32_t count = 0;
+	for (const std::string& call : FakeCalls)
+	{
+		count += call.compare(0, name.size() + 1, name + " ") == 0 ? 1 : 0;
+	}
+	return count;
+}
+
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdBindPipeline(VkCommandBuffer, VkPipelineBindPoint, VkPipeline pipeline) { FakeLog("vkCmdBindPipeline", FakeHandleKey(pipeline)); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdBindDescriptorSets(VkCommandBuffer, VkPipelineBindPoint, VkPipelineLayout, uint32_t firstSet, uint32_t, const VkDescriptorSet*, uint32_t, const uint32_t*) { FakeLog("vkCmdBindDescriptorSets", firstSet); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdBindVertexBuffers(VkCommandBuffer, uint32_t firstBinding, uint32_t, const VkBuffer*, const VkDeviceSize*) { FakeLog("vkCmdBindVertexBuffers", firstBinding); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdBindIndexBuffer(VkCommandBuffer, VkBuffer buffer, VkDeviceSize, VkIndexType) { FakeLog("vkCmdBindIndexBuffer", FakeHandleKey(buffer)); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdPushConstants(VkCommandBuffer, VkPipelineLayout, VkShaderStageFlags, uint32_t offset, uint32_t, const void*) { FakeLog("vkCmdPushConstants", offset); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdSetViewport(VkCommandBuffer, uint32_t, uint32_t, const VkViewport* viewports) { FakeLog("vkCmdSetViewport", (uint64_t)viewports[0].width); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdSetScissor(VkCommandBuffer, uint32_t, uint32_t, const VkRect2D* scissors) { FakeLog("vkCmdSetScissor", scissors[0].extent.width); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdSetLineWidth(VkCommandBuffer, float lineWidth) { FakeLog("vkCmdSetLineWidth", (uint64_t)lineWidth); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdSetDepthBias(VkCommandBuffer, float constantFactor, float, float) { FakeLog("vkCmdSetDepthBias", (uint64_t)constantFactor); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdSetBlendConstants(VkCommandBuffer, const float* constants) { FakeLog("vkCmdSetBlendConstants", (uint64_t)constants[0]); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdSetStencilReference(VkCommandBuffer, VkStencilFaceFlags, uint32_t reference) { FakeLog("vkCmdSetStencilReference", reference); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdDraw(VkCommandBuffer, uint32_t vertexCount, uint32_t, uint32_t, uint32_t) { FakeLog("vkCmdDraw", vertexCount); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdDrawIndexed(VkCommandBuffer, uint32_t indexCount, uint32_t, uint32_t, int32_t, uint32_t) { FakeLog("vkCmdDrawIndexed", indexCount); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdDispatch(VkCommandBuffer, uint32_t groupCountX, uint32_t, uint32_t) { FakeLog("vkCmdDispatch", groupCountX); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdCopyBuffer(VkCommandBuffer, VkBuffer, VkBuffer, uint32_t, const VkBufferCopy* regions) { FakeLog("vkCmdCopyBuffer", regions[0].size); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdCopyBufferToImage(VkCommandBuffer, VkBuffer, VkImage, VkImageLayout, uint32_t, const VkBufferImageCopy* regions) { FakeLog("vkCmdCopyBufferToImage", regions[0].imageExtent.width); }
+inline VKAPI_ATTR void VKAPI_CALL FakeCmdPipelineBarrier2(VkCommandBuffer, const VkDependencyInfo* info) { FakeLog("vkCmdPipelineBarrier2", info->imageMemoryBarrierCount + info->bufferMemoryBarrierCount); }
+
+inline VKAPI_ATTR VkResult VKAPI_CALL FakeCreateImage(VkDevice, const VkImageCreateInfo* info, const VkAllocationCallbacks*, VkImage* image)
+{
+	*image = FakeCreateHandle<VkImage>((VkDeviceSize)info->extent.width * info->extent.height * 4);
+	return VK_SUCCESS;
+}
+
+inline VKAPI_ATTR VkResult VKAPI_CALL FakeCreateBuffer(VkDevice, const VkBufferCreateInfo* info, const VkAllocationCallbacks*, VkBuffer* buffer)
+{
+	*buffer = FakeCreateHandle<VkBuffer>(info->size);
+	return VK_SUCCESS;
+}
+
+inline void FakeMemoryRequirements(uint64_t key, VkMemoryRequirements* requirements)
+{
+	requirements->size = (FakeObjectSizes[key] + 255) & ~(VkDeviceSize)255;
+	requirements->alignment = 256;
+	requirements->memoryTypeBits = 1;
+}
+
+inline VKAPI_ATTR void VKAPI_CALL FakeGetImageMemoryRequirements(VkDevice, VkImage image, VkMemoryRequirements* requirements) { FakeMemoryRequirements(FakeHandleKey(image), requirements); }
+inline VKAPI_ATTR void VKAPI_CALL FakeGetBufferMemoryRequirements(VkDevice, VkBuffer buffer, VkMemoryRequirements* requirements) { FakeMemoryRequirements(FakeHandleKey(buffer), requirements); }
+
+inline VKAPI_ATTR VkResult VKAPI_CALL FakeAllocateMemory(VkDevice, const VkMemoryAllocateInfo* info, const VkAllocationCallbacks*, VkDeviceMemory* memory)
+{
+	*memory = FakeCreateHandle<VkDeviceMemory>(info->allocationSize);
+	return VK_SUCCESS;
+}
+
+inline VKAPI_ATTR VkResult VKAPI_CALL FakeBindImageMemory(VkDevice, VkImage, VkDeviceMemory, VkDeviceSize) { return VK_SUCCESS; }
+inline VKAPI_ATTR VkResult VKAPI_CALL FakeBindBufferMemory(VkDevice, VkBuffer, VkDeviceMemory, VkDeviceSize) { return VK_SUCCESS; }
+
+inline VKAPI_ATTR VkResult VKAPI_CALL FakeCreateImageView(VkDevice, const VkImageViewCreateInfo*, const VkAllocationCallbacks*, VkImageView* view)
+{
+	*view = FakeCreateHandle<VkImageView>();
+	return VK_SUCCESS;
+}
+
+inline VKAPI_ATTR void VKAPI_CALL FakeDestroyImageView(VkDevice, VkImageView view, const VkAllocationCallbacks*) { FakeDestroyHandle(view); }
+inline VKAPI_ATTR void VKAPI_CALL FakeDestroyImage(VkDevice, VkImage image, const VkAllocationCallbacks*) { FakeDestroyHandle(image); }
+inline VKAPI_ATTR void VKAPI_CALL FakeDestroyBuffer(VkDevice, VkBuffer buffer, const VkAllocationCallbacks*) { FakeDestroyHandle(buffer); }
+inline VKAPI_ATTR void VKAPI_CALL FakeFreeMemory(VkDevice, VkDeviceMemory memory, const VkAllocationCallbacks*) { FakeDestroyHandle(memory); }
+
+// Points the entries konide records and allocates through at the fakes, everything else stays null
+inline void InitializeFakeDeviceTable(KonideDeviceTable& table)
+{
+	table.vkCmdBindPipeline = FakeCmdBindPipeline;
+	table.vkCmdBindDescriptorSets = FakeCmdBindDescriptorSets;
+	table.vkCmdBindVertexBuffers = FakeCmdBindVertexBuffers;
+	table.vkCmdBindIndexBuffer = FakeCmdBindIndexBuffer;
+	table.vkCmdPushConstants = FakeCmdPushConstants;
+	table.vkCmdSetViewport = FakeCmdSetViewport;
+	table.vkCmdSetScissor = FakeCmdSetScissor;
+	table.vkCmdSetLineWidth = FakeCmdSetLineWidth;
+	table.vkCmdSetDepthBias = FakeCmdSetDepthBias;
+	table.vkCmdSetBlendConstants = FakeCmdSetBlendConstants;
+	table.vkCmdSetStencilReference = FakeCmdSetStencilReference;
+	table.vkCmdDraw = FakeCmdDraw;
+	table.vkCmdDrawIndexed = FakeCmdDrawIndexed;
+	table.vkCmdDispatch = FakeCmdDispatch;
+	table.vkCmdCopyBuffer = FakeCmdCopyBuffer;
+	table.vkCmdCopyBufferToImage = FakeCmdCopyBufferToImage;
+	table.vkCmdPipelineBarrier2 = FakeCmdPipelineBarrier2;
+
+	table.vkCreateImage = FakeCreateImage;
+	table.vkCreateBuffer = FakeCreateBuffer;
+	table.vkGetImageMemoryRequirements = FakeGetImageMemoryRequirements;
+	table.vkGetBufferMemoryRequirements = FakeGetBufferMemoryRequirements;
+	table.vkAllocateMemory = FakeAllocateMemory;
+	table.vkBindImageMemory = FakeBindImageMemory;
+	table.vkBindBufferMemory = FakeBindBufferMemory;
+	table.vkCreateImageView = FakeCreateImageView;
+	table.vkDestroyImageView = FakeDestroyImageView;
+	table.vkDestroyImage = FakeDestroyImage;
+	table.vkDestroyBuffer = FakeDestroyBuffer;
+	table.vkFreeMemory = FakeFreeMemory;
+}
+
+// Fake command buffer handle, nothing dereferences it
+inline VkCommandBuffer FakeCommandBuffer()
+{
+	return (VkCommandBuffer)(uintptr_t)0x1000;
+}
+
+#endif
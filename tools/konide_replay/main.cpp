@@ -0,0 +1,2484 @@
+#include <konide/renderer.h>
+#include <konide/trace.h>
+#include <konide/vulkan/vkcapture.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Replays a trace written by KonideRenderer::StartVulkanCapture on a headless device of its own. Resources and
+// synchronization are recreated from the captured create infos, command buffers are recorded again call by call.
+// Host writes to mapped memory are copied into the buffers bound to it before the next submit, writes to image
+// memory or to memory bound before the capture started have nowhere to go and are counted as missing.
+// Pipelines and shaders aren't part of a trace, binds use stand-in pipelines built from the shaders in
+// KONIDE_REPLAY_SHADER_DIR for the active attachment formats, and descriptor sets and dispatches are skipped.
+// Swapchain images become plain images and acquires and presents are dropped together with binary semaphores,
+// so a trace replays the same CPU and driver work every run without a window. It's only the same GPU work as
+// the capture when no memory writes went missing, no pipeline was stood in for and no recorded command was
+// skipped. Timings are reported only then, otherwise they'd be read as the capture's and mislead.
+
+#ifndef KONIDE_REPLAY_SHADER_DIR
+#	define KONIDE_REPLAY_SHADER_DIR ""
+#endif
+
+// Push constant bytes the stand-in pipeline layout takes, captured pushes past it are cut
+#define REPLAY_PUSH_CONSTANT_SIZE 128
+
+using Clock = std::chrono::steady_clock;
+
+static double SecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static int FindArgument(int argc, char** argv, const char* name)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], name) == 0)
+		{
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+template<typename T>
+static uint64_t HandleKey(T handle)
+{
+	if constexpr (std::is_pointer<T>::value)
+	{
+		return (uint64_t)(uintptr_t)handle;
+	}
+	else
+	{
+		return (uint64_t)handle;
+	}
+}
+
+// Arguments of a captured call are decoded in order, SkipArg steps over the ones a handler doesn't use
+struct SkipArg {};
+
+template<typename T>
+struct ArrayArg
+{
+	T*& items;
+	uint32_t* count;
+};
+
+template<typename T>
+struct IsArrayArg : std::false_type {};
+template<typename T>
+struct IsArrayArg<ArrayArg<T>> : std::true_type {};
+
+template<typename T>
+static ArrayArg<T> Array(T*& items, uint32_t* count = nullptr)
+{
+	return { items, count };
+}
+
+template<typename T>
+static bool DecodeArg(KonideCaptureDecoder& decoder, T& arg)
+{
+	if constexpr (std::is_same<T, SkipArg>::value)
+	{
+		return decoder.Skip();
+	}
+	else if constexpr (IsArrayArg<T>::value)
+	{
+		return decoder.DecodeArray(arg.items, arg.count);
+	}
+	else
+	{
+		return decoder.DecodeValue(arg);
+	}
+}
+
+template<typename... Args>
+static bool DecodeArgs(KonideCaptureDecoder& decoder, Args&&... args)
+{
+	return (DecodeArg(decoder, args) && ...);
+}
+
+struct ReplayBuffer
+{
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	VkDeviceSize size = 0;
+	// Captured memory the buffer was bound to and where, 0 until a bind is replayed
+	uint64_t boundMemory = 0;
+	VkDeviceSize boundOffset = 0;
+};
+
+// A captured memory write landing in a buffer, data points into the trace
+struct ReplayWrite
+{
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceSize offset = 0;
+	const uint8_t* data = nullptr;
+	VkDeviceSize size = 0;
+};
+
+// Setup work submitted ahead of a captured submit, freed once its fence signals
+struct ReplaySetup
+{
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	VkFence fence = VK_NULL_HANDLE;
+	VkBuffer staging = VK_NULL_HANDLE;
+	VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+};
+
+struct ReplayImage
+{
+	VkImage image = VK_NULL_HANDLE;
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+};
+
+struct ReplayImageView
+{
+	VkImageView view = VK_NULL_HANDLE;
+	VkFormat format = VK_FORMAT_UNDEFINED;
+	VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+};
+
+struct ReplaySwapchain
+{
+	VkSwapchainCreateInfoKHR info;
+	// Captured handles of the stand-in images
+	std::vector<uint64_t> images;
+};
+
+struct ReplayCommandBuffer
+{
+	VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+	uint64_t pool = 0;
+	// Stand-in pipeline key of the attachments being rendered to, see GetStandInPipeline
+	std::vector<uint32_t> renderingKey;
+	bool bRendering = false;
+	bool bPipelineBound = false;
+};
+
+struct ReplayEntrypointStats
+{
+	uint64_t calls = 0;
+	uint64_t skipped = 0;
+	double capturedSeconds = 0.0;
+	double replaySeconds = 0.0;
+};
+
+struct ReplayState;
+typedef bool (*ReplayHandler)(ReplayState& replay, KonideCaptureDecoder& decoder);
+
+// Everything recreated so far, keyed by the handles in the trace
+struct ReplayState
+{
+	KonideRenderer& renderer;
+	const KonideDeviceTable& vk;
+	VkDevice device;
+	VkQueue queue;
+	uint32_t queueFamily;
+	VkPhysicalDeviceMemoryProperties memoryProperties;
+
+	std::unordered_map<uint64_t, VkQueue> queues;
+	std::unordered_map<uint64_t, ReplayBuffer> buffers;
+	std::unordered_map<uint64_t, ReplayImage> images;
+	std::unordered_map<uint64_t, ReplayImageView> imageViews;
+	std::unordered_map<uint64_t, ReplaySwapchain> swapchains;
+	// Binary semaphores map to null, they only ever guard acquires and presents
+	std::unordered_map<uint64_t, VkSemaphore> semaphores;
+	std::unordered_map<uint64_t, VkFence> fences;
+	std::unordered_map<uint64_t, VkCommandPool> commandPools;
+	std::unordered_map<uint64_t, ReplayCommandBuffer> commandBuffers;
+
+	// Captured buffers bound to each captured allocation
+	std::unordered_map<uint64_t, std::vector<uint64_t>> memoryBuffers;
+
+	// New buffers are cleared and captured memory writes copied in before the next submit, contents the trace
+	// doesn't hold read as zero
+	std::vector<VkBuffer> pendingClears;
+	std::vector<ReplayWrite> pendingWrites;
+	std::vector<ReplaySetup> setups;
+	VkCommandPool setupPool = VK_NULL_HANDLE;
+
+	VkShaderModule vertexShader = VK_NULL_HANDLE;
+	VkShaderModule fragmentShader = VK_NULL_HANDLE;
+	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+	std::map<std::vector<uint32_t>, VkPipeline> pipelines;
+
+	std::vector<ReplayHandler> handlers;
+	// Per trace entrypoint, true for vkCmd* calls, skipping one of those leaves GPU work out
+	std::vector<bool> commandEntrypoints;
+	std::vector<ReplayEntrypointStats> entrypointStats;
+	uint64_t malformedCalls = 0;
+	// Captured memory writes that landed in no replayed buffer
+	uint64_t missingMemoryBytes = 0;
+	uint64_t standInBinds = 0;
+	// Recorded commands that weren't replayed, e.g. descriptor set binds and dispatches
+	uint64_t skippedCommands = 0;
+
+	ReplayState(KonideRenderer& newRenderer) : renderer(newRenderer), vk(newRenderer.GetDeviceTable()), device(newRenderer.GetDevice()),
+		queue(newRenderer.GetGraphicsQueue()), queueFamily(newRenderer.GetGraphicsQueueFamily()) {}
+};
+
+template<typename T>
+static T FindHandle(const std::unordered_map<uint64_t, T>& handles, uint64_t key)
+{
+	auto found = handles.find(key);
+	return found != handles.end() ? found->second : T();
+}
+
+static VkBuffer FindBuffer(ReplayState& replay, VkBuffer buffer)
+{
+	return FindHandle(replay.buffers, HandleKey(buffer)).buffer;
+}
+
+static VkImage FindImage(ReplayState& replay, VkImage image)
+{
+	return FindHandle(replay.images, HandleKey(image)).image;
+}
+
+static ReplayCommandBuffer* FindCommandBuffer(ReplayState& replay, VkCommandBuffer commandBuffer)
+{
+	auto found = replay.commandBuffers.find(HandleKey(commandBuffer));
+	return found != replay.commandBuffers.end() ? &found->second : nullptr;
+}
+
+// There's no swapchain to present from, present layouts become general on both sides of a transition
+static VkImageLayout MapLayout(VkImageLayout layout)
+{
+	return layout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR ? VK_IMAGE_LAYOUT_GENERAL : layout;
+}
+
+// Takes the first type with every required property, device local types are preferred when none are required
+static VkDeviceMemory AllocateMemory(ReplayState& replay, const VkMemoryRequirements& requirements, VkMemoryPropertyFlags required = 0)
+{
+	uint32_t typeIndex = UINT32_MAX;
+	for (uint32_t i = 0; i < replay.memoryProperties.memoryTypeCount; i++)
+	{
+		VkMemoryPropertyFlags properties = replay.memoryProperties.memoryTypes[i].propertyFlags;
+		if (!(requirements.memoryTypeBits & (1u << i)) || (properties & required) != required)
+		{
+			continue;
+		}
+
+		if (required || (properties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+		{
+			typeIndex = i;
+			break;
+		}
+
+		if (typeIndex == UINT32_MAX)
+		{
+			typeIndex = i;
+		}
+	}
+
+	if (typeIndex == UINT32_MAX)
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	VkMemoryAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocateInfo.allocationSize = requirements.size;
+	allocateInfo.memoryTypeIndex = typeIndex;
+
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	if (replay.vk.vkAllocateMemory(replay.device, &allocateInfo, nullptr, &memory) != VK_SUCCESS)
+	{
+		return VK_NULL_HANDLE;
+	}
+	return memory;
+}
+
+static bool CreateImage(ReplayState& replay, uint64_t key, VkImageCreateInfo info)
+{
+	info.pNext = nullptr;
+	info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	info.queueFamilyIndexCount = 0;
+	info.pQueueFamilyIndices = nullptr;
+
+	ReplayImage image;
+	image.samples = info.samples;
+	if (replay.vk.vkCreateImage(replay.device, &info, nullptr, &image.image) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	VkMemoryRequirements requirements;
+	replay.vk.vkGetImageMemoryRequirements(replay.device, image.image, &requirements);
+	image.memory = AllocateMemory(replay, requirements);
+	if (!image.memory || replay.vk.vkBindImageMemory(replay.device, image.image, image.memory, 0) != VK_SUCCESS)
+	{
+		replay.vk.vkDestroyImage(replay.device, image.image, nullptr);
+		if (image.memory) replay.vk.vkFreeMemory(replay.device, image.memory, nullptr);
+		return false;
+	}
+
+	replay.images[key] = image;
+	return true;
+}
+
+static void DestroyImage(ReplayState& replay, uint64_t key)
+{
+	auto found = replay.images.find(key);
+	if (found == replay.images.end())
+	{
+		return;
+	}
+
+	replay.vk.vkDestroyImage(replay.device, found->second.image, nullptr);
+	replay.vk.vkFreeMemory(replay.device, found->second.memory, nullptr);
+	replay.images.erase(found);
+}
+
+static std::vector<uint32_t> LoadShaderCode(const std::string& path)
+{
+	std::vector<uint32_t> code;
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+	{
+		return code;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if (size > 0 && size % 4 == 0)
+	{
+		code.resize((size_t)size / 4);
+		if (fread(code.data(), 1, (size_t)size, file) != (size_t)size)
+		{
+			code.clear();
+		}
+	}
+	fclose(file);
+	return code;
+}
+
+static VkShaderModule CreateShader(ReplayState& replay, const std::string& path)
+{
+	std::vector<uint32_t> code = LoadShaderCode(path);
+	if (code.empty())
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	VkShaderModuleCreateInfo info{};
+	info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	info.codeSize = code.size() * sizeof(uint32_t);
+	info.pCode = code.data();
+
+	VkShaderModule module = VK_NULL_HANDLE;
+	if (replay.vk.vkCreateShaderModule(replay.device, &info, nullptr, &module) != VK_SUCCESS)
+	{
+		return VK_NULL_HANDLE;
+	}
+	return module;
+}
+
+// Stand-ins have no descriptor sets and one push constant range for every graphics stage
+static void CreateStandIns(ReplayState& replay, const std::string& shaderDir)
+{
+	VkPushConstantRange pushRange{};
+	pushRange.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+	pushRange.offset = 0;
+	pushRange.size = REPLAY_PUSH_CONSTANT_SIZE;
+
+	VkPipelineLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	layoutInfo.pushConstantRangeCount = 1;
+	layoutInfo.pPushConstantRanges = &pushRange;
+	replay.vk.vkCreatePipelineLayout(replay.device, &layoutInfo, nullptr, &replay.pipelineLayout);
+
+	if (!shaderDir.empty())
+	{
+		replay.vertexShader = CreateShader(replay, shaderDir + "/triangle.vert.spv");
+		replay.fragmentShader = CreateShader(replay, shaderDir + "/triangle.frag.spv");
+	}
+
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	poolInfo.queueFamilyIndex = replay.queueFamily;
+	replay.vk.vkCreateCommandPool(replay.device, &poolInfo, nullptr, &replay.setupPool);
+}
+
+// key holds the sample count, depth and stencil formats, then the color formats
+static VkPipeline GetStandInPipeline(ReplayState& replay, const std::vector<uint32_t>& key)
+{
+	auto found = replay.pipelines.find(key);
+	if (found != replay.pipelines.end())
+	{
+		return found->second;
+	}
+
+	if (!replay.vertexShader || !replay.fragmentShader || key.size() < 3)
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	VkPipelineShaderStageCreateInfo stages[2] = {};
+	stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+	stages[0].module = replay.vertexShader;
+	stages[0].pName = "main";
+	stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	stages[1].module = replay.fragmentShader;
+	stages[1].pName = "main";
+
+	VkPipelineVertexInputStateCreateInfo vertexInput{};
+	vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+	VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+	VkPipelineViewportStateCreateInfo viewportState{};
+	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewportState.viewportCount = 1;
+	viewportState.scissorCount = 1;
+
+	VkPipelineRasterizationStateCreateInfo rasterization{};
+	rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterization.cullMode = VK_CULL_MODE_NONE;
+	rasterization.frontFace = VK_FRONT_FACE_CLOCKWISE;
+	rasterization.lineWidth = 1.0f;
+
+	VkPipelineMultisampleStateCreateInfo multisample{};
+	multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisample.rasterizationSamples = (VkSampleCountFlagBits)key[0];
+
+	VkPipelineDepthStencilStateCreateInfo depthStencil{};
+	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+
+	std::vector<VkFormat> colorFormats;
+	for (size_t i = 3; i < key.size(); i++)
+	{
+		colorFormats.push_back((VkFormat)key[i]);
+	}
+
+	std::vector<VkPipelineColorBlendAttachmentState> blendAttachments(colorFormats.size());
+	for (VkPipelineColorBlendAttachmentState& attachment : blendAttachments)
+	{
+		attachment = {};
+		attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	}
+
+	VkPipelineColorBlendStateCreateInfo colorBlend{};
+	colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	colorBlend.attachmentCount = (uint32_t)blendAttachments.size();
+	colorBlend.pAttachments = blendAttachments.data();
+
+	// Everything the trace may set while the pipeline is bound
+	VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR, VK_DYNAMIC_STATE_LINE_WIDTH,
+		VK_DYNAMIC_STATE_DEPTH_BIAS, VK_DYNAMIC_STATE_BLEND_CONSTANTS, VK_DYNAMIC_STATE_STENCIL_REFERENCE };
+
+	VkPipelineDynamicStateCreateInfo dynamicState{};
+	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicState.dynamicStateCount = (uint32_t)(sizeof(dynamicStates) / sizeof(dynamicStates[0]));
+	dynamicState.pDynamicStates = dynamicStates;
+
+	VkPipelineRenderingCreateInfo rendering{};
+	rendering.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+	rendering.colorAttachmentCount = (uint32_t)colorFormats.size();
+	rendering.pColorAttachmentFormats = colorFormats.data();
+	rendering.depthAttachmentFormat = (VkFormat)key[1];
+	rendering.stencilAttachmentFormat = (VkFormat)key[2];
+
+	VkGraphicsPipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipelineInfo.pNext = &rendering;
+	pipelineInfo.stageCount = 2;
+	pipelineInfo.pStages = stages;
+	pipelineInfo.pVertexInputState = &vertexInput;
+	pipelineInfo.pInputAssemblyState = &inputAssembly;
+	pipelineInfo.pViewportState = &viewportState;
+	pipelineInfo.pRasterizationState = &rasterization;
+	pipelineInfo.pMultisampleState = &multisample;
+	pipelineInfo.pDepthStencilState = &depthStencil;
+	pipelineInfo.pColorBlendState = &colorBlend;
+	pipelineInfo.pDynamicState = &dynamicState;
+	pipelineInfo.layout = replay.pipelineLayout;
+
+	// A failed build is kept as null, draws with it are skipped
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	if (replay.vk.vkCreateGraphicsPipelines(replay.device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
+	{
+		pipeline = VK_NULL_HANDLE;
+	}
+	replay.pipelines[key] = pipeline;
+	return pipeline;
+}
+
+static void DestroySetup(ReplayState& replay, const ReplaySetup& setup)
+{
+	replay.vk.vkFreeCommandBuffers(replay.device, replay.setupPool, 1, &setup.commandBuffer);
+	replay.vk.vkDestroyFence(replay.device, setup.fence, nullptr);
+	if (setup.staging) replay.vk.vkDestroyBuffer(replay.device, setup.staging, nullptr);
+	if (setup.stagingMemory) replay.vk.vkFreeMemory(replay.device, setup.stagingMemory, nullptr);
+}
+
+static void ReclaimSetups(ReplayState& replay)
+{
+	auto done = std::remove_if(replay.setups.begin(), replay.setups.end(), [&replay](const ReplaySetup& setup)
+	{
+		if (replay.vk.vkGetFenceStatus(replay.device, setup.fence) != VK_SUCCESS)
+		{
+			return false;
+		}
+
+		DestroySetup(replay, setup);
+		return true;
+	});
+	replay.setups.erase(done, replay.setups.end());
+}
+
+// Copies the pending writes into a host visible buffer to copy from, returns false if there's no memory for it
+static bool CreateStaging(ReplayState& replay, ReplaySetup& setup)
+{
+	VkDeviceSize size = 0;
+	for (const ReplayWrite& write : replay.pendingWrites)
+	{
+		size += write.size;
+	}
+
+	VkBufferCreateInfo info{};
+	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	info.size = size;
+	info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+	info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if (replay.vk.vkCreateBuffer(replay.device, &info, nullptr, &setup.staging) != VK_SUCCESS)
+	{
+		setup.staging = VK_NULL_HANDLE;
+		return false;
+	}
+
+	VkMemoryRequirements requirements;
+	replay.vk.vkGetBufferMemoryRequirements(replay.device, setup.staging, &requirements);
+	setup.stagingMemory = AllocateMemory(replay, requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	void* mapped = nullptr;
+	if (!setup.stagingMemory || replay.vk.vkBindBufferMemory(replay.device, setup.staging, setup.stagingMemory, 0) != VK_SUCCESS ||
+		replay.vk.vkMapMemory(replay.device, setup.stagingMemory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+	{
+		replay.vk.vkDestroyBuffer(replay.device, setup.staging, nullptr);
+		if (setup.stagingMemory) replay.vk.vkFreeMemory(replay.device, setup.stagingMemory, nullptr);
+		setup.staging = VK_NULL_HANDLE;
+		setup.stagingMemory = VK_NULL_HANDLE;
+		return false;
+	}
+
+	VkDeviceSize offset = 0;
+	for (const ReplayWrite& write : replay.pendingWrites)
+	{
+		memcpy((uint8_t*)mapped + offset, write.data, (size_t)write.size);
+		offset += write.size;
+	}
+	replay.vk.vkUnmapMemory(replay.device, setup.stagingMemory);
+	return true;
+}
+
+static void RecordBarrier(ReplayState& replay, VkCommandBuffer commandBuffer, VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess, VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess)
+{
+	VkMemoryBarrier2 barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+	barrier.srcStageMask = srcStage;
+	barrier.srcAccessMask = srcAccess;
+	barrier.dstStageMask = dstStage;
+	barrier.dstAccessMask = dstAccess;
+
+	VkDependencyInfo dependency{};
+	dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+	dependency.memoryBarrierCount = 1;
+	dependency.pMemoryBarriers = &barrier;
+	replay.vk.vkCmdPipelineBarrier2(commandBuffer, &dependency);
+}
+
+// Clears new buffers and copies in captured memory writes, on the queue ahead of the submit that reads them
+static void FlushPendingSetup(ReplayState& replay)
+{
+	ReclaimSetups(replay);
+	if (replay.pendingClears.empty() && replay.pendingWrites.empty())
+	{
+		return;
+	}
+
+	ReplaySetup setup;
+	if (!replay.pendingWrites.empty() && !CreateStaging(replay, setup))
+	{
+		for (const ReplayWrite& write : replay.pendingWrites)
+		{
+			replay.missingMemoryBytes += write.size;
+		}
+		replay.pendingWrites.clear();
+	}
+
+	VkCommandBufferAllocateInfo allocateInfo{};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocateInfo.commandPool = replay.setupPool;
+	allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocateInfo.commandBufferCount = 1;
+
+	VkFenceCreateInfo fenceInfo{};
+	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+	if (replay.vk.vkAllocateCommandBuffers(replay.device, &allocateInfo, &setup.commandBuffer) != VK_SUCCESS ||
+		replay.vk.vkCreateFence(replay.device, &fenceInfo, nullptr, &setup.fence) != VK_SUCCESS)
+	{
+		for (const ReplayWrite& write : replay.pendingWrites)
+		{
+			replay.missingMemoryBytes += write.size;
+		}
+		if (setup.commandBuffer) replay.vk.vkFreeCommandBuffers(replay.device, replay.setupPool, 1, &setup.commandBuffer);
+		if (setup.staging) replay.vk.vkDestroyBuffer(replay.device, setup.staging, nullptr);
+		if (setup.stagingMemory) replay.vk.vkFreeMemory(replay.device, setup.stagingMemory, nullptr);
+		replay.pendingClears.clear();
+		replay.pendingWrites.clear();
+		return;
+	}
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	replay.vk.vkBeginCommandBuffer(setup.commandBuffer, &beginInfo);
+
+	for (VkBuffer buffer : replay.pendingClears)
+	{
+		replay.vk.vkCmdFillBuffer(setup.commandBuffer, buffer, 0, VK_WHOLE_SIZE, 0);
+	}
+
+	if (!replay.pendingWrites.empty())
+	{
+		// Earlier submits may still read what's overwritten, and the writes land on top of the clears
+		RecordBarrier(replay, setup.commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT,
+			VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+		VkDeviceSize offset = 0;
+		for (const ReplayWrite& write : replay.pendingWrites)
+		{
+			VkBufferCopy region{};
+			region.srcOffset = offset;
+			region.dstOffset = write.offset;
+			region.size = write.size;
+			replay.vk.vkCmdCopyBuffer(setup.commandBuffer, setup.staging, write.buffer, 1, &region);
+			offset += write.size;
+		}
+	}
+
+	RecordBarrier(replay, setup.commandBuffer, VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+		VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT);
+	replay.vk.vkEndCommandBuffer(setup.commandBuffer);
+
+	VkCommandBufferSubmitInfo commandBufferInfo{};
+	commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+	commandBufferInfo.commandBuffer = setup.commandBuffer;
+
+	VkSubmitInfo2 submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+	submitInfo.commandBufferInfoCount = 1;
+	submitInfo.pCommandBufferInfos = &commandBufferInfo;
+	replay.vk.vkQueueSubmit2(replay.queue, 1, &submitInfo, setup.fence);
+
+	replay.setups.push_back(setup);
+	replay.pendingClears.clear();
+	replay.pendingWrites.clear();
+}
+
+// Places a captured memory write in the buffers bound to that memory. Bytes outside every one of them are missing.
+static void ReplayMemory(ReplayState& replay, const KonideTraceRecord& record)
+{
+	KonideTraceMemoryHeader header;
+	memcpy(&header, record.payload, sizeof(header));
+	const uint8_t* data = record.payload + sizeof(header);
+	VkDeviceSize size = record.header.size - sizeof(header);
+
+	std::vector<std::pair<VkDeviceSize, VkDeviceSize>> covered;
+	auto found = replay.memoryBuffers.find(header.memory);
+	if (found != replay.memoryBuffers.end())
+	{
+		for (uint64_t key : found->second)
+		{
+			const ReplayBuffer& buffer = replay.buffers[key];
+			VkDeviceSize begin = std::max<VkDeviceSize>(header.offset, buffer.boundOffset);
+			VkDeviceSize end = std::min<VkDeviceSize>(header.offset + size, buffer.boundOffset + buffer.size);
+			if (begin >= end)
+			{
+				continue;
+			}
+
+			ReplayWrite write;
+			write.buffer = buffer.buffer;
+			write.offset = begin - buffer.boundOffset;
+			write.data = data + (begin - header.offset);
+			write.size = end - begin;
+			replay.pendingWrites.push_back(write);
+			covered.emplace_back(begin, end);
+		}
+	}
+
+	// Buffers may alias, overlapping ranges count once
+	std::sort(covered.begin(), covered.end());
+	VkDeviceSize coveredSize = 0;
+	VkDeviceSize coveredEnd = 0;
+	for (const auto& range : covered)
+	{
+		VkDeviceSize begin = std::max(range.first, coveredEnd);
+		if (range.second > begin)
+		{
+			coveredSize += range.second - begin;
+			coveredEnd = range.second;
+		}
+	}
+	replay.missingMemoryBytes += size - coveredSize;
+}
+
+// Handlers decode one call and replay it, returning false if it was skipped. Every payload starts with the result.
+
+static bool ReplayGetDeviceQueue(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkQueue* queue = nullptr;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), SkipArg(), SkipArg(), Array(queue)) || !queue)
+	{
+		return false;
+	}
+
+	// Every captured queue replays on the one graphics queue
+	replay.queues[HandleKey(*queue)] = replay.queue;
+	return true;
+}
+
+static bool ReplayCreateBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkBufferCreateInfo* info = nullptr;
+	VkBuffer* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	info->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	info->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	info->queueFamilyIndexCount = 0;
+	info->pQueueFamilyIndices = nullptr;
+
+	ReplayBuffer buffer;
+	if (replay.vk.vkCreateBuffer(replay.device, info, nullptr, &buffer.buffer) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	// Memory is allocated here, the captured allocations and binds aren't replayed
+	VkMemoryRequirements requirements;
+	replay.vk.vkGetBufferMemoryRequirements(replay.device, buffer.buffer, &requirements);
+	buffer.memory = AllocateMemory(replay, requirements);
+	if (!buffer.memory || replay.vk.vkBindBufferMemory(replay.device, buffer.buffer, buffer.memory, 0) != VK_SUCCESS)
+	{
+		replay.vk.vkDestroyBuffer(replay.device, buffer.buffer, nullptr);
+		if (buffer.memory) replay.vk.vkFreeMemory(replay.device, buffer.memory, nullptr);
+		return false;
+	}
+
+	buffer.size = info->size;
+	replay.buffers[HandleKey(*captured)] = buffer;
+	replay.pendingClears.push_back(buffer.buffer);
+	return true;
+}
+
+static void UnbindBuffer(ReplayState& replay, uint64_t key, const ReplayBuffer& buffer)
+{
+	auto bound = replay.memoryBuffers.find(buffer.boundMemory);
+	if (bound != replay.memoryBuffers.end())
+	{
+		bound->second.erase(std::remove(bound->second.begin(), bound->second.end(), key), bound->second.end());
+	}
+}
+
+// The replay allocates its own memory, the bind only records where the buffer sits for captured memory writes
+static bool ReplayBindBufferMemory(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkBuffer captured;
+	VkDeviceMemory memory;
+	VkDeviceSize offset;
+	if (!DecodeArgs(decoder, result, SkipArg(), captured, memory, offset) || result != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	auto found = replay.buffers.find(HandleKey(captured));
+	if (found == replay.buffers.end())
+	{
+		return false;
+	}
+
+	UnbindBuffer(replay, found->first, found->second);
+	found->second.boundMemory = HandleKey(memory);
+	found->second.boundOffset = offset;
+	replay.memoryBuffers[HandleKey(memory)].push_back(found->first);
+	return true;
+}
+
+static bool ReplayFreeMemory(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkDeviceMemory memory;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), memory))
+	{
+		return false;
+	}
+
+	replay.memoryBuffers.erase(HandleKey(memory));
+	return true;
+}
+
+// Allocations, maps and flushes have nothing to replay, the contents arrive as memory records
+static bool ReplayMemoryCall(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	return true;
+}
+
+static bool ReplayDestroyBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkBuffer captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	auto found = replay.buffers.find(HandleKey(captured));
+	if (found == replay.buffers.end())
+	{
+		return false;
+	}
+
+	// Not cleared or written yet if it never made it to a submit
+	VkBuffer buffer = found->second.buffer;
+	replay.pendingClears.erase(std::remove(replay.pendingClears.begin(), replay.pendingClears.end(), buffer), replay.pendingClears.end());
+	replay.pendingWrites.erase(std::remove_if(replay.pendingWrites.begin(), replay.pendingWrites.end(), [buffer](const ReplayWrite& write)
+	{
+		return write.buffer == buffer;
+	}), replay.pendingWrites.end());
+	UnbindBuffer(replay, found->first, found->second);
+	replay.vk.vkDestroyBuffer(replay.device, found->second.buffer, nullptr);
+	replay.vk.vkFreeMemory(replay.device, found->second.memory, nullptr);
+	replay.buffers.erase(found);
+	return true;
+}
+
+static bool ReplayCreateImage(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkImageCreateInfo* info = nullptr;
+	VkImage* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	return CreateImage(replay, HandleKey(*captured), *info);
+}
+
+static bool ReplayDestroyImage(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkImage captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	DestroyImage(replay, HandleKey(captured));
+	return true;
+}
+
+static bool ReplayCreateImageView(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkImageViewCreateInfo* info = nullptr;
+	VkImageView* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	auto image = replay.images.find(HandleKey(info->image));
+	if (image == replay.images.end())
+	{
+		return false;
+	}
+	info->image = image->second.image;
+
+	ReplayImageView view;
+	view.format = info->format;
+	view.samples = image->second.samples;
+	if (replay.vk.vkCreateImageView(replay.device, info, nullptr, &view.view) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	replay.imageViews[HandleKey(*captured)] = view;
+	return true;
+}
+
+static bool ReplayDestroyImageView(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkImageView captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	auto found = replay.imageViews.find(HandleKey(captured));
+	if (found == replay.imageViews.end())
+	{
+		return false;
+	}
+
+	replay.vk.vkDestroyImageView(replay.device, found->second.view, nullptr);
+	replay.imageViews.erase(found);
+	return true;
+}
+
+static bool ReplayCreateSwapchain(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkSwapchainCreateInfoKHR* info = nullptr;
+	VkSwapchainKHR* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	// Images are made once the trace asks for them
+	ReplaySwapchain swapchain;
+	swapchain.info = *info;
+	replay.swapchains[HandleKey(*captured)] = swapchain;
+	return true;
+}
+
+static bool ReplayGetSwapchainImages(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkSwapchainKHR captured;
+	VkImage* images = nullptr;
+	uint32_t imageCount = 0;
+	if (!DecodeArgs(decoder, result, SkipArg(), captured, SkipArg(), Array(images, &imageCount)) || !images)
+	{
+		return false;
+	}
+
+	auto found = replay.swapchains.find(HandleKey(captured));
+	if (found == replay.swapchains.end())
+	{
+		return false;
+	}
+	ReplaySwapchain& swapchain = found->second;
+
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.format = swapchain.info.imageFormat;
+	imageInfo.extent = { swapchain.info.imageExtent.width, swapchain.info.imageExtent.height, 1 };
+	imageInfo.mipLevels = 1;
+	imageInfo.arrayLayers = swapchain.info.imageArrayLayers;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.usage = swapchain.info.imageUsage;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	for (uint32_t i = 0; i < imageCount; i++)
+	{
+		uint64_t key = HandleKey(images[i]);
+		if (replay.images.count(key))
+		{
+			continue;
+		}
+
+		// Swapchains allow usages the format can't have on a plain image, fall back to what rendering needs
+		if (!CreateImage(replay, key, imageInfo))
+		{
+			VkImageCreateInfo fallbackInfo = imageInfo;
+			fallbackInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+			if (!CreateImage(replay, key, fallbackInfo))
+			{
+				continue;
+			}
+		}
+		swapchain.images.push_back(key);
+	}
+	return true;
+}
+
+static bool ReplayDestroySwapchain(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkSwapchainKHR captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	auto found = replay.swapchains.find(HandleKey(captured));
+	if (found == replay.swapchains.end())
+	{
+		return false;
+	}
+
+	for (uint64_t image : found->second.images)
+	{
+		DestroyImage(replay, image);
+	}
+	replay.swapchains.erase(found);
+	return true;
+}
+
+static bool ReplayCreateSemaphore(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkSemaphoreCreateInfo* info = nullptr;
+	VkSemaphore* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	const VkSemaphoreTypeCreateInfo* type = (const VkSemaphoreTypeCreateInfo*)info->pNext;
+	if (!type || type->semaphoreType != VK_SEMAPHORE_TYPE_TIMELINE)
+	{
+		replay.semaphores[HandleKey(*captured)] = VK_NULL_HANDLE;
+		return false;
+	}
+
+	VkSemaphore semaphore = VK_NULL_HANDLE;
+	if (replay.vk.vkCreateSemaphore(replay.device, info, nullptr, &semaphore) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	replay.semaphores[HandleKey(*captured)] = semaphore;
+	return true;
+}
+
+static bool ReplayDestroySemaphore(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkSemaphore captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	auto found = replay.semaphores.find(HandleKey(captured));
+	if (found == replay.semaphores.end())
+	{
+		return false;
+	}
+
+	VkSemaphore semaphore = found->second;
+	replay.semaphores.erase(found);
+	if (!semaphore)
+	{
+		return false;
+	}
+	replay.vk.vkDestroySemaphore(replay.device, semaphore, nullptr);
+	return true;
+}
+
+static bool ReplayWaitSemaphores(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkSemaphoreWaitInfo* info = nullptr;
+	uint64_t timeout;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), Array(info), timeout) || !info || !info->pSemaphores || !info->pValues)
+	{
+		return false;
+	}
+
+	std::vector<VkSemaphore> semaphores;
+	std::vector<uint64_t> values;
+	for (uint32_t i = 0; i < info->semaphoreCount; i++)
+	{
+		VkSemaphore semaphore = FindHandle(replay.semaphores, HandleKey(info->pSemaphores[i]));
+		if (semaphore)
+		{
+			semaphores.push_back(semaphore);
+			values.push_back(info->pValues[i]);
+		}
+	}
+
+	if (semaphores.empty())
+	{
+		return false;
+	}
+
+	info->semaphoreCount = (uint32_t)semaphores.size();
+	info->pSemaphores = semaphores.data();
+	info->pValues = values.data();
+	replay.vk.vkWaitSemaphores(replay.device, info, timeout);
+	return true;
+}
+
+static bool ReplayGetSemaphoreCounterValue(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkSemaphore captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	VkSemaphore semaphore = FindHandle(replay.semaphores, HandleKey(captured));
+	if (!semaphore)
+	{
+		return false;
+	}
+
+	uint64_t value = 0;
+	replay.vk.vkGetSemaphoreCounterValue(replay.device, semaphore, &value);
+	return true;
+}
+
+static bool ReplayCreateFence(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkFenceCreateInfo* info = nullptr;
+	VkFence* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	VkFence fence = VK_NULL_HANDLE;
+	if (replay.vk.vkCreateFence(replay.device, info, nullptr, &fence) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	replay.fences[HandleKey(*captured)] = fence;
+	return true;
+}
+
+static bool ReplayDestroyFence(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkFence captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	auto found = replay.fences.find(HandleKey(captured));
+	if (found == replay.fences.end())
+	{
+		return false;
+	}
+
+	replay.vk.vkDestroyFence(replay.device, found->second, nullptr);
+	replay.fences.erase(found);
+	return true;
+}
+
+static std::vector<VkFence> MapFences(ReplayState& replay, const VkFence* captured, uint32_t count)
+{
+	std::vector<VkFence> fences;
+	for (uint32_t i = 0; captured && i < count; i++)
+	{
+		VkFence fence = FindHandle(replay.fences, HandleKey(captured[i]));
+		if (fence)
+		{
+			fences.push_back(fence);
+		}
+	}
+	return fences;
+}
+
+static bool ReplayWaitForFences(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkFence* captured = nullptr;
+	uint32_t count = 0;
+	VkBool32 bWaitAll;
+	uint64_t timeout;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), SkipArg(), Array(captured, &count), bWaitAll, timeout))
+	{
+		return false;
+	}
+
+	std::vector<VkFence> fences = MapFences(replay, captured, count);
+	if (fences.empty())
+	{
+		return false;
+	}
+
+	replay.vk.vkWaitForFences(replay.device, (uint32_t)fences.size(), fences.data(), bWaitAll, timeout);
+	return true;
+}
+
+static bool ReplayResetFences(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkFence* captured = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), SkipArg(), Array(captured, &count)))
+	{
+		return false;
+	}
+
+	std::vector<VkFence> fences = MapFences(replay, captured, count);
+	if (fences.empty())
+	{
+		return false;
+	}
+
+	replay.vk.vkResetFences(replay.device, (uint32_t)fences.size(), fences.data());
+	return true;
+}
+
+static bool ReplayCreateCommandPool(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkCommandPoolCreateInfo* info = nullptr;
+	VkCommandPool* captured = nullptr;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), SkipArg(), Array(captured)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	info->queueFamilyIndex = replay.queueFamily;
+
+	VkCommandPool pool = VK_NULL_HANDLE;
+	if (replay.vk.vkCreateCommandPool(replay.device, info, nullptr, &pool) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	replay.commandPools[HandleKey(*captured)] = pool;
+	return true;
+}
+
+static bool ReplayDestroyCommandPool(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandPool captured;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured))
+	{
+		return false;
+	}
+
+	uint64_t key = HandleKey(captured);
+	auto found = replay.commandPools.find(key);
+	if (found == replay.commandPools.end())
+	{
+		return false;
+	}
+
+	// Command buffers go with their pool
+	for (auto it = replay.commandBuffers.begin(); it != replay.commandBuffers.end();)
+	{
+		it = it->second.pool == key ? replay.commandBuffers.erase(it) : std::next(it);
+	}
+
+	replay.vk.vkDestroyCommandPool(replay.device, found->second, nullptr);
+	replay.commandPools.erase(found);
+	return true;
+}
+
+static bool ReplayResetCommandPool(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandPool captured;
+	VkCommandPoolResetFlags flags;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), captured, flags))
+	{
+		return false;
+	}
+
+	VkCommandPool pool = FindHandle(replay.commandPools, HandleKey(captured));
+	if (!pool)
+	{
+		return false;
+	}
+
+	replay.vk.vkResetCommandPool(replay.device, pool, flags);
+	return true;
+}
+
+static bool ReplayAllocateCommandBuffers(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkResult result;
+	VkCommandBufferAllocateInfo* info = nullptr;
+	VkCommandBuffer* captured = nullptr;
+	uint32_t capturedCount = 0;
+	if (!DecodeArgs(decoder, result, SkipArg(), Array(info), Array(captured, &capturedCount)) || result != VK_SUCCESS || !info || !captured)
+	{
+		return false;
+	}
+
+	uint64_t poolKey = HandleKey(info->commandPool);
+	info->commandPool = FindHandle(replay.commandPools, poolKey);
+	info->commandBufferCount = std::min(info->commandBufferCount, capturedCount);
+	if (!info->commandPool || !info->commandBufferCount)
+	{
+		return false;
+	}
+
+	std::vector<VkCommandBuffer> commandBuffers(info->commandBufferCount);
+	if (replay.vk.vkAllocateCommandBuffers(replay.device, info, commandBuffers.data()) != VK_SUCCESS)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < info->commandBufferCount; i++)
+	{
+		ReplayCommandBuffer& commandBuffer = replay.commandBuffers[HandleKey(captured[i])];
+		commandBuffer = ReplayCommandBuffer();
+		commandBuffer.commandBuffer = commandBuffers[i];
+		commandBuffer.pool = poolKey;
+	}
+	return true;
+}
+
+static bool ReplayFreeCommandBuffers(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandPool capturedPool;
+	VkCommandBuffer* captured = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), SkipArg(), capturedPool, SkipArg(), Array(captured, &count)) || !captured)
+	{
+		return false;
+	}
+
+	VkCommandPool pool = FindHandle(replay.commandPools, HandleKey(capturedPool));
+	std::vector<VkCommandBuffer> commandBuffers;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		auto found = replay.commandBuffers.find(HandleKey(captured[i]));
+		if (found != replay.commandBuffers.end())
+		{
+			commandBuffers.push_back(found->second.commandBuffer);
+			replay.commandBuffers.erase(found);
+		}
+	}
+
+	if (!pool || commandBuffers.empty())
+	{
+		return false;
+	}
+
+	replay.vk.vkFreeCommandBuffers(replay.device, pool, (uint32_t)commandBuffers.size(), commandBuffers.data());
+	return true;
+}
+
+static bool ReplayBeginCommandBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkCommandBufferBeginInfo* info = nullptr;
+	if (!DecodeArgs(decoder, SkipArg(), captured, Array(info)) || !info)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	commandBuffer->bRendering = false;
+	commandBuffer->bPipelineBound = false;
+	commandBuffer->renderingKey.clear();
+
+	// Render passes aren't replayed, only secondaries continuing dynamic rendering inherit anything
+	VkCommandBufferInheritanceInfo inheritance{};
+	if (info->pInheritanceInfo)
+	{
+		inheritance = *info->pInheritanceInfo;
+		inheritance.renderPass = VK_NULL_HANDLE;
+		inheritance.framebuffer = VK_NULL_HANDLE;
+		info->pInheritanceInfo = &inheritance;
+
+		const VkCommandBufferInheritanceRenderingInfo* rendering = (const VkCommandBufferInheritanceRenderingInfo*)inheritance.pNext;
+		if (rendering && (info->flags & VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT))
+		{
+			commandBuffer->bRendering = true;
+			commandBuffer->renderingKey = { (uint32_t)rendering->rasterizationSamples, (uint32_t)rendering->depthAttachmentFormat, (uint32_t)rendering->stencilAttachmentFormat };
+			for (uint32_t i = 0; rendering->pColorAttachmentFormats && i < rendering->colorAttachmentCount; i++)
+			{
+				commandBuffer->renderingKey.push_back((uint32_t)rendering->pColorAttachmentFormats[i]);
+			}
+		}
+		else
+		{
+			info->flags &= ~VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		}
+	}
+
+	replay.vk.vkBeginCommandBuffer(commandBuffer->commandBuffer, info);
+	return true;
+}
+
+static bool ReplayEndCommandBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	if (!DecodeArgs(decoder, SkipArg(), captured))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkEndCommandBuffer(commandBuffer->commandBuffer);
+	return true;
+}
+
+static bool ReplayResetCommandBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkFlags flags;
+	if (!DecodeArgs(decoder, SkipArg(), captured, flags))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkResetCommandBuffer(commandBuffer->commandBuffer, flags);
+	return true;
+}
+
+static bool ReplayPipelineBarrier2(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkDependencyInfo* info = nullptr;
+	if (!DecodeArgs(decoder, SkipArg(), captured, Array(info)) || !info)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	// Barriers on resources that weren't recreated are dropped, there's one queue family so ownership transfers go
+	std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+	for (uint32_t i = 0; info->pBufferMemoryBarriers && i < info->bufferMemoryBarrierCount; i++)
+	{
+		VkBufferMemoryBarrier2 barrier = info->pBufferMemoryBarriers[i];
+		barrier.pNext = nullptr;
+		barrier.buffer = FindBuffer(replay, barrier.buffer);
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		if (barrier.buffer)
+		{
+			bufferBarriers.push_back(barrier);
+		}
+	}
+
+	std::vector<VkImageMemoryBarrier2> imageBarriers;
+	for (uint32_t i = 0; info->pImageMemoryBarriers && i < info->imageMemoryBarrierCount; i++)
+	{
+		VkImageMemoryBarrier2 barrier = info->pImageMemoryBarriers[i];
+		barrier.pNext = nullptr;
+		barrier.image = FindImage(replay, barrier.image);
+		barrier.oldLayout = MapLayout(barrier.oldLayout);
+		barrier.newLayout = MapLayout(barrier.newLayout);
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		if (barrier.image)
+		{
+			imageBarriers.push_back(barrier);
+		}
+	}
+
+	info->memoryBarrierCount = info->pMemoryBarriers ? info->memoryBarrierCount : 0;
+	info->bufferMemoryBarrierCount = (uint32_t)bufferBarriers.size();
+	info->pBufferMemoryBarriers = bufferBarriers.data();
+	info->imageMemoryBarrierCount = (uint32_t)imageBarriers.size();
+	info->pImageMemoryBarriers = imageBarriers.data();
+	replay.vk.vkCmdPipelineBarrier2(commandBuffer->commandBuffer, info);
+	return true;
+}
+
+static void MapRenderingAttachment(ReplayState& replay, VkRenderingAttachmentInfo& attachment, VkFormat& format, VkSampleCountFlagBits& samples)
+{
+	ReplayImageView view = FindHandle(replay.imageViews, HandleKey(attachment.imageView));
+	ReplayImageView resolveView = FindHandle(replay.imageViews, HandleKey(attachment.resolveImageView));
+
+	attachment.pNext = nullptr;
+	attachment.imageView = view.view;
+	attachment.imageLayout = MapLayout(attachment.imageLayout);
+	attachment.resolveImageView = resolveView.view;
+	attachment.resolveImageLayout = MapLayout(attachment.resolveImageLayout);
+	if (!resolveView.view)
+	{
+		attachment.resolveMode = VK_RESOLVE_MODE_NONE;
+	}
+
+	format = view.view ? view.format : VK_FORMAT_UNDEFINED;
+	if (view.view)
+	{
+		samples = view.samples;
+	}
+}
+
+static bool ReplayBeginRendering(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkRenderingInfo* info = nullptr;
+	if (!DecodeArgs(decoder, SkipArg(), captured, Array(info)) || !info)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+	VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+	VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+
+	std::vector<VkRenderingAttachmentInfo> colorAttachments;
+	std::vector<uint32_t> colorFormats;
+	for (uint32_t i = 0; info->pColorAttachments && i < info->colorAttachmentCount; i++)
+	{
+		VkRenderingAttachmentInfo attachment = info->pColorAttachments[i];
+		VkFormat format;
+		MapRenderingAttachment(replay, attachment, format, samples);
+		colorAttachments.push_back(attachment);
+		colorFormats.push_back((uint32_t)format);
+	}
+
+	VkRenderingAttachmentInfo depthAttachment;
+	if (info->pDepthAttachment)
+	{
+		depthAttachment = *info->pDepthAttachment;
+		MapRenderingAttachment(replay, depthAttachment, depthFormat, samples);
+		info->pDepthAttachment = &depthAttachment;
+	}
+
+	VkRenderingAttachmentInfo stencilAttachment;
+	if (info->pStencilAttachment)
+	{
+		stencilAttachment = *info->pStencilAttachment;
+		MapRenderingAttachment(replay, stencilAttachment, stencilFormat, samples);
+		info->pStencilAttachment = &stencilAttachment;
+	}
+
+	info->colorAttachmentCount = (uint32_t)colorAttachments.size();
+	info->pColorAttachments = colorAttachments.data();
+	replay.vk.vkCmdBeginRendering(commandBuffer->commandBuffer, info);
+
+	commandBuffer->bRendering = true;
+	commandBuffer->bPipelineBound = false;
+	commandBuffer->renderingKey = { (uint32_t)samples, (uint32_t)depthFormat, (uint32_t)stencilFormat };
+	commandBuffer->renderingKey.insert(commandBuffer->renderingKey.end(), colorFormats.begin(), colorFormats.end());
+	return true;
+}
+
+static bool ReplayEndRendering(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	if (!DecodeArgs(decoder, SkipArg(), captured))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdEndRendering(commandBuffer->commandBuffer);
+	commandBuffer->bRendering = false;
+	commandBuffer->bPipelineBound = false;
+	return true;
+}
+
+static bool ReplayExecuteCommands(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkCommandBuffer* secondaries = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, SkipArg(), Array(secondaries, &count)) || !secondaries)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	std::vector<VkCommandBuffer> commandBuffers;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		ReplayCommandBuffer* secondary = FindCommandBuffer(replay, secondaries[i]);
+		if (secondary)
+		{
+			commandBuffers.push_back(secondary->commandBuffer);
+		}
+	}
+
+	if (commandBuffers.empty())
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdExecuteCommands(commandBuffer->commandBuffer, (uint32_t)commandBuffers.size(), commandBuffers.data());
+	return true;
+}
+
+static bool ReplayBindPipeline(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkPipelineBindPoint bindPoint;
+	if (!DecodeArgs(decoder, SkipArg(), captured, bindPoint, SkipArg()))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer || bindPoint != VK_PIPELINE_BIND_POINT_GRAPHICS || !commandBuffer->bRendering)
+	{
+		return false;
+	}
+
+	VkPipeline pipeline = GetStandInPipeline(replay, commandBuffer->renderingKey);
+	commandBuffer->bPipelineBound = pipeline != VK_NULL_HANDLE;
+	replay.standInBinds++;
+	if (!pipeline)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdBindPipeline(commandBuffer->commandBuffer, bindPoint, pipeline);
+	return true;
+}
+
+static bool ReplayBindVertexBuffers(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	uint32_t firstBinding;
+	VkBuffer* buffers = nullptr;
+	VkDeviceSize* offsets = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, firstBinding, SkipArg(), Array(buffers, &count), Array(offsets)) || !buffers || !offsets)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		buffers[i] = FindBuffer(replay, buffers[i]);
+		if (!buffers[i])
+		{
+			return false;
+		}
+	}
+
+	replay.vk.vkCmdBindVertexBuffers(commandBuffer->commandBuffer, firstBinding, count, buffers, offsets);
+	return true;
+}
+
+static bool ReplayBindIndexBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkBuffer buffer;
+	VkDeviceSize offset;
+	VkIndexType indexType;
+	if (!DecodeArgs(decoder, SkipArg(), captured, buffer, offset, indexType))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	buffer = FindBuffer(replay, buffer);
+	if (!commandBuffer || !buffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdBindIndexBuffer(commandBuffer->commandBuffer, buffer, offset, indexType);
+	return true;
+}
+
+static bool ReplayPushConstants(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkShaderStageFlags stageFlags;
+	uint32_t offset;
+	uint32_t size;
+	const void* values = nullptr;
+	uint32_t valuesSize = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, SkipArg(), stageFlags, offset, size) || !decoder.DecodeBlob(values, valuesSize) || !values)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer || !(stageFlags & VK_SHADER_STAGE_ALL_GRAPHICS) || offset >= REPLAY_PUSH_CONSTANT_SIZE)
+	{
+		return false;
+	}
+
+	// Push constant offsets and sizes are multiples of 4
+	size = std::min(std::min(size, valuesSize), REPLAY_PUSH_CONSTANT_SIZE - offset) & ~3u;
+	if (!size)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdPushConstants(commandBuffer->commandBuffer, replay.pipelineLayout, VK_SHADER_STAGE_ALL_GRAPHICS, offset, size, values);
+	return true;
+}
+
+static bool ReplaySetViewport(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	uint32_t first;
+	VkViewport* viewports = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, first, SkipArg(), Array(viewports, &count)) || !viewports)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdSetViewport(commandBuffer->commandBuffer, first, count, viewports);
+	return true;
+}
+
+static bool ReplaySetScissor(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	uint32_t first;
+	VkRect2D* scissors = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, first, SkipArg(), Array(scissors, &count)) || !scissors)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdSetScissor(commandBuffer->commandBuffer, first, count, scissors);
+	return true;
+}
+
+static bool ReplaySetLineWidth(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	float lineWidth;
+	if (!DecodeArgs(decoder, SkipArg(), captured, lineWidth))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdSetLineWidth(commandBuffer->commandBuffer, lineWidth);
+	return true;
+}
+
+static bool ReplaySetDepthBias(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	float constantFactor;
+	float clamp;
+	float slopeFactor;
+	if (!DecodeArgs(decoder, SkipArg(), captured, constantFactor, clamp, slopeFactor))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdSetDepthBias(commandBuffer->commandBuffer, constantFactor, clamp, slopeFactor);
+	return true;
+}
+
+static bool ReplaySetBlendConstants(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	float* constants = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, Array(constants, &count)) || !constants)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	// The pointer carries no count, only the first constant is in the trace
+	float blendConstants[4] = {};
+	memcpy(blendConstants, constants, sizeof(float) * std::min(count, 4u));
+	replay.vk.vkCmdSetBlendConstants(commandBuffer->commandBuffer, blendConstants);
+	return true;
+}
+
+static bool ReplaySetStencilReference(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkStencilFaceFlags faceMask;
+	uint32_t reference;
+	if (!DecodeArgs(decoder, SkipArg(), captured, faceMask, reference))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdSetStencilReference(commandBuffer->commandBuffer, faceMask, reference);
+	return true;
+}
+
+static bool ReplayDraw(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	uint32_t vertexCount;
+	uint32_t instanceCount;
+	uint32_t firstVertex;
+	uint32_t firstInstance;
+	if (!DecodeArgs(decoder, SkipArg(), captured, vertexCount, instanceCount, firstVertex, firstInstance))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer || !commandBuffer->bRendering || !commandBuffer->bPipelineBound)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdDraw(commandBuffer->commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+	return true;
+}
+
+static bool ReplayDrawIndexed(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	uint32_t indexCount;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t vertexOffset;
+	uint32_t firstInstance;
+	if (!DecodeArgs(decoder, SkipArg(), captured, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance))
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	if (!commandBuffer || !commandBuffer->bRendering || !commandBuffer->bPipelineBound)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdDrawIndexed(commandBuffer->commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+	return true;
+}
+
+static bool ReplayCopyBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkBuffer source;
+	VkBuffer destination;
+	VkBufferCopy* regions = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, source, destination, SkipArg(), Array(regions, &count)) || !regions)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	source = FindBuffer(replay, source);
+	destination = FindBuffer(replay, destination);
+	if (!commandBuffer || !source || !destination)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdCopyBuffer(commandBuffer->commandBuffer, source, destination, count, regions);
+	return true;
+}
+
+static bool ReplayCopyBufferToImage(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkBuffer source;
+	VkImage destination;
+	VkImageLayout layout;
+	VkBufferImageCopy* regions = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, source, destination, layout, SkipArg(), Array(regions, &count)) || !regions)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	source = FindBuffer(replay, source);
+	destination = FindImage(replay, destination);
+	if (!commandBuffer || !source || !destination)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdCopyBufferToImage(commandBuffer->commandBuffer, source, destination, MapLayout(layout), count, regions);
+	return true;
+}
+
+static bool ReplayUpdateBuffer(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkBuffer destination;
+	VkDeviceSize offset;
+	VkDeviceSize size;
+	const void* data = nullptr;
+	uint32_t dataSize = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, destination, offset, size) || !decoder.DecodeBlob(data, dataSize) || !data || dataSize != size)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	destination = FindBuffer(replay, destination);
+	if (!commandBuffer || !destination)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdUpdateBuffer(commandBuffer->commandBuffer, destination, offset, size, data);
+	return true;
+}
+
+static bool ReplayClearColorImage(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkCommandBuffer captured;
+	VkImage image;
+	VkImageLayout layout;
+	VkClearColorValue* color = nullptr;
+	VkImageSubresourceRange* ranges = nullptr;
+	uint32_t count = 0;
+	if (!DecodeArgs(decoder, SkipArg(), captured, image, layout, Array(color), SkipArg(), Array(ranges, &count)) || !color || !ranges)
+	{
+		return false;
+	}
+
+	ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, captured);
+	image = FindImage(replay, image);
+	if (!commandBuffer || !image)
+	{
+		return false;
+	}
+
+	replay.vk.vkCmdClearColorImage(commandBuffer->commandBuffer, image, MapLayout(layout), color, count, ranges);
+	return true;
+}
+
+static std::vector<VkSemaphoreSubmitInfo> MapSemaphoreInfos(ReplayState& replay, const VkSemaphoreSubmitInfo* infos, uint32_t count)
+{
+	std::vector<VkSemaphoreSubmitInfo> mapped;
+	for (uint32_t i = 0; infos && i < count; i++)
+	{
+		VkSemaphoreSubmitInfo info = infos[i];
+		info.pNext = nullptr;
+		info.semaphore = FindHandle(replay.semaphores, HandleKey(info.semaphore));
+		if (info.semaphore)
+		{
+			mapped.push_back(info);
+		}
+	}
+	return mapped;
+}
+
+static bool ReplayQueueSubmit2(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	VkQueue capturedQueue;
+	VkSubmitInfo2* submits = nullptr;
+	uint32_t submitCount = 0;
+	VkFence capturedFence;
+	if (!DecodeArgs(decoder, SkipArg(), capturedQueue, SkipArg(), Array(submits, &submitCount), capturedFence))
+	{
+		return false;
+	}
+
+	FlushPendingSetup(replay);
+
+	// Only timeline semaphores are kept, binary ones waited for acquires or signaled presents that aren't replayed
+	std::vector<std::vector<VkSemaphoreSubmitInfo>> waits(submitCount);
+	std::vector<std::vector<VkSemaphoreSubmitInfo>> signals(submitCount);
+	std::vector<std::vector<VkCommandBufferSubmitInfo>> commandBuffers(submitCount);
+	for (uint32_t i = 0; submits && i < submitCount; i++)
+	{
+		VkSubmitInfo2& submit = submits[i];
+		waits[i] = MapSemaphoreInfos(replay, submit.pWaitSemaphoreInfos, submit.waitSemaphoreInfoCount);
+		signals[i] = MapSemaphoreInfos(replay, submit.pSignalSemaphoreInfos, submit.signalSemaphoreInfoCount);
+
+		for (uint32_t j = 0; submit.pCommandBufferInfos && j < submit.commandBufferInfoCount; j++)
+		{
+			VkCommandBufferSubmitInfo info = submit.pCommandBufferInfos[j];
+			ReplayCommandBuffer* commandBuffer = FindCommandBuffer(replay, info.commandBuffer);
+			if (commandBuffer)
+			{
+				info.pNext = nullptr;
+				info.commandBuffer = commandBuffer->commandBuffer;
+				commandBuffers[i].push_back(info);
+			}
+		}
+
+		submit.waitSemaphoreInfoCount = (uint32_t)waits[i].size();
+		submit.pWaitSemaphoreInfos = waits[i].data();
+		submit.signalSemaphoreInfoCount = (uint32_t)signals[i].size();
+		submit.pSignalSemaphoreInfos = signals[i].data();
+		submit.commandBufferInfoCount = (uint32_t)commandBuffers[i].size();
+		submit.pCommandBufferInfos = commandBuffers[i].data();
+	}
+
+	VkFence fence = FindHandle(replay.fences, HandleKey(capturedFence));
+	replay.vk.vkQueueSubmit2(replay.queue, submitCount, submits, fence);
+	return true;
+}
+
+static bool ReplayQueueWaitIdle(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	replay.vk.vkQueueWaitIdle(replay.queue);
+	return true;
+}
+
+static bool ReplayDeviceWaitIdle(ReplayState& replay, KonideCaptureDecoder& decoder)
+{
+	replay.vk.vkDeviceWaitIdle(replay.device);
+	return true;
+}
+
+static std::unordered_map<std::string, ReplayHandler> GetReplayHandlers()
+{
+	return {
+		{ "vkGetDeviceQueue", ReplayGetDeviceQueue },
+		{ "vkCreateBuffer", ReplayCreateBuffer },
+		{ "vkDestroyBuffer", ReplayDestroyBuffer },
+		{ "vkAllocateMemory", ReplayMemoryCall },
+		{ "vkFreeMemory", ReplayFreeMemory },
+		{ "vkBindBufferMemory", ReplayBindBufferMemory },
+		{ "vkMapMemory", ReplayMemoryCall },
+		{ "vkUnmapMemory", ReplayMemoryCall },
+		{ "vkFlushMappedMemoryRanges", ReplayMemoryCall },
+		{ "vkCreateImage", ReplayCreateImage },
+		{ "vkDestroyImage", ReplayDestroyImage },
+		{ "vkCreateImageView", ReplayCreateImageView },
+		{ "vkDestroyImageView", ReplayDestroyImageView },
+		{ "vkCreateSwapchainKHR", ReplayCreateSwapchain },
+		{ "vkGetSwapchainImagesKHR", ReplayGetSwapchainImages },
+		{ "vkDestroySwapchainKHR", ReplayDestroySwapchain },
+		{ "vkCreateSemaphore", ReplayCreateSemaphore },
+		{ "vkDestroySemaphore", ReplayDestroySemaphore },
+		{ "vkWaitSemaphores", ReplayWaitSemaphores },
+		{ "vkGetSemaphoreCounterValue", ReplayGetSemaphoreCounterValue },
+		{ "vkCreateFence", ReplayCreateFence },
+		{ "vkDestroyFence", ReplayDestroyFence },
+		{ "vkWaitForFences", ReplayWaitForFences },
+		{ "vkResetFences", ReplayResetFences },
+		{ "vkCreateCommandPool", ReplayCreateCommandPool },
+		{ "vkDestroyCommandPool", ReplayDestroyCommandPool },
+		{ "vkResetCommandPool", ReplayResetCommandPool },
+		{ "vkAllocateCommandBuffers", ReplayAllocateCommandBuffers },
+		{ "vkFreeCommandBuffers", ReplayFreeCommandBuffers },
+		{ "vkBeginCommandBuffer", ReplayBeginCommandBuffer },
+		{ "vkEndCommandBuffer", ReplayEndCommandBuffer },
+		{ "vkResetCommandBuffer", ReplayResetCommandBuffer },
+		{ "vkCmdPipelineBarrier2", ReplayPipelineBarrier2 },
+		{ "vkCmdBeginRendering", ReplayBeginRendering },
+		{ "vkCmdEndRendering", ReplayEndRendering },
+		{ "vkCmdExecuteCommands", ReplayExecuteCommands },
+		{ "vkCmdBindPipeline", ReplayBindPipeline },
+		{ "vkCmdBindVertexBuffers", ReplayBindVertexBuffers },
+		{ "vkCmdBindIndexBuffer", ReplayBindIndexBuffer },
+		{ "vkCmdPushConstants", ReplayPushConstants },
+		{ "vkCmdSetViewport", ReplaySetViewport },
+		{ "vkCmdSetScissor", ReplaySetScissor },
+		{ "vkCmdSetLineWidth", ReplaySetLineWidth },
+		{ "vkCmdSetDepthBias", ReplaySetDepthBias },
+		{ "vkCmdSetBlendConstants", ReplaySetBlendConstants },
+		{ "vkCmdSetStencilReference", ReplaySetStencilReference },
+		{ "vkCmdDraw", ReplayDraw },
+		{ "vkCmdDrawIndexed", ReplayDrawIndexed },
+		{ "vkCmdCopyBuffer", ReplayCopyBuffer },
+		{ "vkCmdCopyBufferToImage", ReplayCopyBufferToImage },
+		{ "vkCmdUpdateBuffer", ReplayUpdateBuffer },
+		{ "vkCmdClearColorImage", ReplayClearColorImage },
+		{ "vkQueueSubmit2", ReplayQueueSubmit2 },
+		{ "vkQueueWaitIdle", ReplayQueueWaitIdle },
+		{ "vkDeviceWaitIdle", ReplayDeviceWaitIdle },
+	};
+}
+
+// Destroys whatever the trace left alive, so the next loop starts from a clean device
+static void ResetReplay(ReplayState& replay)
+{
+	replay.vk.vkDeviceWaitIdle(replay.device);
+
+	for (auto& pool : replay.commandPools)
+	{
+		replay.vk.vkDestroyCommandPool(replay.device, pool.second, nullptr);
+	}
+	for (auto& view : replay.imageViews)
+	{
+		replay.vk.vkDestroyImageView(replay.device, view.second.view, nullptr);
+	}
+	for (auto& image : replay.images)
+	{
+		replay.vk.vkDestroyImage(replay.device, image.second.image, nullptr);
+		replay.vk.vkFreeMemory(replay.device, image.second.memory, nullptr);
+	}
+	for (auto& buffer : replay.buffers)
+	{
+		replay.vk.vkDestroyBuffer(replay.device, buffer.second.buffer, nullptr);
+		replay.vk.vkFreeMemory(replay.device, buffer.second.memory, nullptr);
+	}
+	for (auto& semaphore : replay.semaphores)
+	{
+		if (semaphore.second) replay.vk.vkDestroySemaphore(replay.device, semaphore.second, nullptr);
+	}
+	for (auto& fence : replay.fences)
+	{
+		replay.vk.vkDestroyFence(replay.device, fence.second, nullptr);
+	}
+	for (const ReplaySetup& setup : replay.setups)
+	{
+		DestroySetup(replay, setup);
+	}
+
+	replay.queues.clear();
+	replay.buffers.clear();
+	replay.images.clear();
+	replay.imageViews.clear();
+	replay.swapchains.clear();
+	replay.semaphores.clear();
+	replay.fences.clear();
+	replay.commandPools.clear();
+	replay.commandBuffers.clear();
+	replay.memoryBuffers.clear();
+	replay.pendingClears.clear();
+	replay.pendingWrites.clear();
+	replay.setups.clear();
+
+	if (replay.setupPool)
+	{
+		replay.vk.vkResetCommandPool(replay.device, replay.setupPool, 0);
+	}
+}
+
+static void DestroyStandIns(ReplayState& replay)
+{
+	for (auto& pipeline : replay.pipelines)
+	{
+		if (pipeline.second) replay.vk.vkDestroyPipeline(replay.device, pipeline.second, nullptr);
+	}
+	replay.pipelines.clear();
+
+	if (replay.vertexShader) replay.vk.vkDestroyShaderModule(replay.device, replay.vertexShader, nullptr);
+	if (replay.fragmentShader) replay.vk.vkDestroyShaderModule(replay.device, replay.fragmentShader, nullptr);
+	if (replay.pipelineLayout) replay.vk.vkDestroyPipelineLayout(replay.device, replay.pipelineLayout, nullptr);
+	if (replay.setupPool) replay.vk.vkDestroyCommandPool(replay.device, replay.setupPool, nullptr);
+}
+
+struct ReplayPassStats
+{
+	uint64_t calls = 0;
+	uint64_t frames = 0;
+	uint64_t memoryBytes = 0;
+	double seconds = 0.0;
+	// Between the first and the last record of the trace
+	double capturedSeconds = 0.0;
+};
+
+// Runs the trace once, as fast as possible or sleeping until each frame's captured time
+static ReplayPassStats ReplayTrace(ReplayState& replay, const KonideTraceReader& trace, bool bPaced)
+{
+	ReplayPassStats pass;
+	const std::vector<KonideTraceRecord>& records = trace.GetRecords();
+	if (records.empty())
+	{
+		return pass;
+	}
+
+	uint64_t firstTimestamp = records.front().header.timestamp;
+	pass.capturedSeconds = (double)(records.back().header.timestamp - firstTimestamp) * 1e-9;
+
+	Clock::time_point start = Clock::now();
+	for (const KonideTraceRecord& record : records)
+	{
+		if (record.header.type == KONIDE_TRACE_RECORD_MEMORY)
+		{
+			ReplayMemory(replay, record);
+			pass.memoryBytes += record.header.size - sizeof(KonideTraceMemoryHeader);
+			continue;
+		}
+
+		if (record.header.type == KONIDE_TRACE_RECORD_FRAME)
+		{
+			pass.frames++;
+			if (bPaced)
+			{
+				std::this_thread::sleep_until(start + std::chrono::nanoseconds(record.header.timestamp - firstTimestamp));
+			}
+			continue;
+		}
+
+		ReplayEntrypointStats& stats = replay.entrypointStats[record.header.entrypoint];
+		stats.calls++;
+		stats.capturedSeconds += (double)record.header.duration * 1e-9;
+
+		ReplayHandler handler = replay.handlers[record.header.entrypoint];
+		if (!handler)
+		{
+			stats.skipped++;
+			replay.skippedCommands += replay.commandEntrypoints[record.header.entrypoint] ? 1 : 0;
+			continue;
+		}
+
+		KonideCaptureDecoder decoder(record.payload, record.header.size);
+		Clock::time_point callStart = Clock::now();
+		bool bReplayed = handler(replay, decoder);
+		stats.replaySeconds += SecondsSince(callStart);
+
+		if (decoder.Failed())
+		{
+			replay.malformedCalls++;
+		}
+		if (bReplayed)
+		{
+			pass.calls++;
+		}
+		else
+		{
+			stats.skipped++;
+			replay.skippedCommands += replay.commandEntrypoints[record.header.entrypoint] ? 1 : 0;
+		}
+	}
+
+	replay.vk.vkDeviceWaitIdle(replay.device);
+	pass.seconds = SecondsSince(start);
+	return pass;
+}
+
+// The replay did the captured GPU work only if every memory write landed, no pipeline was stood in for and every
+// recorded command was replayed
+static bool IsFaithful(const ReplayState& replay)
+{
+	return replay.missingMemoryBytes == 0 && replay.standInBinds == 0 && replay.skippedCommands == 0;
+}
+
+static void LogEntrypoints(const ReplayState& replay, const KonideTraceReader& trace, int count)
+{
+	std::vector<uint32_t> order;
+	for (uint32_t i = 0; i < (uint32_t)replay.entrypointStats.size(); i++)
+	{
+		if (replay.entrypointStats[i].calls)
+		{
+			order.push_back(i);
+		}
+	}
+	// Without the captured GPU work the replay times say nothing about the capture, only call counts are listed
+	bool bFaithful = IsFaithful(replay);
+	std::sort(order.begin(), order.end(), [&replay, bFaithful](uint32_t a, uint32_t b)
+	{
+		const ReplayEntrypointStats& statsA = replay.entrypointStats[a];
+		const ReplayEntrypointStats& statsB = replay.entrypointStats[b];
+		return bFaithful ? statsA.replaySeconds > statsB.replaySeconds : statsA.calls > statsB.calls;
+	});
+
+	printf(bFaithful ? "entrypoints by replay time (captured time in the driver, replay time including decoding):\n"
+		: "entrypoints by calls:\n");
+	for (size_t i = 0; i < order.size() && (int)i < count; i++)
+	{
+		const ReplayEntrypointStats& stats = replay.entrypointStats[order[i]];
+		if (bFaithful)
+		{
+			printf("  %-40s %8llu calls %10.3f ms captured %10.3f ms replayed\n", trace.GetEntrypoints()[order[i]].c_str(),
+				(unsigned long long)stats.calls, stats.capturedSeconds * 1000.0, stats.replaySeconds * 1000.0);
+		}
+		else
+		{
+			printf("  %-40s %8llu calls\n", trace.GetEntrypoints()[order[i]].c_str(), (unsigned long long)stats.calls);
+		}
+	}
+}
+
+static void LogSkipped(const ReplayState& replay, const KonideTraceReader& trace)
+{
+	bool bAny = false;
+	for (uint32_t i = 0; i < (uint32_t)replay.entrypointStats.size(); i++)
+	{
+		const ReplayEntrypointStats& stats = replay.entrypointStats[i];
+		if (!stats.skipped)
+		{
+			continue;
+		}
+
+		if (!bAny)
+		{
+			printf("not replayed:\n");
+			bAny = true;
+		}
+		printf("  %-40s %8llu of %llu calls\n", trace.GetEntrypoints()[i].c_str(), (unsigned long long)stats.skipped, (unsigned long long)stats.calls);
+	}
+
+	if (replay.malformedCalls)
+	{
+		printf("%llu calls couldn't be decoded\n", (unsigned long long)replay.malformedCalls);
+	}
+}
+
+static void LogFidelity(const ReplayState& replay)
+{
+	if (IsFaithful(replay))
+	{
+		return;
+	}
+
+	printf("no timings reported, the replay didn't do the same GPU work as the capture:\n");
+	if (replay.missingMemoryBytes)
+	{
+		printf("  %llu bytes of captured memory writes landed in no replayed buffer\n", (unsigned long long)replay.missingMemoryBytes);
+	}
+	if (replay.standInBinds)
+	{
+		printf("  %llu pipeline binds used stand-in pipelines\n", (unsigned long long)replay.standInBinds);
+	}
+	if (replay.skippedCommands)
+	{
+		printf("  %llu recorded commands were skipped\n", (unsigned long long)replay.skippedCommands);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2 || argv[1][0] == '-')
+	{
+		printf("usage: konide_replay <trace> [--paced] [--loop <count>] [--validation] [--shaders <dir>] [--calls [count]]\n");
+		return 1;
+	}
+
+	KonideTraceReader trace;
+	if (!trace.Load(argv[1]))
+	{
+		printf("can't load %s, it's missing or not a trace this build can replay\n", argv[1]);
+		return 2;
+	}
+
+	bool bPaced = FindArgument(argc, argv, "--paced") != 0;
+
+	int loopArg = FindArgument(argc, argv, "--loop");
+	int loopCount = loopArg && loopArg + 1 < argc ? atoi(argv[loopArg + 1]) : 0;
+	if (loopCount <= 0)
+	{
+		loopCount = 1;
+	}
+
+	int shadersArg = FindArgument(argc, argv, "--shaders");
+	std::string shaderDir = shadersArg && shadersArg + 1 < argc ? argv[shadersArg + 1] : KONIDE_REPLAY_SHADER_DIR;
+
+	int callsArg = FindArgument(argc, argv, "--calls");
+	int callCount = callsArg && callsArg + 1 < argc ? atoi(argv[callsArg + 1]) : 0;
+	if (callCount <= 0)
+	{
+		callCount = 10;
+	}
+
+	// No surface, the renderer makes a device with a graphics queue and nothing to present to
+	uint32_t features = FindArgument(argc, argv, "--validation") ? KONIDE_RENDER_FEATURE_VALIDATION_LAYERS : KONIDE_RENDER_FEATURE_NONE;
+	KonideRenderer Renderer(features);
+	Renderer.Initialize();
+	Renderer.CreateDevice();
+
+	ReplayState replay(Renderer);
+	Renderer.GetInstanceTable().vkGetPhysicalDeviceMemoryProperties(Renderer.GetPhysicalDevice(), &replay.memoryProperties);
+	CreateStandIns(replay, shaderDir);
+	if (!replay.vertexShader || !replay.fragmentShader)
+	{
+		printf("no stand-in shaders in '%s', draws are skipped\n", shaderDir.c_str());
+	}
+
+	std::unordered_map<std::string, ReplayHandler> handlers = GetReplayHandlers();
+	for (const std::string& name : trace.GetEntrypoints())
+	{
+		auto found = handlers.find(name);
+		replay.handlers.push_back(found != handlers.end() ? found->second : nullptr);
+		replay.commandEntrypoints.push_back(name.compare(0, 5, "vkCmd") == 0);
+	}
+	replay.entrypointStats.resize(trace.GetEntrypoints().size());
+
+	for (int loop = 0; loop < loopCount; loop++)
+	{
+		ReplayPassStats pass = ReplayTrace(replay, trace, bPaced);
+		ResetReplay(replay);
+
+		uint64_t frames = std::max<uint64_t>(pass.frames, 1);
+		printf("pass %d: %llu calls replayed, %llu frames", loop + 1, (unsigned long long)pass.calls, (unsigned long long)pass.frames);
+		if (IsFaithful(replay))
+		{
+			printf(" in %.3f ms, %.3f ms/frame (captured %.3f ms/frame)", pass.seconds * 1000.0, pass.seconds * 1000.0 / frames,
+				pass.capturedSeconds * 1000.0 / frames);
+		}
+		printf(", %llu bytes of memory written\n", (unsigned long long)pass.memoryBytes);
+	}
+
+	if (callsArg)
+	{
+		LogEntrypoints(replay, trace, callCount);
+	}
+	LogSkipped(replay, trace);
+	LogFidelity(replay);
+
+	DestroyStandIns(replay);
+	return 0;
+}